@@ -0,0 +1,166 @@
+#include "Benchmark.h"
+#include "IFormatLoader.h"
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+
+using namespace Voltray::Engine;
+using namespace Voltray::Benchmarks;
+
+namespace Reference
+{
+    /**
+     * @brief The conversion before pre-sizing: one mesh after another, growing both buffers per element
+     */
+    std::vector<MeshData> ConvertScene(const aiScene *scene)
+    {
+        std::vector<MeshData> result;
+        for (unsigned int m = 0; m < scene->mNumMeshes; ++m)
+        {
+            const aiMesh *mesh = scene->mMeshes[m];
+            if (mesh->mPrimitiveTypes != aiPrimitiveType_TRIANGLE)
+                continue; // Dropped by the loader as well
+
+            MeshData data;
+            for (unsigned int i = 0; i < mesh->mNumVertices; i++)
+            {
+                data.vertices.push_back(mesh->mVertices[i].x);
+                data.vertices.push_back(mesh->mVertices[i].y);
+                data.vertices.push_back(mesh->mVertices[i].z);
+                if (mesh->HasNormals())
+                {
+                    data.vertices.push_back(mesh->mNormals[i].x);
+                    data.vertices.push_back(mesh->mNormals[i].y);
+                    data.vertices.push_back(mesh->mNormals[i].z);
+                }
+                else
+                {
+                    data.vertices.push_back(0.0f);
+                    data.vertices.push_back(1.0f);
+                    data.vertices.push_back(0.0f);
+                }
+                if (mesh->mTextureCoords[0])
+                {
+                    data.vertices.push_back(mesh->mTextureCoords[0][i].x);
+                    data.vertices.push_back(mesh->mTextureCoords[0][i].y);
+                }
+                else
+                {
+                    data.vertices.push_back(0.0f);
+                    data.vertices.push_back(0.0f);
+                }
+            }
+            for (unsigned int i = 0; i < mesh->mNumFaces; i++)
+            {
+                aiFace face = mesh->mFaces[i];
+                for (unsigned int j = 0; j < face.mNumIndices; j++)
+                {
+                    data.indices.push_back(face.mIndices[j]);
+                }
+            }
+            if (!data.vertices.empty())
+                result.push_back(std::move(data));
+        }
+        return result;
+    }
+}
+
+namespace
+{
+    bool Matches(const std::vector<MeshData> &a, const std::vector<MeshData> &b)
+    {
+        if (a.size() != b.size())
+            return false;
+        for (std::size_t i = 0; i < a.size(); ++i)
+        {
+            if (a[i].vertices != b[i].vertices || a[i].indices != b[i].indices)
+                return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Times parsing and conversion of one file
+     * @return False if the conversions disagree
+     */
+    bool Run(const std::filesystem::path &path)
+    {
+        std::printf("%s, %.1f MB\n", path.string().c_str(), std::filesystem::file_size(path) / (1024.0 * 1024.0));
+
+        // Parsing dominates and does not vary much, a single run is enough
+        Assimp::Importer importer;
+        const aiScene *scene = nullptr;
+        PrintTime("Assimp import", MeasureMilliseconds(1, [&]()
+                                                       { scene = AssimpLoader::ImportScene(importer, path.string()); }));
+
+        AssimpLoader loader;
+        std::vector<MeshData> converted, reference;
+        PrintTime("Conversion, per-element push_back", MeasureMilliseconds(5, [&]()
+                                                                           { reference = Reference::ConvertScene(scene); }));
+        PrintTime("Conversion, pre-sized and parallel", MeasureMilliseconds(5, [&]()
+                                                                            { converted = loader.ConvertScene(scene); }));
+
+        std::size_t vertices = 0, triangles = 0;
+        for (const MeshData &mesh : converted)
+        {
+            vertices += mesh.layout.GetVertexCount(mesh.vertices);
+            triangles += mesh.indices.size() / 3;
+        }
+        std::printf("  %u meshes, %zu vertices, %zu triangles\n", scene->mNumMeshes, vertices, triangles);
+
+        if (!Matches(converted, reference))
+        {
+            std::printf("  Conversions differ\n");
+            return false;
+        }
+        return true;
+    }
+}
+
+/**
+ * Assimp import time against the time to convert its scene to MeshData, with the conversion
+ * before pre-sizing as reference. Takes any files Assimp reads, such as large FBX or glTF
+ * samples; without files it imports a generated OBJ grid of quads (500 x 500 by default).
+ *
+ * Usage: VoltrayAssimpBenchmark [files... | grid size]
+ */
+int main(int argc, char **argv)
+{
+    std::vector<std::filesystem::path> paths;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::filesystem::exists(argv[i]))
+            paths.push_back(argv[i]);
+    }
+
+    std::filesystem::path generated;
+    if (paths.empty())
+    {
+        generated = std::filesystem::temp_directory_path() / "voltray_assimp_benchmark.obj";
+        WriteObjGrid(generated, GetCountArgument(argc, argv, 1, 500));
+        paths.push_back(generated);
+    }
+
+    int result = 0;
+    for (const std::filesystem::path &path : paths)
+    {
+        try
+        {
+            if (!Run(path))
+                result = 1;
+        }
+        catch (const std::exception &e)
+        {
+            std::printf("  %s\n", e.what());
+            result = 1;
+        }
+    }
+
+    if (!generated.empty())
+        std::filesystem::remove(generated);
+    return result;
+}
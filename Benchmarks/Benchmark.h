@@ -0,0 +1,83 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace Voltray::Benchmarks
+{
+    /**
+     * @brief Times a function over several runs
+     * @param runs Number of timed runs
+     * @param function Work to time; results it produces should feed a checksum so they are not optimized away
+     * @return Median time of one run in milliseconds
+     */
+    template <typename Function>
+    double MeasureMilliseconds(int runs, Function &&function)
+    {
+        std::vector<double> times;
+        for (int run = 0; run < runs; ++run)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            function();
+            times.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        }
+        std::nth_element(times.begin(), times.begin() + times.size() / 2, times.end());
+        return times[times.size() / 2];
+    }
+
+    /**
+     * @brief Prints one timing line
+     */
+    inline void PrintTime(const char *name, double milliseconds)
+    {
+        std::printf("  %-40s %12.4f ms\n", name, milliseconds);
+    }
+
+    /**
+     * @brief Reads an optional positive count from the command line
+     * @return The argument at index, or fallback if it is missing or not a positive number
+     */
+    inline std::size_t GetCountArgument(int argc, char **argv, int index, std::size_t fallback)
+    {
+        if (index >= argc)
+            return fallback;
+        const long long value = std::atoll(argv[index]);
+        return value > 0 ? static_cast<std::size_t>(value) : fallback;
+    }
+
+    /**
+     * @brief Writes an OBJ grid of textured quads with per-vertex normals, as scanning tools export them
+     * @param path File to create
+     * @param size Number of quads along each side
+     */
+    inline void WriteObjGrid(const std::filesystem::path &path, std::size_t size)
+    {
+        std::ofstream file(path, std::ios::binary);
+        char line[160];
+        for (std::size_t y = 0; y <= size; ++y)
+        {
+            for (std::size_t x = 0; x <= size; ++x)
+            {
+                std::snprintf(line, sizeof(line), "v %.6f %.6f %.6f\nvt %.6f %.6f\nvn 0.000000 0.000000 1.000000\n",
+                              x * 0.01, y * 0.01, std::sin(x * 0.1) * 0.5, x / double(size), y / double(size));
+                file << line;
+            }
+        }
+        for (std::size_t y = 0; y < size; ++y)
+        {
+            for (std::size_t x = 0; x < size; ++x)
+            {
+                const std::size_t a = y * (size + 1) + x + 1;
+                const std::size_t c = a + size + 1;
+                std::snprintf(line, sizeof(line), "f %zu/%zu/%zu %zu/%zu/%zu %zu/%zu/%zu %zu/%zu/%zu\n", a, a, a, a + 1, a + 1, a + 1, c + 1, c + 1, c + 1, c, c, c);
+                file << line;
+            }
+        }
+    }
+}
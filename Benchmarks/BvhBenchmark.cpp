@@ -0,0 +1,97 @@
+#include "Benchmark.h"
+#include "BVH.h"
+#include "Ray.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace Voltray::Math;
+using namespace Voltray::Benchmarks;
+
+/**
+ * Picking on a large mesh: brute-force Ray::IntersectMesh against the BVH path, on a bumpy
+ * sphere with the standard 8-float vertices.
+ *
+ * Usage: VoltrayBvhBenchmark [triangles] [rays]
+ */
+int main(int argc, char **argv)
+{
+    const std::size_t targetTriangles = GetCountArgument(argc, argv, 1, 1000000);
+    const std::size_t rayCount = GetCountArgument(argc, argv, 2, 200);
+    constexpr unsigned int STRIDE = 8;
+
+    // Latitude/longitude grid with twice as many columns as rows, two triangles per cell
+    const unsigned int rows = std::max(1u, static_cast<unsigned int>(std::sqrt(targetTriangles / 4.0)));
+    const unsigned int columns = rows * 2;
+    std::mt19937 random(1);
+    std::uniform_real_distribution<float> uniform(-1.0f, 1.0f);
+    std::vector<float> vertices;
+    std::vector<unsigned int> indices;
+    vertices.reserve((rows + 1) * (columns + 1) * STRIDE);
+    indices.reserve(rows * columns * 6);
+    for (unsigned int y = 0; y <= rows; ++y)
+    {
+        for (unsigned int x = 0; x <= columns; ++x)
+        {
+            const float theta = 3.14159265f * y / rows;
+            const float phi = 6.28318531f * x / columns;
+            const float radius = 1.0f + 0.01f * uniform(random);
+            vertices.insert(vertices.end(), {radius * std::sin(theta) * std::cos(phi), radius * std::cos(theta), radius * std::sin(theta) * std::sin(phi),
+                                             0.0f, 0.0f, 0.0f, 0.0f, 0.0f});
+        }
+    }
+    for (unsigned int y = 0; y < rows; ++y)
+    {
+        for (unsigned int x = 0; x < columns; ++x)
+        {
+            const unsigned int a = y * (columns + 1) + x;
+            const unsigned int c = a + columns + 1;
+            indices.insert(indices.end(), {a, c, a + 1, a + 1, c, c + 1});
+        }
+    }
+    std::printf("BVH picking, %zu triangles, %zu rays\n", indices.size() / 3, rayCount);
+
+    BVH bvh;
+    PrintTime("BVH build", MeasureMilliseconds(3, [&]()
+                                               { bvh.Build(vertices, indices, STRIDE); }));
+    std::printf("  %-40s %12.1f MB\n", "BVH memory", bvh.GetMemoryUsage() / (1024.0 * 1024.0));
+
+    // Rays from outside the sphere towards points inside it, so most of them hit
+    std::vector<Ray> rays;
+    for (std::size_t i = 0; i < rayCount; ++i)
+    {
+        const Vec3 origin(uniform(random) * 3.0f, uniform(random) * 3.0f, 5.0f);
+        const Vec3 target(uniform(random) * 0.8f, uniform(random) * 0.8f, uniform(random) * 0.8f);
+        rays.emplace_back(origin, target - origin);
+    }
+
+    std::vector<float> bruteForce(rayCount, -1.0f), accelerated(rayCount, -1.0f);
+    const double bruteForceTime = MeasureMilliseconds(1, [&]()
+                                                      {
+        for (std::size_t i = 0; i < rayCount; ++i)
+        {
+            if (!rays[i].IntersectMesh(vertices, indices, STRIDE, bruteForce[i]))
+                bruteForce[i] = -1.0f;
+        } });
+    const double acceleratedTime = MeasureMilliseconds(5, [&]()
+                                                       {
+        for (std::size_t i = 0; i < rayCount; ++i)
+        {
+            if (!rays[i].IntersectMesh(vertices, indices, STRIDE, accelerated[i], &bvh))
+                accelerated[i] = -1.0f;
+        } });
+    PrintTime("Brute force, per pick", bruteForceTime / rayCount);
+    PrintTime("BVH, per pick", acceleratedTime / rayCount);
+
+    // Both paths report the closest hit, so they have to agree
+    std::size_t mismatches = 0;
+    for (std::size_t i = 0; i < rayCount; ++i)
+    {
+        if (std::fabs(bruteForce[i] - accelerated[i]) > 1e-4f)
+            ++mismatches;
+    }
+    std::printf("  %-40s %12zu\n", "Mismatched hits", mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,155 @@
+#include "Benchmark.h"
+#include "Mat4.h"
+#include "SIMD.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace Voltray::Math;
+using namespace Voltray::Benchmarks;
+
+namespace
+{
+    /**
+     * Plain loops the vectorised Mat4 kernels replaced, kept as the baseline
+     */
+    namespace Scalar
+    {
+        Mat4 Multiply(const Mat4 &a, const Mat4 &b)
+        {
+            Mat4 result;
+            for (int row = 0; row < 4; ++row)
+            {
+                for (int col = 0; col < 4; ++col)
+                {
+                    result.data[col + row * 4] = a.data[row * 4] * b.data[col] + a.data[1 + row * 4] * b.data[col + 4] +
+                                                 a.data[2 + row * 4] * b.data[col + 8] + a.data[3 + row * 4] * b.data[col + 12];
+                }
+            }
+            return result;
+        }
+
+        Vec3 MultiplyVec3(const Mat4 &matrix, const Vec3 &v)
+        {
+            const float *m = matrix.data;
+            return Vec3(v.x * m[0] + v.y * m[4] + v.z * m[8] + m[12],
+                        v.x * m[1] + v.y * m[5] + v.z * m[9] + m[13],
+                        v.x * m[2] + v.y * m[6] + v.z * m[10] + m[14]);
+        }
+
+        /**
+         * Cofactor expansion of all 16 elements
+         */
+        Mat4 Inverse(const Mat4 &matrix)
+        {
+            const float *m = matrix.data;
+            Mat4 inverse;
+            float *out = inverse.data;
+            out[0] = m[5] * m[10] * m[15] - m[5] * m[11] * m[14] - m[9] * m[6] * m[15] + m[9] * m[7] * m[14] + m[13] * m[6] * m[11] - m[13] * m[7] * m[10];
+            out[4] = -m[4] * m[10] * m[15] + m[4] * m[11] * m[14] + m[8] * m[6] * m[15] - m[8] * m[7] * m[14] - m[12] * m[6] * m[11] + m[12] * m[7] * m[10];
+            out[8] = m[4] * m[9] * m[15] - m[4] * m[11] * m[13] - m[8] * m[5] * m[15] + m[8] * m[7] * m[13] + m[12] * m[5] * m[11] - m[12] * m[7] * m[9];
+            out[12] = -m[4] * m[9] * m[14] + m[4] * m[10] * m[13] + m[8] * m[5] * m[14] - m[8] * m[6] * m[13] - m[12] * m[5] * m[10] + m[12] * m[6] * m[9];
+            out[1] = -m[1] * m[10] * m[15] + m[1] * m[11] * m[14] + m[9] * m[2] * m[15] - m[9] * m[3] * m[14] - m[13] * m[2] * m[11] + m[13] * m[3] * m[10];
+            out[5] = m[0] * m[10] * m[15] - m[0] * m[11] * m[14] - m[8] * m[2] * m[15] + m[8] * m[3] * m[14] + m[12] * m[2] * m[11] - m[12] * m[3] * m[10];
+            out[9] = -m[0] * m[9] * m[15] + m[0] * m[11] * m[13] + m[8] * m[1] * m[15] - m[8] * m[3] * m[13] - m[12] * m[1] * m[11] + m[12] * m[3] * m[9];
+            out[13] = m[0] * m[9] * m[14] - m[0] * m[10] * m[13] - m[8] * m[1] * m[14] + m[8] * m[2] * m[13] + m[12] * m[1] * m[10] - m[12] * m[2] * m[9];
+            out[2] = m[1] * m[6] * m[15] - m[1] * m[7] * m[14] - m[5] * m[2] * m[15] + m[5] * m[3] * m[14] + m[13] * m[2] * m[7] - m[13] * m[3] * m[6];
+            out[6] = -m[0] * m[6] * m[15] + m[0] * m[7] * m[14] + m[4] * m[2] * m[15] - m[4] * m[3] * m[14] - m[12] * m[2] * m[7] + m[12] * m[3] * m[6];
+            out[10] = m[0] * m[5] * m[15] - m[0] * m[7] * m[13] - m[4] * m[1] * m[15] + m[4] * m[3] * m[13] + m[12] * m[1] * m[7] - m[12] * m[3] * m[5];
+            out[14] = -m[0] * m[5] * m[14] + m[0] * m[6] * m[13] + m[4] * m[1] * m[14] - m[4] * m[2] * m[13] - m[12] * m[1] * m[6] + m[12] * m[2] * m[5];
+            out[3] = -m[1] * m[6] * m[11] + m[1] * m[7] * m[10] + m[5] * m[2] * m[11] - m[5] * m[3] * m[10] - m[9] * m[2] * m[7] + m[9] * m[3] * m[6];
+            out[7] = m[0] * m[6] * m[11] - m[0] * m[7] * m[10] - m[4] * m[2] * m[11] + m[4] * m[3] * m[10] + m[8] * m[2] * m[7] - m[8] * m[3] * m[6];
+            out[11] = -m[0] * m[5] * m[11] + m[0] * m[7] * m[9] + m[4] * m[1] * m[11] - m[4] * m[3] * m[9] - m[8] * m[1] * m[7] + m[8] * m[3] * m[5];
+            out[15] = m[0] * m[5] * m[10] - m[0] * m[6] * m[9] - m[4] * m[1] * m[10] + m[4] * m[2] * m[9] + m[8] * m[1] * m[6] - m[8] * m[2] * m[5];
+
+            const float determinant = m[0] * out[0] + m[1] * out[4] + m[2] * out[8] + m[3] * out[12];
+            if (determinant == 0.0f)
+                return Mat4();
+            for (float &value : inverse.data)
+                value /= determinant;
+            return inverse;
+        }
+    }
+
+    float MaxDifference(const Mat4 &a, const Mat4 &b)
+    {
+        float difference = 0.0f;
+        for (int i = 0; i < 16; ++i)
+            difference = std::max(difference, std::fabs(a.data[i] - b.data[i]));
+        return difference;
+    }
+}
+
+/**
+ * Mat4 kernels against the scalar code they replaced. Operations cycle over a small working set
+ * so the timings measure arithmetic rather than memory bandwidth.
+ *
+ * Usage: VoltrayMat4Benchmark [operations]
+ */
+int main(int argc, char **argv)
+{
+    const std::size_t operations = GetCountArgument(argc, argv, 1, 1000000);
+    constexpr std::size_t WORKING_SET = 2048;
+    std::printf("Mat4 kernels (%s), %zu operations per kernel\n", SIMD::GetInstructionSet(), operations);
+
+    // Well-conditioned general matrices, and affine ones built from rotation, scale and translation
+    std::mt19937 random(1);
+    std::uniform_real_distribution<float> uniform(-2.0f, 2.0f);
+    std::vector<Mat4> general(WORKING_SET), other(WORKING_SET), affine(WORKING_SET);
+    std::vector<Vec3> points(WORKING_SET);
+    for (std::size_t i = 0; i < WORKING_SET; ++i)
+    {
+        for (int k = 0; k < 16; ++k)
+        {
+            general[i].data[k] = uniform(random) + (k % 5 == 0 ? 4.0f : 0.0f);
+            other[i].data[k] = uniform(random);
+        }
+        affine[i] = Mat4::Scale(Vec3(1.5f + uniform(random) * 0.2f, 1.0f, 0.8f)) * Mat4::RotateX(uniform(random)) *
+                    Mat4::RotateY(uniform(random)) * Mat4::Translate(Vec3(uniform(random), uniform(random), uniform(random)));
+        points[i] = Vec3(uniform(random), uniform(random), uniform(random));
+    }
+
+    std::vector<Mat4> results(WORKING_SET);
+    std::vector<Vec3> transformed(WORKING_SET);
+    auto run = [&](const char *name, auto &&kernel)
+    {
+        PrintTime(name, MeasureMilliseconds(5, [&]()
+                                            {
+            for (std::size_t i = 0; i < operations; ++i)
+                kernel(i % WORKING_SET); }));
+    };
+
+    run("Multiply, scalar", [&](std::size_t i)
+        { results[i] = Scalar::Multiply(general[i], other[i]); });
+    run("Multiply", [&](std::size_t i)
+        { results[i] = general[i] * other[i]; });
+    run("Inverse, scalar", [&](std::size_t i)
+        { results[i] = Scalar::Inverse(general[i]); });
+    run("Inverse", [&](std::size_t i)
+        { results[i] = general[i].Inverse(); });
+    run("InverseAffine", [&](std::size_t i)
+        { results[i] = affine[i].InverseAffine(); });
+    run("MultiplyVec3, scalar", [&](std::size_t i)
+        { transformed[i] = Scalar::MultiplyVec3(general[i], points[i]); });
+    run("MultiplyVec3", [&](std::size_t i)
+        { transformed[i] = general[i].MultiplyVec3(points[i]); });
+
+    // Products and points match up to float rounding; inverses are compared by how close M * inverse(M) is to identity
+    const Mat4 identity;
+    float multiplyError = 0.0f, inverseError = 0.0f, scalarInverseError = 0.0f, affineError = 0.0f, pointError = 0.0f;
+    for (std::size_t i = 0; i < WORKING_SET; ++i)
+    {
+        multiplyError = std::max(multiplyError, MaxDifference(general[i] * other[i], Scalar::Multiply(general[i], other[i])));
+        inverseError = std::max(inverseError, MaxDifference(general[i] * general[i].Inverse(), identity));
+        scalarInverseError = std::max(scalarInverseError, MaxDifference(general[i] * Scalar::Inverse(general[i]), identity));
+        affineError = std::max(affineError, MaxDifference(affine[i] * affine[i].InverseAffine(), identity));
+        const Vec3 a = general[i].MultiplyVec3(points[i]);
+        const Vec3 b = Scalar::MultiplyVec3(general[i], points[i]);
+        pointError = std::max({pointError, std::fabs(a.x - b.x), std::fabs(a.y - b.y), std::fabs(a.z - b.z)});
+    }
+    std::printf("  Largest difference to scalar: multiply %.2g, point %.2g\n", multiplyError, pointError);
+    std::printf("  Largest |M * inverse - I|: inverse %.2g (scalar %.2g), affine inverse %.2g\n", inverseError, scalarInverseError, affineError);
+    return std::max({multiplyError, inverseError, affineError, pointError}) < 1e-3f ? 0 : 1;
+}
@@ -0,0 +1,65 @@
+#include "Benchmark.h"
+#include "IFormatLoader.h"
+#include "ObjLoader.h"
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+using namespace Voltray::Engine;
+using namespace Voltray::Benchmarks;
+
+namespace
+{
+    std::size_t CountTriangles(const std::vector<MeshData> &meshes)
+    {
+        std::size_t triangles = 0;
+        for (const MeshData &mesh : meshes)
+            triangles += mesh.indices.size() / 3;
+        return triangles;
+    }
+
+    void PrintThroughput(const char *name, double megabytes, double milliseconds, std::size_t triangles)
+    {
+        std::printf("  %-12s %10.1f ms %10.1f MB/s %12zu triangles\n", name, milliseconds, megabytes / (milliseconds / 1000.0), triangles);
+    }
+}
+
+/**
+ * OBJ import throughput of the native loader against Assimp, on a given file or on a generated
+ * grid of quads (1000 x 1000 by default, about 100 MB).
+ *
+ * Usage: VoltrayObjLoaderBenchmark [file.obj | grid size]
+ */
+int main(int argc, char **argv)
+{
+    std::filesystem::path path;
+    bool generated = false;
+    if (argc > 1 && std::filesystem::exists(argv[1]))
+    {
+        path = argv[1];
+    }
+    else
+    {
+        path = std::filesystem::temp_directory_path() / "voltray_obj_benchmark.obj";
+        WriteObjGrid(path, GetCountArgument(argc, argv, 1, 1000));
+        generated = true;
+    }
+    const double megabytes = std::filesystem::file_size(path) / (1024.0 * 1024.0);
+    std::printf("OBJ import, %s, %.1f MB\n", path.string().c_str(), megabytes);
+
+    // Assimp is timed once, it takes long enough on large files for a single run to be stable
+    ObjLoader native;
+    AssimpLoader assimp;
+    std::size_t nativeTriangles = 0, assimpTriangles = 0;
+    const double nativeTime = MeasureMilliseconds(3, [&]()
+                                                  { nativeTriangles = CountTriangles(native.LoadMeshData(path.string())); });
+    const double assimpTime = MeasureMilliseconds(1, [&]()
+                                                  { assimpTriangles = CountTriangles(assimp.LoadMeshData(path.string())); });
+    PrintThroughput("Native", megabytes, nativeTime, nativeTriangles);
+    PrintThroughput("Assimp", megabytes, assimpTime, assimpTriangles);
+
+    if (generated)
+        std::filesystem::remove(path);
+    return 0;
+}
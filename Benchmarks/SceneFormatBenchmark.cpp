@@ -0,0 +1,126 @@
+#include "Benchmark.h"
+#include "Scene.h"
+#include "SceneObject.h"
+#include <glad/gl.h>
+#include <GLFW/glfw3.h>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace Voltray::Engine;
+using namespace Voltray::Benchmarks;
+
+namespace
+{
+    /**
+     * @brief Creates a hidden window so loaded scenes can create their placeholder mesh
+     */
+    GLFWwindow *CreateContext()
+    {
+        if (!glfwInit())
+            return nullptr;
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 5);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+        GLFWwindow *window = glfwCreateWindow(64, 64, "Voltray Benchmark", nullptr, nullptr);
+        if (!window)
+            return nullptr;
+        glfwMakeContextCurrent(window);
+        if (!gladLoadGL(glfwGetProcAddress))
+        {
+            glfwDestroyWindow(window);
+            return nullptr;
+        }
+        return window;
+    }
+
+    /**
+     * @brief Checks that a loaded scene has the objects, names and hierarchy of the saved one
+     */
+    bool MatchesScene(const Scene &loaded, const Scene &original)
+    {
+        const auto &objects = loaded.GetObjects();
+        const auto &expected = original.GetObjects();
+        if (objects.size() != expected.size())
+            return false;
+        for (std::size_t i = 0; i < objects.size(); ++i)
+        {
+            const SceneObject *parent = objects[i]->GetParent();
+            const SceneObject *expectedParent = expected[i]->GetParent();
+            if (objects[i]->GetName() != expected[i]->GetName() || (parent == nullptr) != (expectedParent == nullptr) ||
+                (parent && parent->GetName() != expectedParent->GetName()))
+                return false;
+        }
+        return true;
+    }
+}
+
+/**
+ * Scene save and load round trips through JSON and the binary .vscene format. Objects carry
+ * transforms, colors and parents but no mesh file, so loading measures the format and the
+ * scene bookkeeping rather than mesh imports.
+ *
+ * Usage: VoltraySceneFormatBenchmark [objects]
+ */
+int main(int argc, char **argv)
+{
+    const std::size_t objectCount = GetCountArgument(argc, argv, 1, 100000);
+    GLFWwindow *window = CreateContext();
+    if (!window)
+    {
+        std::fprintf(stderr, "An OpenGL 4.5 context is needed for the placeholder mesh\n");
+        glfwTerminate();
+        return 1;
+    }
+
+    // Groups of ten objects, each parented to the first of its group
+    Scene scene;
+    scene.Reserve(objectCount);
+    std::vector<std::shared_ptr<SceneObject>> objects;
+    objects.reserve(objectCount);
+    for (std::size_t i = 0; i < objectCount; ++i)
+    {
+        auto object = std::make_shared<SceneObject>("Object " + std::to_string(i));
+        object->GetTransform().SetPosition(Vec3(i * 0.5f, 1.25f, i * -0.1f));
+        object->GetTransform().SetRotation(Vec3(10.0f, 20.0f, static_cast<float>(i % 360)));
+        object->GetTransform().SetScale(Vec3(1.0f, 2.0f, 3.0f));
+        object->SetMaterialColor(Vec3(0.2f, 0.4f, 0.6f));
+        scene.AddObject(object);
+        if (i % 10 != 0)
+            object->SetParent(objects[i - i % 10].get(), false);
+        objects.push_back(std::move(object));
+    }
+    std::printf("Scene round trip, %zu objects\n", objectCount);
+
+    bool matches = true;
+    const std::filesystem::path directory = std::filesystem::temp_directory_path();
+    for (const char *extension : {".json", ".vscene"})
+    {
+        const std::string path = (directory / (std::string("voltray_scene_benchmark") + extension)).string();
+        bool saved = true;
+        const double saveTime = MeasureMilliseconds(3, [&]()
+                                                    { saved &= scene.SaveToFile(path); });
+
+        std::unique_ptr<Scene> loaded;
+        bool loadedAll = true;
+        const double loadTime = MeasureMilliseconds(3, [&]()
+                                                    {
+            loaded = std::make_unique<Scene>();
+            loadedAll &= loaded->LoadFromFile(path); });
+        matches &= saved && loadedAll && MatchesScene(*loaded, scene);
+
+        std::error_code error;
+        const double megabytes = std::filesystem::file_size(path, error) / (1024.0 * 1024.0);
+        std::printf("  %-8s %8.1f MB, save %10.1f ms, load %10.1f ms\n", extension, megabytes, saveTime, loadTime);
+        loaded.reset();
+        std::filesystem::remove(path, error);
+    }
+    std::printf("  %-40s %12s\n", "Loaded scenes match", matches ? "yes" : "no");
+
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    return matches ? 0 : 1;
+}
@@ -0,0 +1,209 @@
+#include "Benchmark.h"
+#include "Mat4.h"
+#include "Ray.h"
+#include "Vec3.h"
+#include "Vec3A.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <vector>
+
+#if defined(_MSC_VER)
+#define VOLTRAY_NOINLINE __declspec(noinline)
+#else
+#define VOLTRAY_NOINLINE __attribute__((noinline))
+#endif
+
+using namespace Voltray::Math;
+using namespace Voltray::Benchmarks;
+
+namespace
+{
+    /**
+     * Vector operations as calls, the way they were compiled when defined in Vec3.cpp
+     */
+    namespace OutOfLine
+    {
+        VOLTRAY_NOINLINE Vec3 Sub(const Vec3 &a, const Vec3 &b) { return a - b; }
+        VOLTRAY_NOINLINE Vec3 Cross(const Vec3 &a, const Vec3 &b) { return a.Cross(b); }
+        VOLTRAY_NOINLINE float Dot(const Vec3 &a, const Vec3 &b) { return a.Dot(b); }
+
+        /**
+         * Ray::IntersectTriangle with every vector operation a call
+         */
+        bool IntersectTriangle(const Vec3 &origin, const Vec3 &direction, const Vec3 &v0, const Vec3 &v1, const Vec3 &v2, float &t)
+        {
+            const float EPSILON = 1e-6f;
+            const Vec3 edge1 = Sub(v1, v0);
+            const Vec3 edge2 = Sub(v2, v0);
+            const Vec3 h = Cross(direction, edge2);
+            const float a = Dot(edge1, h);
+            if (std::abs(a) < EPSILON)
+                return false;
+
+            const float f = 1.0f / a;
+            const Vec3 s = Sub(origin, v0);
+            const float u = f * Dot(s, h);
+            if (u < -EPSILON || u > 1.0f + EPSILON)
+                return false;
+
+            const Vec3 q = Cross(s, edge1);
+            const float v = f * Dot(direction, q);
+            if (v < -EPSILON || u + v > 1.0f + EPSILON)
+                return false;
+
+            t = f * Dot(edge2, q);
+            return t > EPSILON;
+        }
+    }
+
+    /**
+     * World bounds from the 8 transformed corners, as SceneObject computed them before TransformBounds
+     */
+    void TransformCorners(const Mat4 &matrix, const Vec3 &minBounds, const Vec3 &maxBounds, Vec3 &outMin, Vec3 &outMax)
+    {
+        const float lowest = std::numeric_limits<float>::lowest();
+        const float highest = std::numeric_limits<float>::max();
+        outMin = Vec3(highest, highest, highest);
+        outMax = Vec3(lowest, lowest, lowest);
+        for (int corner = 0; corner < 8; ++corner)
+        {
+            const Vec3 point((corner & 1) ? maxBounds.x : minBounds.x, (corner & 2) ? maxBounds.y : minBounds.y, (corner & 4) ? maxBounds.z : minBounds.z);
+            const Vec3 world = matrix.MultiplyVec3(point);
+            outMin = Vec3(std::min(outMin.x, world.x), std::min(outMin.y, world.y), std::min(outMin.z, world.z));
+            outMax = Vec3(std::max(outMax.x, world.x), std::max(outMax.y, world.y), std::max(outMax.z, world.z));
+        }
+    }
+}
+
+/**
+ * The hot vector kernels: ray/triangle tests with inlined against out-of-line vector operations,
+ * world bounds from TransformBounds against 8 transformed corners, and point bounds over Vec3
+ * against Vec3A storage. Each pass covers a 2K-element working set.
+ *
+ * Usage: VoltrayVectorBenchmark [passes]
+ */
+int main(int argc, char **argv)
+{
+    const std::size_t passes = GetCountArgument(argc, argv, 1, 2000);
+    constexpr std::size_t WORKING_SET = 2048;
+    const double operations = static_cast<double>(passes * WORKING_SET);
+    std::printf("Vector kernels, %zu passes over %zu elements, time per element\n", passes, WORKING_SET);
+
+    std::mt19937 random(1);
+    std::uniform_real_distribution<float> uniform(-1.0f, 1.0f);
+    std::vector<Vec3> triangles(WORKING_SET * 3);
+    for (Vec3 &vertex : triangles)
+        vertex = Vec3(uniform(random), uniform(random), uniform(random) + 3.0f);
+    std::vector<Mat4> matrices(WORKING_SET);
+    for (Mat4 &matrix : matrices)
+    {
+        matrix = Mat4::Scale(Vec3(1.0f + uniform(random) * 0.5f, 1.0f, 1.0f)) * Mat4::RotateX(uniform(random) * 1.5f) *
+                 Mat4::RotateZ(uniform(random) * 1.5f) * Mat4::Translate(Vec3(uniform(random), uniform(random), uniform(random)));
+    }
+    std::vector<Vec3> points(WORKING_SET);
+    std::vector<Vec3A> alignedPoints(WORKING_SET);
+    for (std::size_t i = 0; i < WORKING_SET; ++i)
+    {
+        points[i] = Vec3(uniform(random), uniform(random), uniform(random));
+        alignedPoints[i] = Vec3A(points[i]);
+    }
+
+    const Ray ray(Vec3(0.0f, 0.0f, 0.0f), Vec3(0.01f, 0.02f, 1.0f));
+    const Vec3 origin = ray.GetOrigin();
+    const Vec3 direction = ray.GetDirection();
+    std::size_t inlineHits = 0, callHits = 0;
+    const double inlineTime = MeasureMilliseconds(3, [&]()
+                                                  {
+        inlineHits = 0;
+        for (std::size_t pass = 0; pass < passes; ++pass)
+        {
+            for (std::size_t i = 0; i < WORKING_SET; ++i)
+            {
+                float t;
+                inlineHits += ray.IntersectTriangle(triangles[i * 3], triangles[i * 3 + 1], triangles[i * 3 + 2], t);
+            }
+        } });
+    const double callTime = MeasureMilliseconds(3, [&]()
+                                                {
+        callHits = 0;
+        for (std::size_t pass = 0; pass < passes; ++pass)
+        {
+            for (std::size_t i = 0; i < WORKING_SET; ++i)
+            {
+                float t;
+                callHits += OutOfLine::IntersectTriangle(origin, direction, triangles[i * 3], triangles[i * 3 + 1], triangles[i * 3 + 2], t);
+            }
+        } });
+    std::printf("  %-40s %12.2f ns\n", "Ray/triangle, out-of-line vectors", callTime * 1e6 / operations);
+    std::printf("  %-40s %12.2f ns\n", "Ray/triangle, header-only vectors", inlineTime * 1e6 / operations);
+
+    const Vec3 meshMin(-1.0f, -2.0f, -0.5f), meshMax(1.0f, 2.0f, 0.5f);
+    float checksum = 0.0f;
+    const double cornerTime = MeasureMilliseconds(3, [&]()
+                                                  {
+        for (std::size_t pass = 0; pass < passes; ++pass)
+        {
+            for (const Mat4 &matrix : matrices)
+            {
+                Vec3 worldMin, worldMax;
+                TransformCorners(matrix, meshMin, meshMax, worldMin, worldMax);
+                checksum += worldMin.x + worldMax.z;
+            }
+        } });
+    const double boundsTime = MeasureMilliseconds(3, [&]()
+                                                  {
+        for (std::size_t pass = 0; pass < passes; ++pass)
+        {
+            for (const Mat4 &matrix : matrices)
+            {
+                Vec3 worldMin, worldMax;
+                matrix.TransformBounds(meshMin, meshMax, worldMin, worldMax);
+                checksum += worldMin.x + worldMax.z;
+            }
+        } });
+    std::printf("  %-40s %12.2f ns\n", "World bounds, 8 corners", cornerTime * 1e6 / operations);
+    std::printf("  %-40s %12.2f ns\n", "World bounds, TransformBounds", boundsTime * 1e6 / operations);
+
+    const double packedTime = MeasureMilliseconds(3, [&]()
+                                                  {
+        for (std::size_t pass = 0; pass < passes; ++pass)
+        {
+            Vec3 low = points[0], high = points[0];
+            for (const Vec3 &point : points)
+            {
+                low = Vec3(std::min(low.x, point.x), std::min(low.y, point.y), std::min(low.z, point.z));
+                high = Vec3(std::max(high.x, point.x), std::max(high.y, point.y), std::max(high.z, point.z));
+            }
+            checksum += low.x + high.y;
+        } });
+    const double alignedTime = MeasureMilliseconds(3, [&]()
+                                                   {
+        for (std::size_t pass = 0; pass < passes; ++pass)
+        {
+            Vec3A low = alignedPoints[0], high = alignedPoints[0];
+            for (const Vec3A &point : alignedPoints)
+            {
+                low = Vec3A::Min(low, point);
+                high = Vec3A::Max(high, point);
+            }
+            checksum += low.x + high.y;
+        } });
+    std::printf("  %-40s %12.2f ns\n", "Point bounds, Vec3", packedTime * 1e6 / operations);
+    std::printf("  %-40s %12.2f ns\n", "Point bounds, Vec3A", alignedTime * 1e6 / operations);
+
+    // TransformBounds gives the same box as the corners, up to float rounding
+    float boundsError = 0.0f;
+    for (const Mat4 &matrix : matrices)
+    {
+        Vec3 cornerMin, cornerMax, worldMin, worldMax;
+        TransformCorners(matrix, meshMin, meshMax, cornerMin, cornerMax);
+        matrix.TransformBounds(meshMin, meshMax, worldMin, worldMax);
+        boundsError = std::max({boundsError, std::fabs(cornerMin.x - worldMin.x), std::fabs(cornerMin.y - worldMin.y), std::fabs(cornerMin.z - worldMin.z),
+                                std::fabs(cornerMax.x - worldMax.x), std::fabs(cornerMax.y - worldMax.y), std::fabs(cornerMax.z - worldMax.z)});
+    }
+    std::printf("  Hits %zu / %zu, largest bounds difference %.2g (checksum %g)\n", inlineHits, callHits, boundsError, checksum);
+    return inlineHits == callHits && boundsError < 1e-4f ? 0 : 1;
+}
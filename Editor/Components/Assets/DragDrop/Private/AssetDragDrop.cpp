@@ -245,39 +245,47 @@ namespace Voltray::Editor::Components::Assets
 
             try
             {
-                // Use SceneObjectFactory to load the model from file
+                // Show a placeholder right away; the import runs in the background so the editor stays responsive
                 std::string fileName = assetPath.stem().string();
-                auto sceneObject = SceneObjectFactory::LoadFromFile(assetPath.string(), fileName);
-
-                if (sceneObject)
-                {
-                    // Convert screen position to world position using camera ray casting
-                    Ray ray = camera.ScreenToWorldRay(position.x, position.y);
-
-                    // Place object at a default distance along the ray
-                    float defaultDistance = 5.0f;
-                    Vec3 worldPosition = ray.origin + ray.direction * defaultDistance;
-
-                    // Set the object's position
-                    sceneObject->GetTransform().SetPosition(worldPosition);
-
-                    // Add to scene
-                    scene.AddObject(sceneObject);
-
-                    // Select the newly loaded object
-                    scene.SelectObject(sceneObject);
-
-                    Console::Print("Successfully loaded model '" + fileName + "' at position (" +
-                                   std::to_string(worldPosition.x) + ", " +
-                                   std::to_string(worldPosition.y) + ", " +
-                                   std::to_string(worldPosition.z) + ")");
-                    return true;
-                }
-                else
-                {
-                    Console::PrintError("Failed to create scene object from model file: " + assetPath.string());
-                    return false;
-                }
+                auto sceneObject = SceneObjectFactory::LoadFromFileAsync(
+                    assetPath.string(), fileName,
+                    [assetPath](const std::shared_ptr<Voltray::Engine::SceneObject> &object, const std::string &error)
+                    {
+                        if (error.empty())
+                        {
+                            Console::Print("Successfully loaded model '" + object->GetName() + "'");
+                            return;
+                        }
+
+                        Console::PrintError("Failed to load model '" + assetPath.string() + "': " + error);
+
+                        // Drop the placeholder so a failed import leaves no stray cube behind
+                        auto *app = EditorApp::Get();
+                        if (app && app->GetViewport())
+                            app->GetViewport()->GetScene().GetScene().RemoveObject(object);
+                    });
+
+                // Convert screen position to world position using camera ray casting
+                Ray ray = camera.ScreenToWorldRay(position.x, position.y);
+
+                // Place object at a default distance along the ray
+                float defaultDistance = 5.0f;
+                Vec3 worldPosition = ray.origin + ray.direction * defaultDistance;
+
+                // Set the object's position
+                sceneObject->GetTransform().SetPosition(worldPosition);
+
+                // Add to scene
+                scene.AddObject(sceneObject);
+
+                // Select the newly loaded object
+                scene.SelectObject(sceneObject);
+
+                Console::Print("Importing model '" + fileName + "' at position (" +
+                               std::to_string(worldPosition.x) + ", " +
+                               std::to_string(worldPosition.y) + ", " +
+                               std::to_string(worldPosition.z) + ")");
+                return true;
             }
             catch (const std::exception &e)
             {
@@ -8,6 +8,7 @@
 #include "PerspectiveCamera.h"
 #include "OrthographicCamera.h"
 #include "EngineSettings.h"
+#include "MeshCache.h"
 
 using namespace Voltray::Utils;
 
@@ -182,6 +183,38 @@ namespace Voltray::Editor::Components
                 // Settings automatically updated since we're modifying static members
             }
 
+            ImGui::Checkbox("Frustum Culling", &EngineSettings::FrustumCulling);
+            ImGui::Checkbox("GPU Instancing", &EngineSettings::GPUInstancing);
+
+            // Culling counters from the last rendered viewport frame
+            auto *editorApp = Editor::EditorApp::Get();
+            if (editorApp && editorApp->GetViewport())
+            {
+                const auto &renderer = editorApp->GetViewport()->GetRenderer();
+                const auto &stats = renderer.GetCullingStats();
+                ImGui::TextWrapped("Objects: %zu tested, %zu culled, %zu drawn", stats.tested, stats.culled, stats.drawn);
+                const auto &renderStats = renderer.GetRenderStats();
+                ImGui::TextWrapped("Draw calls: %zu (%zu instances)", renderStats.drawCalls, renderStats.instances);
+                ImGui::TextWrapped("Program binds: %zu, %zu skipped", renderStats.programChanges, renderStats.programSkips);
+                ImGui::TextWrapped("Vertex array binds: %zu, %zu skipped", renderStats.vertexArrayChanges, renderStats.vertexArraySkips);
+            }
+
+            // Imported mesh reuse
+            auto &meshCache = Voltray::Engine::MeshCache::GetInstance();
+            const auto cacheStats = meshCache.GetStats();
+            ImGui::TextWrapped("Mesh cache: %llu hits, %llu misses", static_cast<unsigned long long>(cacheStats.hits), static_cast<unsigned long long>(cacheStats.misses));
+            ImGui::TextWrapped("Mesh files: %zu live, %zu cached (%.1f MB)", cacheStats.liveFiles, cacheStats.cachedFiles, cacheStats.residentBytes / (1024.0 * 1024.0));
+            int budgetMegabytes = static_cast<int>(cacheStats.budgetBytes / (1024 * 1024));
+            if (ImGui::SliderInt("Mesh Cache Budget (MB)", &budgetMegabytes, 0, 4096))
+            {
+                meshCache.SetMemoryBudget(static_cast<std::size_t>(budgetMegabytes) * 1024 * 1024);
+            }
+            ImGui::Checkbox("Compress Imported Vertices", &EngineSettings::CompressVertices);
+            if (ImGui::IsItemHovered())
+            {
+                ImGui::SetTooltip("Halves vertex memory of meshes imported from now on; the console lists the error per mesh");
+            }
+
             ImGui::Separator();
 
             // Save/Load buttons
@@ -210,6 +243,9 @@ namespace Voltray::Editor::Components
                 EngineSettings::ClearColor[1] = 0.1f;
                 EngineSettings::ClearColor[2] = 0.1f;
                 EngineSettings::ClearColor[3] = 1.0f;
+                EngineSettings::FrustumCulling = true;
+                EngineSettings::GPUInstancing = true;
+                EngineSettings::CompressVertices = false;
                 Console::Print("Engine settings reset to defaults");
             }
             ImGui::Unindent();
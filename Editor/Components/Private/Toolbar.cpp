@@ -25,11 +25,30 @@ namespace Voltray::Editor::Components
                     auto *editorApp = EditorApp::Get();
                     if (editorApp && editorApp->GetViewport())
                     {
-                        editorApp->GetViewport()->GetScene().SaveScene("scene.json");
+                        editorApp->GetViewport()->GetScene().SaveScene("scene.vscene");
                     }
                 }
 
                 if (ImGui::MenuItem("Load Scene"))
+                {
+                    auto *editorApp = EditorApp::Get();
+                    if (editorApp && editorApp->GetViewport())
+                    {
+                        editorApp->GetViewport()->GetScene().LoadScene("scene.vscene");
+                    }
+                }
+
+                // JSON stays available for diffing and hand-editing scenes
+                if (ImGui::MenuItem("Export Scene as JSON"))
+                {
+                    auto *editorApp = EditorApp::Get();
+                    if (editorApp && editorApp->GetViewport())
+                    {
+                        editorApp->GetViewport()->GetScene().SaveScene("scene.json");
+                    }
+                }
+
+                if (ImGui::MenuItem("Import JSON Scene"))
                 {
                     auto *editorApp = EditorApp::Get();
                     if (editorApp && editorApp->GetViewport())
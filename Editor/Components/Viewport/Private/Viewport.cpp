@@ -3,8 +3,10 @@
 #include "Settings.h"
 #include "EditorApp.h"
 #include "AssetDragDrop.h"
+#include "AsyncMeshLoader.h"
 #include <imgui.h>
 #include <stdexcept>
+#include <string>
 
 namespace Voltray::Editor::Components
 {
@@ -78,6 +80,21 @@ namespace Voltray::Editor::Components
         // Handle input
         m_Input.ProcessInput(m_Scene.GetScene(), m_Scene.GetCamera(), imagePos, imageSize);
 
+        // Background import progress, drawn over the top-left corner of the image after input
+        // handling, which looks at the image as the last item
+        auto &meshLoader = Voltray::Engine::AsyncMeshLoader::GetInstance();
+        if (meshLoader.IsBusy())
+        {
+            const auto progress = meshLoader.GetProgress();
+            const std::size_t finished = progress.completed + progress.failed;
+            ImGui::SetCursorScreenPos(ImVec2(imagePos.x + 8.0f, imagePos.y + 8.0f));
+            const std::string label = "Importing " + std::to_string(finished) + "/" + std::to_string(progress.GetTotal());
+            ImGui::ProgressBar(static_cast<float>(finished) / static_cast<float>(progress.GetTotal()), ImVec2(200.0f, 0.0f), label.c_str());
+            ImGui::SameLine();
+            if (ImGui::SmallButton("Cancel"))
+                meshLoader.CancelAll();
+        }
+
         ImGui::End();
         ImGui::PopStyleColor();
         ImGui::PopStyleVar();
@@ -114,6 +131,11 @@ namespace Voltray::Editor::Components
             }
             Console::Print("Scene initialized successfully");
 
+            // The scene is destroyed before the renderer, so the listener never outlives it
+            m_Scene.GetScene().AddSelectionListener([this](const ::Scene &scene)
+                                                    { m_Renderer.OnSelectionChanged(scene); });
+            m_Renderer.OnSelectionChanged(m_Scene.GetScene());
+
             m_Initialized = true;
             Console::Print("All viewport components initialized successfully");
         }
@@ -4,7 +4,6 @@
 #include "Ray.h"
 #include "Mat4.h"
 #include <GLFW/glfw3.h>
-#include <limits>
 
 using namespace Voltray::Engine;
 
@@ -24,7 +23,7 @@ namespace Voltray::Editor::Components
             auto selectedObject = scene.GetSelectedObject();
             if (selectedObject)
             {
-                Vec3 objectPosition = selectedObject->GetTransform().GetPosition();
+                Vec3 objectPosition = selectedObject->GetTransform().GetWorldPosition();
                 camera.FocusOnObjectSmooth(objectPosition, 0.5f);
             }
         }
@@ -35,14 +34,14 @@ namespace Voltray::Editor::Components
             handleObjectSelection(scene, camera, viewportPos, viewportSize);
         }
 
-        // Handle deleting selected object on Delete key press
+        // Handle deleting selected objects on Delete key press
         if (ImGui::IsItemHovered() && ::Input::IsKeyPressed(GLFW_KEY_DELETE))
         {
-            auto selectedObject = scene.GetSelectedObject();
-            if (selectedObject)
+            // Removing an object deselects it, so work on a copy
+            const std::vector<std::shared_ptr<SceneObject>> selection = scene.GetSelection();
+            for (const auto &selectedObject : selection)
             {
                 scene.RemoveObject(selectedObject);
-                scene.ClearSelection(); // Clear selection after deletion
             }
         }
     }
@@ -62,47 +61,18 @@ namespace Voltray::Editor::Components
         // Create ray from camera through mouse position (using viewport-relative coordinates)
         Ray ray = camera.ScreenToWorldRay(relativePos.x, relativePos.y);
 
-        std::shared_ptr<SceneObject> closestObject = nullptr;
-        float closestDistance = std::numeric_limits<float>::max();
-        const auto &objects = scene.GetObjects();
-        for (const auto &obj : objects)
-        {
-            if (obj)
-            {
-
-                // First, perform AABB intersection test for early rejection
-                Vec3 minBounds, maxBounds;
-                obj->GetWorldBounds(minBounds, maxBounds);
+        // The scene tests object bounds first and only intersects the meshes the ray can reach
+        std::shared_ptr<SceneObject> closestObject = scene.RaycastToObject(ray);
 
-                float aabbDistance;
-                if (!ray.IntersectAABB(minBounds, maxBounds, aabbDistance))
-                {
-                    // Ray doesn't intersect the AABB, skip expensive mesh intersection
-                    continue;
-                }
-
-                // AABB test passed, now do detailed mesh intersection
-                float intersectionDistance = 0.0f;
-                auto mesh = obj->GetMesh();
-                if (mesh)
-                {
-                    // Get the object's model matrix (local to world transformation)
-                    Mat4 modelMatrix = obj->GetModelMatrix();
-                    if (ray.IntersectMesh(mesh->GetVertices(), mesh->GetIndices(), modelMatrix, intersectionDistance))
-                    {
-                        // Check if this is the closest object
-                        if (intersectionDistance < closestDistance)
-                        {
-                            closestDistance = intersectionDistance;
-                            closestObject = obj;
-                        }
-                    }
-                }
-            }
+        // Ctrl-click toggles the object in the selection; a plain click replaces the selection
+        if (ImGui::GetIO().KeyCtrl)
+        {
+            if (closestObject && scene.IsSelected(closestObject.get()))
+                scene.RemoveFromSelection(closestObject.get());
+            else if (closestObject)
+                scene.AddToSelection(closestObject);
         }
-
-        // Select the closest object or clear selection
-        if (closestObject)
+        else if (closestObject)
         {
             scene.SelectObject(closestObject);
         }
@@ -2,8 +2,13 @@
 #include "Console.h"
 #include "SceneObject.h"
 #include "ResourceManager.h"
+#include "EngineSettings.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 
 using Voltray::Utils::ResourceManager;
+using Voltray::Engine::EngineSettings;
 
 namespace Voltray::Editor::Components
 {
@@ -32,6 +37,8 @@ namespace Voltray::Editor::Components
             try
             {
                 m_Shader = std::make_unique<::Shader>(defaultVertPath, defaultFragPath);
+                m_Shader->BindUniformBlock(FrameData::BLOCK_NAME, FrameData::BINDING);
+                m_Shader->BindStorageBlock(ObjectData::BLOCK_NAME, ObjectData::BINDING);
             }
             catch (const std::exception &e)
             {
@@ -46,6 +53,7 @@ namespace Voltray::Editor::Components
             try
             {
                 m_SkyboxShader = std::make_unique<::Shader>(skyboxVertPath, skyboxFragPath);
+                m_SkyboxShader->BindUniformBlock(FrameData::BLOCK_NAME, FrameData::BINDING);
             }
             catch (const std::exception &e)
             {
@@ -60,6 +68,9 @@ namespace Voltray::Editor::Components
             try
             {
                 m_OutlineShader = std::make_unique<::Shader>(outlineVertPath, outlineFragPath);
+                m_OutlineShader->BindUniformBlock(FrameData::BLOCK_NAME, FrameData::BINDING);
+                m_OutlineModelUniform = m_OutlineShader->GetUniformHandle("u_Model");
+                m_OutlineColorUniform = m_OutlineShader->GetUniformHandle("u_OutlineColor");
             }
             catch (const std::exception &e)
             {
@@ -68,6 +79,10 @@ namespace Voltray::Editor::Components
             }
         }
 
+        // Per-frame and per-object shader data
+        m_FrameUniforms = std::make_unique<UniformBuffer>(sizeof(FrameData));
+        m_ObjectBuffer = std::make_unique<PersistentRingBuffer>(GL_SHADER_STORAGE_BUFFER);
+
         // Setup full-screen triangle for skybox rendering
         {
             // Triangle that covers the screen
@@ -96,11 +111,12 @@ namespace Voltray::Editor::Components
         glClearColor(0.1f, 0.1f, 0.1f, 1.0f); // Set your preferred background color
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-        // Update camera
+        // Update camera and upload its matrices for every shader
         camera.Update();
+        updateFrameData(camera);
 
         // Render skybox first
-        renderSkybox(camera);
+        renderSkybox();
 
         // Clear depth buffer after skybox to ensure proper depth testing for scene objects
         glClear(GL_DEPTH_BUFFER_BIT);
@@ -112,7 +128,7 @@ namespace Voltray::Editor::Components
         renderSceneObjects(scene, camera, renderer);
 
         // Render selection outlines
-        renderSelectionOutlines(scene, camera);
+        renderSelectionOutlines();
     }
 
     bool ViewportRenderer::IsInitialized() const
@@ -120,7 +136,28 @@ namespace Voltray::Editor::Components
         return m_Shader && m_SkyboxShader && m_OutlineShader;
     }
 
-    void ViewportRenderer::renderSkybox(::BaseCamera &camera)
+    void ViewportRenderer::updateFrameData(::BaseCamera &camera)
+    {
+        if (!m_FrameUniforms)
+            return;
+
+        FrameData frameData;
+        const Mat4 viewProjection = camera.GetViewProjectionMatrix();
+        const Mat4 inverseViewProjection = viewProjection.Inverse();
+        std::memcpy(frameData.viewProjection, viewProjection.data, sizeof(frameData.viewProjection));
+        std::memcpy(frameData.inverseViewProjection, inverseViewProjection.data, sizeof(frameData.inverseViewProjection));
+
+        const Vec3 &cameraPosition = camera.GetPosition();
+        frameData.cameraPosition[0] = cameraPosition.x;
+        frameData.cameraPosition[1] = cameraPosition.y;
+        frameData.cameraPosition[2] = cameraPosition.z;
+        frameData.cameraPosition[3] = 1.0f;
+
+        m_FrameUniforms->SetData(&frameData, sizeof(frameData));
+        m_FrameUniforms->BindBase(FrameData::BINDING);
+    }
+
+    void ViewportRenderer::renderSkybox()
     {
         if (!m_SkyboxShader)
         {
@@ -132,12 +169,9 @@ namespace Voltray::Editor::Components
         glDepthFunc(GL_LEQUAL);
         glDepthMask(GL_FALSE);
 
+        // The inverse view-projection matrix comes from the frame uniform block
         m_SkyboxShader->Bind();
 
-        // Set the inverse view-projection matrix uniform
-        auto invVP = camera.GetViewProjectionMatrix().Inverse();
-        m_SkyboxShader->SetUniformMat4("u_InverseViewProj", invVP.data);
-
         // Bind full-screen triangle VAO and draw
         glBindVertexArray(m_SkyboxVAO);
         glDrawArrays(GL_TRIANGLES, 0, 3);
@@ -150,40 +184,143 @@ namespace Voltray::Editor::Components
 
     void ViewportRenderer::renderSceneObjects(::Scene &scene, ::BaseCamera &camera, ::Renderer &renderer)
     {
-        (void)renderer; // Suppress unreferenced parameter warning
-        if (!m_Shader)
+        if (!m_Shader || !m_ObjectBuffer)
             return;
 
-        m_Shader->Bind();
-        m_Shader->SetUniformMat4("u_ViewProjection", camera.GetViewProjectionMatrix().data);
+        // Cull against the camera frustum first so only visible objects reach GL
+        m_Culler.SetEnabled(EngineSettings::FrustumCulling);
+        m_Culler.Cull(scene.GetObjects(), camera.GetViewProjectionMatrix(), m_VisibleObjects);
+
+        buildRenderQueue(camera, *m_Shader);
+        writeObjectData();
+
+        // The skybox and outline passes bind GL state directly, so start from a clean cache
+        RenderStateCache &stateCache = renderer.GetStateCache();
+        stateCache.Invalidate();
+        stateCache.ResetStats();
 
-        // Render each object with its material color
-        auto &objects = scene.GetObjects();
-        for (auto &object : objects)
+        if (EngineSettings::GPUInstancing)
+            drawObjectsInstanced(stateCache);
+        else
+            drawObjects(stateCache);
+
+        // The segment may be reused once the GPU has finished these draws
+        m_ObjectBuffer->EndSegment();
+
+        // Leave nothing bound for the passes that follow
+        stateCache.BindVertexArray(0);
+        stateCache.UseProgram(0);
+        m_RenderStats = stateCache.GetStats();
+    }
+
+    void ViewportRenderer::buildRenderQueue(::BaseCamera &camera, const ::Shader &shader)
+    {
+        const Vec3 cameraPosition = camera.GetPosition();
+        const Vec3 forward = camera.GetForward();
+
+        m_RenderQueue.Clear();
+        for (size_t i = 0; i < m_VisibleObjects.size(); ++i)
         {
-            if (object && object->IsVisible() && object->GetMesh())
-            {
-                m_Shader->SetUniformMat4("u_Model", object->GetModelMatrix().data);
+            const SceneObject *object = m_VisibleObjects[i];
+
+            // Material color quantized to 5:6:5 so equal colors share a key
+            const Vec3 &color = object->GetMaterialColor();
+            auto channel = [](float value, float maxValue)
+            { return static_cast<std::uint32_t>(std::clamp(value, 0.0f, 1.0f) * maxValue + 0.5f); };
+            const std::uint32_t material = (channel(color.x, 31.0f) << 11) | (channel(color.y, 63.0f) << 5) | channel(color.z, 31.0f);
+
+            Vec3 minBounds, maxBounds;
+            object->GetWorldBounds(minBounds, maxBounds);
+            const Vec3 center = (minBounds + maxBounds) * 0.5f;
+            const float depth = (center - cameraPosition).Dot(forward);
+
+            const std::uint64_t key = RenderQueue::MakeKey(shader.GetID(), object->GetMesh()->GetVertexArrayID(), material,
+                                                           RenderQueue::QuantizeDepth(depth, camera.GetNearPlane(), camera.GetFarPlane()));
+            m_RenderQueue.Submit(key, static_cast<std::uint32_t>(i));
+        }
+        m_RenderQueue.Sort();
+    }
 
-                // Set the material color uniform
-                Vec3 materialColor = object->GetMaterialColor();
-                m_Shader->SetUniform3f("u_MaterialColor", materialColor.x, materialColor.y, materialColor.z);
+    void ViewportRenderer::writeObjectData()
+    {
+        // Record i belongs to queue item i, so a draw's base instance is its queue position
+        const std::vector<RenderItem> &items = m_RenderQueue.GetItems();
+        auto *objects = static_cast<ObjectData *>(m_ObjectBuffer->BeginSegment(items.size() * sizeof(ObjectData)));
+        for (size_t i = 0; i < items.size(); ++i)
+        {
+            const SceneObject *object = m_VisibleObjects[items[i].index];
+            ObjectData &data = objects[i];
+            std::memcpy(data.model, object->GetModelMatrix().data, sizeof(data.model));
+
+            const Vec3 &materialColor = object->GetMaterialColor();
+            data.materialColor[0] = materialColor.x;
+            data.materialColor[1] = materialColor.y;
+            data.materialColor[2] = materialColor.z;
+            data.materialColor[3] = 1.0f;
+
+            // Compressed meshes are decoded in the vertex shader
+            const VertexLayout &layout = object->GetMesh()->GetLayout();
+            const Vec3 &scale = layout.GetPositionScale();
+            const Vec3 &offset = layout.GetPositionOffset();
+            data.positionScale[0] = scale.x;
+            data.positionScale[1] = scale.y;
+            data.positionScale[2] = scale.z;
+            data.positionScale[3] = layout.HasOctahedralNormals() ? 1.0f : 0.0f;
+            data.positionOffset[0] = offset.x;
+            data.positionOffset[1] = offset.y;
+            data.positionOffset[2] = offset.z;
+            data.positionOffset[3] = 0.0f;
+        }
+        m_ObjectBuffer->BindSegment(ObjectData::BINDING);
+    }
 
-                object->GetMesh()->Draw();
-            }
+    void ViewportRenderer::drawObjects(RenderStateCache &stateCache)
+    {
+        stateCache.UseProgram(m_Shader->GetID());
+
+        // One draw per object; the base instance selects its ObjectData record
+        const std::vector<RenderItem> &items = m_RenderQueue.GetItems();
+        for (size_t i = 0; i < items.size(); ++i)
+        {
+            const Mesh &mesh = *m_VisibleObjects[items[i].index]->GetMesh();
+            stateCache.BindVertexArray(mesh.GetVertexArrayID());
+            stateCache.DrawElementsInstanced(static_cast<GLsizei>(mesh.GetIndexCount()), 1, static_cast<GLuint>(i));
         }
+    }
+
+    void ViewportRenderer::drawObjectsInstanced(RenderStateCache &stateCache)
+    {
+        stateCache.UseProgram(m_Shader->GetID());
 
-        // Unbind shader to prevent conflicts
-        m_Shader->Unbind();
+        // Objects sharing a mesh are adjacent in the queue, so each run is one instanced draw
+        const std::vector<RenderItem> &items = m_RenderQueue.GetItems();
+        size_t first = 0;
+        while (first < items.size())
+        {
+            const Mesh &mesh = *m_VisibleObjects[items[first].index]->GetMesh();
+            size_t last = first + 1;
+            while (last < items.size() && m_VisibleObjects[items[last].index]->GetMesh().get() == &mesh)
+                ++last;
+
+            stateCache.BindVertexArray(mesh.GetVertexArrayID());
+            stateCache.DrawElementsInstanced(static_cast<GLsizei>(mesh.GetIndexCount()), static_cast<GLsizei>(last - first),
+                                             static_cast<GLuint>(first));
+            first = last;
+        }
     }
 
-    void ViewportRenderer::renderSelectionOutlines(::Scene &scene, ::BaseCamera &camera)
+    void ViewportRenderer::OnSelectionChanged(const ::Scene &scene)
     {
-        if (!m_OutlineShader)
-            return;
+        m_OutlineObjects.clear();
+        for (const auto &object : scene.GetSelection())
+        {
+            m_OutlineObjects.push_back(object.get());
+        }
+    }
 
-        auto selectedObject = scene.GetSelectedObject();
-        if (!selectedObject || !selectedObject->GetMesh())
+    void ViewportRenderer::renderSelectionOutlines()
+    {
+        if (!m_OutlineShader || m_OutlineObjects.empty())
             return;
 
         // Save OpenGL state
@@ -202,11 +339,17 @@ namespace Voltray::Editor::Components
         glLineWidth(2.0f);
 
         m_OutlineShader->Bind();
-        m_OutlineShader->SetUniformMat4("u_ViewProjection", camera.GetViewProjectionMatrix().data);
-        m_OutlineShader->SetUniformMat4("u_Model", selectedObject->GetModelMatrix().data);
-        m_OutlineShader->SetUniform3f("u_OutlineColor", 0.7f, 0.9f, 1.0f); // Glowing light blue closer to white
+        m_OutlineShader->Set(m_OutlineColorUniform, Vec3(0.7f, 0.9f, 1.0f)); // Glowing light blue closer to white
 
-        selectedObject->GetMesh()->Draw();
+        for (SceneObject *object : m_OutlineObjects)
+        {
+            if (!object->GetMesh())
+                continue;
+
+            const Mat4 modelMatrix = object->GetMesh()->GetLayout().GetPositionDecodeMatrix() * object->GetModelMatrix();
+            m_OutlineShader->Set(m_OutlineModelUniform, modelMatrix);
+            object->GetMesh()->Draw();
+        }
 
         // Restore OpenGL state
         glPolygonMode(GL_FRONT_AND_BACK, polygonMode[0]);
@@ -33,6 +33,12 @@ namespace Voltray::Editor::Components
          */
         ViewportScene &GetScene() { return m_Scene; }
 
+        /**
+         * @brief Get the viewport renderer component
+         * @return Reference to the ViewportRenderer
+         */
+        const ViewportRenderer &GetRenderer() const { return m_Renderer; }
+
     private:
         void initialize();
         bool isInitialized() const;
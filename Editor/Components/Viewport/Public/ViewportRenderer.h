@@ -4,7 +4,14 @@
 #include "Renderer.h"
 #include "Scene.h"
 #include "BaseCamera.h"
+#include "FrustumCuller.h"
+#include "PersistentRingBuffer.h"
+#include "RenderQueue.h"
+#include "RenderStateCache.h"
+#include "ShaderData.h"
+#include "UniformBuffer.h"
 #include <memory>
+#include <vector>
 #include <glad/gl.h>
 
 // Engine components
@@ -42,15 +49,55 @@ namespace Voltray::Editor::Components
          */
         bool IsInitialized() const;
 
+        /**
+         * @brief Refresh the objects drawn with selection outlines
+         * @param scene Scene whose selection changed
+         */
+        void OnSelectionChanged(const ::Scene &scene);
+
+        /**
+         * @brief Get the culling counters of the last rendered frame
+         * @return Tested, culled and drawn object counts
+         */
+        const FrustumCuller::Stats &GetCullingStats() const { return m_Culler.GetStats(); }
+
+        /**
+         * @brief Get the state change and draw counters of the last scene object pass
+         * @return Program/vertex array changes and skips, draw calls and instances
+         */
+        const RenderStateCache::Stats &GetRenderStats() const { return m_RenderStats; }
+
     private:
-        void renderSkybox(::BaseCamera &camera);
+        void updateFrameData(::BaseCamera &camera);
+        void renderSkybox();
         void renderSceneObjects(::Scene &scene, ::BaseCamera &camera, ::Renderer &renderer);
-        void renderSelectionOutlines(::Scene &scene, ::BaseCamera &camera);
+        void buildRenderQueue(::BaseCamera &camera, const ::Shader &shader);
+        void writeObjectData();
+        void drawObjects(RenderStateCache &stateCache);
+        void drawObjectsInstanced(RenderStateCache &stateCache);
+        void renderSelectionOutlines();
 
         // Shader resources
         std::unique_ptr<::Shader> m_Shader;
         std::unique_ptr<::Shader> m_SkyboxShader;
         std::unique_ptr<::Shader> m_OutlineShader;
+        UniformHandle m_OutlineModelUniform;
+        UniformHandle m_OutlineColorUniform;
+
+        // Selected objects, updated by selection events
+        std::vector<SceneObject *> m_OutlineObjects;
+
+        // Culling stage and its per-frame output
+        FrustumCuller m_Culler;
+        std::vector<SceneObject *> m_VisibleObjects;
+
+        // Visible objects sorted by shader, mesh, material and depth
+        RenderQueue m_RenderQueue;
+        RenderStateCache::Stats m_RenderStats;
+
+        // Camera data shared by all shaders, and one ObjectData record per queued object in queue order
+        std::unique_ptr<UniformBuffer> m_FrameUniforms;
+        std::unique_ptr<PersistentRingBuffer> m_ObjectBuffer;
 
         // Full-screen triangle for skybox
         GLuint m_SkyboxVAO;
@@ -12,6 +12,8 @@
 #include "Input.h"
 #include "ResourceManager.h"
 #include "Workspace.h"
+#include "CookedMeshCache.h"
+#include "AsyncMeshLoader.h"
 #include "Toolbar.h"
 #include "Viewport.h"
 #include "Inspector.h"
@@ -80,7 +82,7 @@ namespace Voltray::Editor
         }
         ImGui::StyleColorsDark();
         ImGui_ImplGlfw_InitForOpenGL(window, true);
-        ImGui_ImplOpenGL3_Init("#version 460"); // Initialize theme system
+        ImGui_ImplOpenGL3_Init("#version 450"); // Initialize theme system
         UI::ThemeManager::GetInstance().Initialize();
 
         // Initialize components
@@ -106,6 +108,9 @@ namespace Voltray::Editor
     }
     void EditorApp::RenderUI()
     {
+        // Swap finished background imports into the scene before anything draws it
+        Voltray::Engine::AsyncMeshLoader::GetInstance().ProcessUploads(MESH_UPLOAD_BUDGET_MS);
+
         ImGui_ImplOpenGL3_NewFrame();
         ImGui_ImplGlfw_NewFrame();
         ImGui::NewFrame(); // Show workspace dialog on first frame
@@ -197,6 +202,9 @@ namespace Voltray::Editor
             m_Assets->OnWorkspaceChanged(workspace);
         }
 
+        // Cook imported meshes into the workspace's internal data folder
+        Voltray::Engine::CookedMeshCache::SetDirectory(workspace.path / ".voltray" / "CookedMeshes");
+
         // Update other workspace-dependent components
         UpdateWindowTitle();
         // Set workspace manager current workspace
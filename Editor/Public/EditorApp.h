@@ -104,6 +104,9 @@ namespace Voltray::Editor
          */
         void UpdateWindowTitle();
 
+        /// Time per frame spent turning imported meshes into GPU buffers
+        static constexpr double MESH_UPLOAD_BUDGET_MS = 4.0;
+
         std::unique_ptr<Components::Toolbar> m_Toolbar;
         std::unique_ptr<Components::Viewport> m_Viewport;
         std::unique_ptr<Components::Inspector> m_Inspector;
@@ -13,6 +13,9 @@ namespace Voltray::Engine
     float EngineSettings::CameraMaxDistance = 100.0f;
     float EngineSettings::MouseClampDelta = 22.0f;
     float EngineSettings::ClearColor[4] = {0.1f, 0.1f, 0.1f, 1.0f};
+    bool EngineSettings::FrustumCulling = true;
+    bool EngineSettings::GPUInstancing = true;
+    bool EngineSettings::CompressVertices = false;
 
     void EngineSettings::Load(const std::string &filename)
     {
@@ -32,6 +35,21 @@ namespace Voltray::Engine
         {
             file >> ClearColor[i];
         }
+
+        // Settings files written before these options existed end here
+        bool frustumCulling, gpuInstancing, compressVertices;
+        if (file >> frustumCulling)
+        {
+            FrustumCulling = frustumCulling;
+        }
+        if (file >> gpuInstancing)
+        {
+            GPUInstancing = gpuInstancing;
+        }
+        if (file >> compressVertices)
+        {
+            CompressVertices = compressVertices;
+        }
         file.close();
     }
 
@@ -53,6 +71,10 @@ namespace Voltray::Engine
         {
             file << ClearColor[i] << " ";
         }
+        file << "\n"
+             << FrustumCulling << "\n"
+             << GPUInstancing << "\n"
+             << CompressVertices << "\n";
         file.close();
     }
 }
\ No newline at end of file
@@ -16,7 +16,14 @@ namespace Voltray::Engine
 
         static float ClearColor[4]; // RGBA
 
-        // Renderer, input, audio... (later)
+        // Renderer
+        static bool FrustumCulling;
+        static bool GPUInstancing;
+
+        // Import
+        static bool CompressVertices; // Store imported meshes with 16-bit positions, normals and texture coordinates
+
+        // Input, audio... (later)
 
         static void Load(const std::string &filename);
         static void Save(const std::string &filename);
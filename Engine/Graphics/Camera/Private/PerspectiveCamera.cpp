@@ -47,7 +47,7 @@ namespace Voltray::Engine
 
         // Transform ray direction to world space
         Mat4 viewMatrix = GetViewMatrix();
-        Mat4 invViewMatrix = viewMatrix.Inverse();
+        Mat4 invViewMatrix = viewMatrix.InverseAffine();
 
         Vec3 rayDirWorld = invViewMatrix.MultiplyVec4(Vec4(rayDirView.x, rayDirView.y, rayDirView.z, 0.0f)).xyz().Normalize();
 
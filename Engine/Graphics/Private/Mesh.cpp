@@ -5,8 +5,8 @@
 namespace Voltray::Engine
 {
 
-    Mesh::Mesh(float *vertices, unsigned int vSize, unsigned int *indices, unsigned int iCount)
-        : m_VBO(vertices, vSize), m_IBO(indices, iCount)
+    Mesh::Mesh(float *vertices, unsigned int vSize, unsigned int *indices, unsigned int iCount, const VertexLayout &layout)
+        : m_VBO(vertices, vSize), m_IBO(indices, iCount), m_Layout(layout)
     {
         // Store vertex data
         m_Vertices.assign(vertices, vertices + (vSize / sizeof(float)));
@@ -17,29 +17,18 @@ namespace Voltray::Engine
         m_VAO.Bind();
         m_VBO.Bind();
         m_IBO.Bind();
-        m_VAO.AddVertexAttribute(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void *)0);
+        m_VAO.AddVertexLayout(m_Layout);
     }
 
-    Mesh::Mesh(const std::vector<float> &vertices, const std::vector<unsigned int> &indices)
+    Mesh::Mesh(const std::vector<float> &vertices, const std::vector<unsigned int> &indices, const VertexLayout &layout)
         : m_VBO(const_cast<float *>(vertices.data()), vertices.size() * sizeof(float)),
           m_IBO(const_cast<unsigned int *>(indices.data()), indices.size()),
-          m_Vertices(vertices), m_Indices(indices)
+          m_Vertices(vertices), m_Indices(indices), m_Layout(layout)
     {
         m_VAO.Bind();
         m_VBO.Bind();
         m_IBO.Bind();
-
-        // Vertex layout: position (3) + normal (3) + texcoord (2) = 8 floats per vertex
-        const unsigned int stride = 8 * sizeof(float);
-
-        // Position attribute (location 0)
-        m_VAO.AddVertexAttribute(0, 3, GL_FLOAT, GL_FALSE, stride, (void *)0);
-
-        // Normal attribute (location 1)
-        m_VAO.AddVertexAttribute(1, 3, GL_FLOAT, GL_FALSE, stride, (void *)(3 * sizeof(float)));
-
-        // Texture coordinate attribute (location 2)
-        m_VAO.AddVertexAttribute(2, 2, GL_FLOAT, GL_FALSE, stride, (void *)(6 * sizeof(float)));
+        m_VAO.AddVertexLayout(m_Layout);
     }
 
     Mesh::~Mesh()
@@ -62,40 +51,39 @@ namespace Voltray::Engine
             return;
         }
 
-        if (m_Vertices.empty())
+        // Quantized layouts are decoded on the fly, the decoded copy is only made for picking
+        const bool inPlace = m_Layout.HasInPlacePositions();
+        const std::size_t stride = m_Layout.GetFloatStride();
+        const std::size_t vertexCount = m_Layout.GetVertexCount(m_Vertices);
+        if (vertexCount == 0 || !m_Layout.Find(VertexAttribute::Position))
         {
             minBounds = Voltray::Math::Vec3(-0.5f, -0.5f, -0.5f);
             maxBounds = Voltray::Math::Vec3(0.5f, 0.5f, 0.5f);
             return;
         }
 
+        auto readPosition = [&](std::size_t vertex)
+        {
+            const float *data = &m_Vertices[vertex * stride];
+            return inPlace ? Voltray::Math::Vec3(data[0], data[1], data[2]) : m_Layout.ReadPosition(data);
+        };
+
         // Initialize bounds to first vertex position
-        m_MinBounds = Voltray::Math::Vec3(m_Vertices[0], m_Vertices[1], m_Vertices[2]);
+        m_MinBounds = readPosition(0);
         m_MaxBounds = m_MinBounds;
 
-        // Determine vertex stride - check if we have 8 floats per vertex (pos + normal + texcoord)
-        // or just 3 floats per vertex (position only)
-        int stride = 8; // Default to full vertex layout
-        if (m_Vertices.size() % 8 != 0 && m_Vertices.size() % 3 == 0)
-        {
-            stride = 3; // Simple position-only vertices
-        }
-
         // Iterate through all vertex positions
-        for (size_t i = 0; i < m_Vertices.size(); i += stride)
+        for (size_t i = 1; i < vertexCount; ++i)
         {
-            if (i + 2 < m_Vertices.size()) // Ensure we have at least x, y, z
-            {
-                Voltray::Math::Vec3 position(m_Vertices[i], m_Vertices[i + 1], m_Vertices[i + 2]);
+            Voltray::Math::Vec3 position = readPosition(i);
 
-                m_MinBounds.x = std::min(m_MinBounds.x, position.x);
-                m_MinBounds.y = std::min(m_MinBounds.y, position.y);
-                m_MinBounds.z = std::min(m_MinBounds.z, position.z);
+            m_MinBounds.x = std::min(m_MinBounds.x, position.x);
+            m_MinBounds.y = std::min(m_MinBounds.y, position.y);
+            m_MinBounds.z = std::min(m_MinBounds.z, position.z);
 
-                m_MaxBounds.x = std::max(m_MaxBounds.x, position.x);
-                m_MaxBounds.y = std::max(m_MaxBounds.y, position.y);
-                m_MaxBounds.z = std::max(m_MaxBounds.z, position.z);
-            }
+            m_MaxBounds.x = std::max(m_MaxBounds.x, position.x);
+            m_MaxBounds.y = std::max(m_MaxBounds.y, position.y);
+            m_MaxBounds.z = std::max(m_MaxBounds.z, position.z);
         }
 
         m_BoundsCalculated = true;
@@ -110,4 +98,40 @@ namespace Voltray::Engine
         return (minBounds + maxBounds) * 0.5f;
     }
 
-}
\ No newline at end of file
+
+    const Voltray::Math::BVH &Mesh::GetBVH() const
+    {
+        if (!m_BVH)
+        {
+            m_BVH = std::make_unique<Voltray::Math::BVH>(GetPositions(), m_Indices, GetPositionStride());
+        }
+        return *m_BVH;
+    }
+
+    const std::vector<float> &Mesh::GetPositions() const
+    {
+        if (m_Layout.HasInPlacePositions())
+            return m_Vertices;
+
+        if (m_Positions.empty() && m_Layout.Find(VertexAttribute::Position))
+        {
+            const std::size_t vertexCount = m_Layout.GetVertexCount(m_Vertices);
+            const std::size_t stride = m_Layout.GetFloatStride();
+            m_Positions.resize(vertexCount * 3);
+            for (std::size_t i = 0; i < vertexCount; ++i)
+            {
+                const Voltray::Math::Vec3 position = m_Layout.ReadPosition(&m_Vertices[i * stride]);
+                m_Positions[i * 3] = position.x;
+                m_Positions[i * 3 + 1] = position.y;
+                m_Positions[i * 3 + 2] = position.z;
+            }
+        }
+        return m_Positions;
+    }
+
+    unsigned int Mesh::GetPositionStride() const
+    {
+        return m_Layout.HasInPlacePositions() ? m_Layout.GetFloatStride() : 3;
+    }
+
+}
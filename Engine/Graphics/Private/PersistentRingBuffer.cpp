@@ -0,0 +1,120 @@
+#include "PersistentRingBuffer.h"
+#include <algorithm>
+
+namespace Voltray::Engine
+{
+
+    namespace
+    {
+        constexpr GLbitfield MAP_FLAGS = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        constexpr std::size_t MIN_SEGMENT_SIZE = 16 * 1024;
+    }
+
+    PersistentRingBuffer::PersistentRingBuffer(GLenum target)
+        : m_Target(target)
+    {
+        // Segments are bound with glBindBufferRange, so each must start on the offset alignment
+        GLint alignment = 1;
+        glGetIntegerv(target == GL_UNIFORM_BUFFER ? GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT : GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT,
+                      &alignment);
+        m_Alignment = static_cast<std::size_t>(std::max(alignment, 1));
+    }
+
+    PersistentRingBuffer::~PersistentRingBuffer()
+    {
+        Release();
+    }
+
+    void *PersistentRingBuffer::BeginSegment(std::size_t size)
+    {
+        m_Current = (m_Current + 1) % SEGMENT_COUNT;
+        m_UsedSize = size;
+
+        if (size > m_SegmentSize)
+        {
+            // Other segments may still be read by the GPU; wait for all of them before freeing
+            for (int segment = 0; segment < SEGMENT_COUNT; ++segment)
+                WaitForSegment(segment);
+            Release();
+            Allocate(std::max({size, m_SegmentSize + m_SegmentSize / 2, MIN_SEGMENT_SIZE}));
+        }
+        else
+        {
+            WaitForSegment(m_Current);
+        }
+
+        return m_Mapped + m_Current * m_SegmentSize;
+    }
+
+    void PersistentRingBuffer::BindSegment(GLuint binding) const
+    {
+        if (m_ID == 0)
+            return;
+
+        glBindBufferRange(m_Target, binding, m_ID, static_cast<GLintptr>(m_Current * m_SegmentSize),
+                          static_cast<GLsizeiptr>(std::max(m_UsedSize, m_Alignment)));
+    }
+
+    void PersistentRingBuffer::EndSegment()
+    {
+        if (m_ID == 0)
+            return;
+
+        m_Fences[m_Current] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+
+    void PersistentRingBuffer::Allocate(std::size_t segmentSize)
+    {
+        m_SegmentSize = (segmentSize + m_Alignment - 1) / m_Alignment * m_Alignment;
+        const GLsizeiptr totalSize = static_cast<GLsizeiptr>(m_SegmentSize * SEGMENT_COUNT);
+
+        glGenBuffers(1, &m_ID);
+        glBindBuffer(m_Target, m_ID);
+        glBufferStorage(m_Target, totalSize, nullptr, MAP_FLAGS);
+        m_Mapped = static_cast<unsigned char *>(glMapBufferRange(m_Target, 0, totalSize, MAP_FLAGS));
+        glBindBuffer(m_Target, 0);
+    }
+
+    void PersistentRingBuffer::Release()
+    {
+        for (GLsync &fence : m_Fences)
+        {
+            if (fence)
+            {
+                glDeleteSync(fence);
+                fence = nullptr;
+            }
+        }
+
+        if (m_ID != 0)
+        {
+            glBindBuffer(m_Target, m_ID);
+            glUnmapBuffer(m_Target);
+            glBindBuffer(m_Target, 0);
+            glDeleteBuffers(1, &m_ID);
+            m_ID = 0;
+            m_Mapped = nullptr;
+        }
+    }
+
+    void PersistentRingBuffer::WaitForSegment(int segment)
+    {
+        GLsync &fence = m_Fences[segment];
+        if (!fence)
+            return;
+
+        // Flush on the first wait so the fence is guaranteed to signal
+        GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+        while (true)
+        {
+            GLenum result = glClientWaitSync(fence, flags, 1000000);
+            if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED || result == GL_WAIT_FAILED)
+                break;
+            flags = 0;
+        }
+
+        glDeleteSync(fence);
+        fence = nullptr;
+    }
+
+} // namespace Voltray::Engine
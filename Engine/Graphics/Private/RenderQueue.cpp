@@ -0,0 +1,91 @@
+#include "RenderQueue.h"
+#include <algorithm>
+
+namespace Voltray::Engine
+{
+
+    namespace
+    {
+        constexpr int RADIX_BITS = 8;
+        constexpr int RADIX_BUCKETS = 1 << RADIX_BITS;
+        constexpr int RADIX_PASSES = 64 / RADIX_BITS;
+
+        // Below this size a comparison sort is faster than building histograms
+        constexpr std::size_t RADIX_THRESHOLD = 64;
+
+        constexpr std::uint64_t FieldMask(int bits)
+        {
+            return (std::uint64_t(1) << bits) - 1;
+        }
+    }
+
+    std::uint64_t RenderQueue::MakeKey(std::uint32_t shader, std::uint32_t vertexArray, std::uint32_t material, std::uint32_t depth)
+    {
+        return ((shader & FieldMask(SHADER_BITS)) << (VERTEX_ARRAY_BITS + MATERIAL_BITS + DEPTH_BITS)) |
+               ((vertexArray & FieldMask(VERTEX_ARRAY_BITS)) << (MATERIAL_BITS + DEPTH_BITS)) |
+               ((material & FieldMask(MATERIAL_BITS)) << DEPTH_BITS) |
+               (depth & FieldMask(DEPTH_BITS));
+    }
+
+    std::uint32_t RenderQueue::QuantizeDepth(float depth, float nearPlane, float farPlane)
+    {
+        if (!(farPlane > nearPlane))
+            return 0;
+
+        float normalized = std::clamp((depth - nearPlane) / (farPlane - nearPlane), 0.0f, 1.0f);
+        return static_cast<std::uint32_t>(normalized * static_cast<float>(FieldMask(DEPTH_BITS)));
+    }
+
+    void RenderQueue::Sort()
+    {
+        const std::size_t count = m_Items.size();
+        if (count < RADIX_THRESHOLD)
+        {
+            std::stable_sort(m_Items.begin(), m_Items.end(),
+                             [](const RenderItem &a, const RenderItem &b)
+                             { return a.key < b.key; });
+            return;
+        }
+
+        // Histograms for every byte in one pass over the keys
+        std::size_t histograms[RADIX_PASSES][RADIX_BUCKETS] = {};
+        for (const RenderItem &item : m_Items)
+        {
+            for (int pass = 0; pass < RADIX_PASSES; ++pass)
+                ++histograms[pass][(item.key >> (pass * RADIX_BITS)) & (RADIX_BUCKETS - 1)];
+        }
+
+        m_Scratch.resize(count);
+        RenderItem *source = m_Items.data();
+        RenderItem *destination = m_Scratch.data();
+
+        for (int pass = 0; pass < RADIX_PASSES; ++pass)
+        {
+            std::size_t *histogram = histograms[pass];
+            const int shift = pass * RADIX_BITS;
+
+            // Every key has the same byte here, so this pass would not move anything
+            if (histogram[(source[0].key >> shift) & (RADIX_BUCKETS - 1)] == count)
+                continue;
+
+            std::size_t offset = 0;
+            for (int bucket = 0; bucket < RADIX_BUCKETS; ++bucket)
+            {
+                std::size_t bucketCount = histogram[bucket];
+                histogram[bucket] = offset;
+                offset += bucketCount;
+            }
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const RenderItem &item = source[i];
+                destination[histogram[(item.key >> shift) & (RADIX_BUCKETS - 1)]++] = item;
+            }
+            std::swap(source, destination);
+        }
+
+        if (source != m_Items.data())
+            std::copy(source, source + count, m_Items.data());
+    }
+
+} // namespace Voltray::Engine
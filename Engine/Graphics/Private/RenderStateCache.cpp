@@ -0,0 +1,54 @@
+#include "RenderStateCache.h"
+
+namespace Voltray::Engine
+{
+
+    void RenderStateCache::UseProgram(GLuint program)
+    {
+        if (m_ProgramValid && m_Program == program)
+        {
+            ++m_Stats.programSkips;
+            return;
+        }
+
+        glUseProgram(program);
+        m_Program = program;
+        m_ProgramValid = true;
+        ++m_Stats.programChanges;
+    }
+
+    void RenderStateCache::BindVertexArray(GLuint vertexArray)
+    {
+        if (m_VertexArrayValid && m_VertexArray == vertexArray)
+        {
+            ++m_Stats.vertexArraySkips;
+            return;
+        }
+
+        glBindVertexArray(vertexArray);
+        m_VertexArray = vertexArray;
+        m_VertexArrayValid = true;
+        ++m_Stats.vertexArrayChanges;
+    }
+
+    void RenderStateCache::DrawElements(GLsizei indexCount)
+    {
+        glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, nullptr);
+        ++m_Stats.drawCalls;
+        ++m_Stats.instances;
+    }
+
+    void RenderStateCache::DrawElementsInstanced(GLsizei indexCount, GLsizei instanceCount, GLuint baseInstance)
+    {
+        glDrawElementsInstancedBaseInstance(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, nullptr, instanceCount, baseInstance);
+        ++m_Stats.drawCalls;
+        m_Stats.instances += static_cast<std::size_t>(instanceCount);
+    }
+
+    void RenderStateCache::Invalidate()
+    {
+        m_ProgramValid = false;
+        m_VertexArrayValid = false;
+    }
+
+} // namespace Voltray::Engine
@@ -5,15 +5,9 @@ namespace Voltray::Engine
 
     void Renderer::Draw(const Mesh &mesh, const Shader &shader) const
     {
-        shader.Bind();
-        mesh.Draw();
-    }
-
-    void Renderer::Draw(const Mesh &mesh, const Shader &shader, const Voltray::Math::Mat4 &modelMatrix) const
-    {
-        shader.Bind();
-        shader.SetUniformMat4("u_Model", modelMatrix.data);
-        mesh.Draw();
+        m_StateCache.UseProgram(shader.GetID());
+        m_StateCache.BindVertexArray(mesh.GetVertexArrayID());
+        m_StateCache.DrawElements(mesh.GetIndexCount());
     }
 
 } // namespace Voltray::Engine
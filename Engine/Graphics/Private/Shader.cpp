@@ -2,6 +2,8 @@
 #include <sstream>
 #include <iostream>
 #include <stdexcept>
+#include <algorithm>
+#include <string_view>
 #include <glad/gl.h>
 
 #include "Shader.h"
@@ -28,6 +30,8 @@ namespace Voltray::Engine
         {
             throw std::runtime_error("Failed to create shader program from: " + vertexPath + " and " + fragmentPath);
         }
+
+        ReflectUniforms();
     }
 
     Shader::~Shader()
@@ -129,34 +133,127 @@ namespace Voltray::Engine
         return program;
     }
 
-    int Shader::GetUniformLocation(const std::string &name) const
+    void Shader::ReflectUniforms()
+    {
+        m_Uniforms.clear();
+
+        GLint uniformCount = 0;
+        GLint maxNameLength = 0;
+        glGetProgramiv(m_RendererID, GL_ACTIVE_UNIFORMS, &uniformCount);
+        glGetProgramiv(m_RendererID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+
+        std::string name(static_cast<size_t>(std::max(maxNameLength, 1)), '\0');
+        for (GLint i = 0; i < uniformCount; ++i)
+        {
+            GLsizei length = 0;
+            GLint size = 0;
+            GLenum type = 0;
+            glGetActiveUniform(m_RendererID, static_cast<GLuint>(i), maxNameLength, &length, &size, &type, name.data());
+
+            // Members of uniform blocks have no location and are set through buffers
+            std::string_view uniformName(name.data(), static_cast<size_t>(length));
+            int location = glGetUniformLocation(m_RendererID, name.c_str());
+            if (location < 0)
+                continue;
+
+            m_Uniforms.push_back({HashUniformName(uniformName), location});
+
+            // Arrays are reported as "name[0]"; make the plain name resolve too
+            if (uniformName.size() > 3 && uniformName.substr(uniformName.size() - 3) == "[0]")
+            {
+                m_Uniforms.push_back({HashUniformName(uniformName.substr(0, uniformName.size() - 3)), location});
+            }
+        }
+
+        std::sort(m_Uniforms.begin(), m_Uniforms.end(),
+                  [](const UniformEntry &a, const UniformEntry &b)
+                  { return a.hash < b.hash; });
+        for (size_t i = 1; i < m_Uniforms.size(); ++i)
+        {
+            if (m_Uniforms[i].hash == m_Uniforms[i - 1].hash)
+                std::cerr << "Warning: two uniforms of program " << m_RendererID << " share a name hash\n";
+        }
+    }
+
+    int Shader::GetUniformLocation(UniformName name) const
     {
-        if (m_UniformLocationCache.find(name) != m_UniformLocationCache.end())
-            return m_UniformLocationCache[name];
+        auto it = std::lower_bound(m_Uniforms.begin(), m_Uniforms.end(), name.hash,
+                                   [](const UniformEntry &entry, std::uint32_t hash)
+                                   { return entry.hash < hash; });
+        if (it != m_Uniforms.end() && it->hash == name.hash)
+            return it->location;
 
-        int location = glGetUniformLocation(m_RendererID, name.c_str());
-        if (location == -1)
+        if (m_ReportedUniforms.insert(name.hash).second)
         {
-            std::cerr << "Warning: uniform '" << name << "' doesn't exist or wasn't used!\n";
+            std::cerr << "Warning: uniform '" << name.name << "' doesn't exist or wasn't used!\n";
         }
+        return -1;
+    }
 
-        m_UniformLocationCache[name] = location;
-        return location;
+    UniformHandle Shader::GetUniformHandle(UniformName name) const
+    {
+        return UniformHandle{GetUniformLocation(name)};
     }
 
-    void Shader::SetUniformMat4(const std::string &name, const float *matrix) const
+    void Shader::SetUniformMat4(UniformName name, const float *matrix) const
     {
         glUniformMatrix4fv(GetUniformLocation(name), 1, GL_FALSE, matrix);
     }
 
-    void Shader::SetUniform3f(const std::string &name, float x, float y, float z) const
+    void Shader::SetUniform3f(UniformName name, float x, float y, float z) const
     {
         glUniform3f(GetUniformLocation(name), x, y, z);
     }
 
-    void Shader::SetUniform1f(const std::string &name, float value) const
+    void Shader::SetUniform1f(UniformName name, float value) const
     {
         glUniform1f(GetUniformLocation(name), value);
     }
 
+    void Shader::Set(UniformHandle handle, const Voltray::Math::Mat4 &value) const
+    {
+        glUniformMatrix4fv(handle.location, 1, GL_FALSE, value.data);
+    }
+
+    void Shader::Set(UniformHandle handle, const Voltray::Math::Vec3 &value) const
+    {
+        glUniform3f(handle.location, value.x, value.y, value.z);
+    }
+
+    void Shader::Set(UniformHandle handle, float value) const
+    {
+        glUniform1f(handle.location, value);
+    }
+
+    void Shader::Set(UniformHandle handle, int value) const
+    {
+        glUniform1i(handle.location, value);
+    }
+
+    bool Shader::BindUniformBlock(const std::string &blockName, unsigned int binding) const
+    {
+        unsigned int index = glGetUniformBlockIndex(m_RendererID, blockName.c_str());
+        if (index == GL_INVALID_INDEX)
+        {
+            std::cerr << "Warning: uniform block '" << blockName << "' doesn't exist or wasn't used!\n";
+            return false;
+        }
+
+        glUniformBlockBinding(m_RendererID, index, binding);
+        return true;
+    }
+
+    bool Shader::BindStorageBlock(const std::string &blockName, unsigned int binding) const
+    {
+        unsigned int index = glGetProgramResourceIndex(m_RendererID, GL_SHADER_STORAGE_BLOCK, blockName.c_str());
+        if (index == GL_INVALID_INDEX)
+        {
+            std::cerr << "Warning: storage block '" << blockName << "' doesn't exist or wasn't used!\n";
+            return false;
+        }
+
+        glShaderStorageBlockBinding(m_RendererID, index, binding);
+        return true;
+    }
+
 } // namespace Voltray::Engine
\ No newline at end of file
@@ -0,0 +1,32 @@
+#include "UniformBuffer.h"
+
+namespace Voltray::Engine
+{
+
+    UniformBuffer::UniformBuffer(std::size_t size)
+        : m_Size(size)
+    {
+        glGenBuffers(1, &m_ID);
+        glBindBuffer(GL_UNIFORM_BUFFER, m_ID);
+        glBufferData(GL_UNIFORM_BUFFER, static_cast<GLsizeiptr>(size), nullptr, GL_DYNAMIC_DRAW);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    }
+
+    UniformBuffer::~UniformBuffer()
+    {
+        glDeleteBuffers(1, &m_ID);
+    }
+
+    void UniformBuffer::SetData(const void *data, std::size_t size, std::size_t offset)
+    {
+        glBindBuffer(GL_UNIFORM_BUFFER, m_ID);
+        glBufferSubData(GL_UNIFORM_BUFFER, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), data);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    }
+
+    void UniformBuffer::BindBase(GLuint binding) const
+    {
+        glBindBufferBase(GL_UNIFORM_BUFFER, binding, m_ID);
+    }
+
+} // namespace Voltray::Engine
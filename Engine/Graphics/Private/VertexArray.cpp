@@ -1,4 +1,5 @@
 #include "VertexArray.h"
+#include <cstdint>
 
 namespace Voltray::Engine
 {
@@ -30,4 +31,44 @@ namespace Voltray::Engine
         glEnableVertexAttribArray(index);
     }
 
+    void VertexArray::AddVertexLayout(const VertexLayout &layout)
+    {
+        for (const VertexElement &element : layout.GetElements())
+        {
+            GLenum type = GL_FLOAT;
+            GLboolean normalized = GL_FALSE;
+            switch (element.format)
+            {
+            case VertexFormat::Half2:
+            case VertexFormat::Half4:
+                type = GL_HALF_FLOAT;
+                break;
+            case VertexFormat::UNorm8x4:
+                type = GL_UNSIGNED_BYTE;
+                normalized = GL_TRUE;
+                break;
+            case VertexFormat::UInt8x4:
+                type = GL_UNSIGNED_BYTE;
+                break;
+            case VertexFormat::UNorm16x2:
+            case VertexFormat::UNorm16x4:
+                type = GL_UNSIGNED_SHORT;
+                normalized = GL_TRUE;
+                break;
+            case VertexFormat::SNorm16x2:
+            case VertexFormat::SNorm16x4:
+            case VertexFormat::Octahedral16:
+                type = GL_SHORT;
+                normalized = GL_TRUE;
+                break;
+            default:
+                break;
+            }
+
+            AddVertexAttribute(static_cast<GLuint>(element.attribute), static_cast<GLint>(VertexLayout::GetComponentCount(element.format)),
+                               type, normalized, static_cast<GLsizei>(layout.GetStride()),
+                               reinterpret_cast<const void *>(static_cast<std::uintptr_t>(element.offset)));
+        }
+    }
+
 } // namespace Voltray::Engine
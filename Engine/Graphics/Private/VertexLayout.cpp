@@ -0,0 +1,255 @@
+#include "VertexLayout.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace Voltray::Engine
+{
+    namespace
+    {
+        struct FormatInfo
+        {
+            unsigned int size;
+            unsigned int components;
+        };
+
+        constexpr FormatInfo FORMAT_INFO[] = {
+            {4, 1},  // Float1
+            {8, 2},  // Float2
+            {12, 3}, // Float3
+            {16, 4}, // Float4
+            {4, 2},  // Half2
+            {8, 4},  // Half4
+            {4, 4},  // UNorm8x4
+            {4, 4},  // UInt8x4
+            {4, 2},  // UNorm16x2
+            {8, 4},  // UNorm16x4
+            {4, 2},  // SNorm16x2
+            {8, 4},  // SNorm16x4
+            {4, 2},  // Octahedral16
+        };
+        static_assert(sizeof(FORMAT_INFO) / sizeof(FORMAT_INFO[0]) == static_cast<std::size_t>(VertexFormat::Count),
+                      "Every vertex format needs its size and component count");
+
+        bool IsIdentity(const Voltray::Math::Vec3 &offset, const Voltray::Math::Vec3 &scale)
+        {
+            return offset.x == 0.0f && offset.y == 0.0f && offset.z == 0.0f && scale.x == 1.0f && scale.y == 1.0f && scale.z == 1.0f;
+        }
+
+        float HalfToFloat(std::uint16_t half)
+        {
+            const std::uint32_t sign = std::uint32_t(half & 0x8000) << 16;
+            const std::uint32_t exponent = (half >> 10) & 0x1F;
+            std::uint32_t mantissa = half & 0x3FF;
+
+            std::uint32_t bits;
+            if (exponent == 0x1F)
+            {
+                bits = sign | 0x7F800000 | (mantissa << 13);
+            }
+            else if (exponent != 0)
+            {
+                bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+            }
+            else if (mantissa != 0)
+            {
+                // Subnormal half, renormalize into a normal float
+                std::uint32_t shift = 0;
+                while (!(mantissa & 0x400))
+                {
+                    mantissa <<= 1;
+                    ++shift;
+                }
+                bits = sign | ((113 - shift) << 23) | ((mantissa & 0x3FF) << 13);
+            }
+            else
+            {
+                bits = sign;
+            }
+
+            float value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+    }
+
+    const VertexLayout &VertexLayout::Standard()
+    {
+        static const VertexLayout layout = VertexLayout()
+                                               .Add(VertexAttribute::Position, VertexFormat::Float3)
+                                               .Add(VertexAttribute::Normal, VertexFormat::Float3)
+                                               .Add(VertexAttribute::TexCoord, VertexFormat::Float2);
+        return layout;
+    }
+
+    const VertexLayout &VertexLayout::PositionOnly()
+    {
+        static const VertexLayout layout = VertexLayout().Add(VertexAttribute::Position, VertexFormat::Float3);
+        return layout;
+    }
+
+    VertexLayout &VertexLayout::Add(VertexAttribute attribute, VertexFormat format)
+    {
+        if (attribute >= VertexAttribute::Count || format >= VertexFormat::Count)
+            throw std::invalid_argument("unknown vertex attribute or format");
+        if (Find(attribute))
+            throw std::invalid_argument("vertex attribute added twice");
+
+        m_Elements.push_back({attribute, format, static_cast<std::uint16_t>(m_Stride)});
+        m_Stride += GetFormatSize(format);
+        return *this;
+    }
+
+    const VertexElement *VertexLayout::Find(VertexAttribute attribute) const
+    {
+        for (const VertexElement &element : m_Elements)
+        {
+            if (element.attribute == attribute)
+                return &element;
+        }
+        return nullptr;
+    }
+
+    std::size_t VertexLayout::GetVertexCount(const std::vector<float> &vertices) const
+    {
+        return m_Stride ? vertices.size() / GetFloatStride() : 0;
+    }
+
+    bool VertexLayout::HasInPlacePositions() const
+    {
+        const VertexElement *position = Find(VertexAttribute::Position);
+        return position && position->format == VertexFormat::Float3 && position->offset == 0 &&
+               IsIdentity(m_PositionOffset, m_PositionScale);
+    }
+
+    void VertexLayout::SetPositionDecode(const Voltray::Math::Vec3 &offset, const Voltray::Math::Vec3 &scale)
+    {
+        m_PositionOffset = offset;
+        m_PositionScale = scale;
+    }
+
+    Voltray::Math::Mat4 VertexLayout::GetPositionDecodeMatrix() const
+    {
+        if (IsIdentity(m_PositionOffset, m_PositionScale))
+            return Voltray::Math::Mat4();
+        return Voltray::Math::Mat4::Scale(m_PositionScale) * Voltray::Math::Mat4::Translate(m_PositionOffset);
+    }
+
+    bool VertexLayout::HasOctahedralNormals() const
+    {
+        const VertexElement *normal = Find(VertexAttribute::Normal);
+        return normal && normal->format == VertexFormat::Octahedral16;
+    }
+
+    Voltray::Math::Vec3 VertexLayout::ReadPosition(const float *vertex) const
+    {
+        const VertexElement *position = Find(VertexAttribute::Position);
+        if (!position)
+            return Voltray::Math::Vec3(0.0f, 0.0f, 0.0f);
+
+        float value[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        Decode(position->format, reinterpret_cast<const unsigned char *>(vertex) + position->offset, value);
+        return Voltray::Math::Vec3(m_PositionOffset.x + value[0] * m_PositionScale.x,
+                                   m_PositionOffset.y + value[1] * m_PositionScale.y,
+                                   m_PositionOffset.z + value[2] * m_PositionScale.z);
+    }
+
+    void VertexLayout::Decode(VertexFormat format, const void *data, float *output)
+    {
+        const unsigned int components = GetComponentCount(format);
+        switch (format)
+        {
+        case VertexFormat::Float1:
+        case VertexFormat::Float2:
+        case VertexFormat::Float3:
+        case VertexFormat::Float4:
+            std::memcpy(output, data, components * sizeof(float));
+            break;
+        case VertexFormat::Half2:
+        case VertexFormat::Half4:
+        {
+            std::uint16_t values[4];
+            std::memcpy(values, data, components * sizeof(std::uint16_t));
+            for (unsigned int i = 0; i < components; ++i)
+                output[i] = HalfToFloat(values[i]);
+            break;
+        }
+        case VertexFormat::UNorm8x4:
+        case VertexFormat::UInt8x4:
+        {
+            const float scale = format == VertexFormat::UNorm8x4 ? 1.0f / 255.0f : 1.0f;
+            const unsigned char *values = static_cast<const unsigned char *>(data);
+            for (unsigned int i = 0; i < 4; ++i)
+                output[i] = values[i] * scale;
+            break;
+        }
+        case VertexFormat::UNorm16x2:
+        case VertexFormat::UNorm16x4:
+        {
+            std::uint16_t values[4];
+            std::memcpy(values, data, components * sizeof(std::uint16_t));
+            for (unsigned int i = 0; i < components; ++i)
+                output[i] = values[i] * (1.0f / 65535.0f);
+            break;
+        }
+        case VertexFormat::SNorm16x2:
+        case VertexFormat::SNorm16x4:
+        {
+            std::int16_t values[4];
+            std::memcpy(values, data, components * sizeof(std::int16_t));
+            for (unsigned int i = 0; i < components; ++i)
+            {
+                // OpenGL 4.2+ conversion: -32768 and -32767 both map to -1
+                const float value = values[i] * (1.0f / 32767.0f);
+                output[i] = value < -1.0f ? -1.0f : value;
+            }
+            break;
+        }
+        case VertexFormat::Octahedral16:
+        {
+            float folded[2];
+            Decode(VertexFormat::SNorm16x2, data, folded);
+
+            // Unfold the lower hemisphere, then normalize, as default.vert does
+            float x = folded[0], y = folded[1];
+            const float z = 1.0f - std::fabs(x) - std::fabs(y);
+            const float t = std::max(-z, 0.0f);
+            x += x >= 0.0f ? -t : t;
+            y += y >= 0.0f ? -t : t;
+            const float length = std::sqrt(x * x + y * y + z * z);
+            output[0] = x / length;
+            output[1] = y / length;
+            output[2] = z / length;
+            break;
+        }
+        default:
+            break;
+        }
+    }
+
+    unsigned int VertexLayout::GetFormatSize(VertexFormat format)
+    {
+        return FORMAT_INFO[static_cast<std::size_t>(format)].size;
+    }
+
+    unsigned int VertexLayout::GetComponentCount(VertexFormat format)
+    {
+        return FORMAT_INFO[static_cast<std::size_t>(format)].components;
+    }
+
+    bool VertexLayout::operator==(const VertexLayout &other) const
+    {
+        if (m_Stride != other.m_Stride || m_Elements.size() != other.m_Elements.size())
+            return false;
+
+        for (std::size_t i = 0; i < m_Elements.size(); ++i)
+        {
+            if (m_Elements[i].attribute != other.m_Elements[i].attribute || m_Elements[i].format != other.m_Elements[i].format)
+                return false;
+        }
+        return m_PositionOffset.x == other.m_PositionOffset.x && m_PositionOffset.y == other.m_PositionOffset.y &&
+               m_PositionOffset.z == other.m_PositionOffset.z && m_PositionScale.x == other.m_PositionScale.x &&
+               m_PositionScale.y == other.m_PositionScale.y && m_PositionScale.z == other.m_PositionScale.z;
+    }
+}
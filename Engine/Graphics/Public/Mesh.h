@@ -3,7 +3,10 @@
 #include "VertexArray.h"
 #include "VertexBuffer.h"
 #include "IndexBuffer.h"
+#include "VertexLayout.h"
+#include "BVH.h"
 #include "Vec3.h"
+#include <memory>
 #include <vector>
 
 namespace Voltray::Engine
@@ -25,15 +28,19 @@ namespace Voltray::Engine
          * @param vSize Total size of the vertex data array in bytes.
          * @param indices Pointer to the array of indices that define the triangles.
          * @param iCount Total number of indices.
+         * @param layout Layout of the vertex data.
          */
-        Mesh(float *vertices, unsigned int vSize, unsigned int *indices, unsigned int iCount);
+        Mesh(float *vertices, unsigned int vSize, unsigned int *indices, unsigned int iCount,
+             const VertexLayout &layout = VertexLayout::PositionOnly());
 
         /**
          * @brief Constructs a Mesh object from C++ std::vector containers.
          * @param vertices A constant reference to a vector of floats representing vertex data.
          * @param indices A constant reference to a vector of unsigned integers representing index data.
+         * @param layout Layout of the vertex data.
          */
-        Mesh(const std::vector<float> &vertices, const std::vector<unsigned int> &indices);
+        Mesh(const std::vector<float> &vertices, const std::vector<unsigned int> &indices,
+             const VertexLayout &layout = VertexLayout::Standard());
 
         /**
          * @brief Destroys the Mesh object.
@@ -48,7 +55,21 @@ namespace Voltray::Engine
                             * This method binds the associated Vertex Array Object and issues a draw call
                             * using the Index Buffer Object.
                             */
-        void Draw() const; /**
+        void Draw() const;
+
+        /**
+         * @brief Gets the OpenGL vertex array name, e.g. for sort keys and state caching.
+         * @return The vertex array id.
+         */
+        GLuint GetVertexArrayID() const { return m_VAO.GetID(); }
+
+        /**
+         * @brief Gets the number of indices drawn by the mesh.
+         * @return The index count.
+         */
+        unsigned int GetIndexCount() const { return m_IBO.GetCount(); }
+
+        /**
                             * @brief Gets the axis-aligned bounding box of the mesh.
                             * @param minBounds Output minimum bounds of the mesh.
                             * @param maxBounds Output maximum bounds of the mesh.
@@ -73,15 +94,48 @@ namespace Voltray::Engine
          */
         const std::vector<unsigned int> &GetIndices() const { return m_Indices; }
 
+        /**
+         * @brief Gets the layout of the vertex data.
+         * @return Const reference to the vertex layout.
+         */
+        const VertexLayout &GetLayout() const { return m_Layout; }
+
+        /**
+         * @brief Gets float xyz positions for CPU-side geometry queries such as bounds and picking.
+         *
+         * This is the vertex data itself when the layout stores float positions first, and a
+         * decoded copy, made on first access, otherwise.
+         * @return Const reference to positions spaced GetPositionStride() floats apart.
+         */
+        const std::vector<float> &GetPositions() const;
+
+        /**
+         * @brief Gets the spacing of the positions returned by GetPositions().
+         * @return Number of floats per vertex.
+         */
+        unsigned int GetPositionStride() const;
+
+        /**
+         * @brief Gets the triangle BVH used to accelerate ray intersection tests.
+         *
+         * The hierarchy is built on first access and cached for the lifetime of the mesh.
+         * @return Const reference to the mesh BVH.
+         */
+        const Voltray::Math::BVH &GetBVH() const;
+
     private:
         VertexArray m_VAO;                   ///< Vertex Array Object managing the vertex attribute configurations.
         VertexBuffer m_VBO;                  ///< Vertex Buffer Object storing the vertex data.
         IndexBuffer m_IBO;                   ///< Index Buffer Object storing the index data.    std::vector<float> m_Vertices;           ///< Copy of vertex data for bounds calculation
         std::vector<float> m_Vertices;       ///< Copy of vertex data for bounds calculation
         std::vector<unsigned int> m_Indices; ///< Copy of index data for intersection testing
+        VertexLayout m_Layout;               ///< Attributes of m_Vertices
+
+        mutable std::vector<float> m_Positions;               ///< Decoded positions, for layouts without in-place float positions
 
         mutable Voltray::Math::Vec3 m_MinBounds, m_MaxBounds; ///< Cached bounding box
         mutable bool m_BoundsCalculated = false;              ///< Whether bounds have been calculated
+        mutable std::unique_ptr<Voltray::Math::BVH> m_BVH;    ///< Lazily built triangle hierarchy for picking
     };
 
 }
\ No newline at end of file
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <glad/gl.h>
+#include <cstddef>
+
+namespace Voltray::Engine
+{
+
+    /**
+     * @class PersistentRingBuffer
+     * @brief Persistently mapped buffer split into per-frame segments.
+     *
+     * The CPU writes the current segment through a pointer that stays mapped for the lifetime
+     * of the storage, while the GPU may still be reading the segments of earlier frames. Each
+     * segment is guarded by a fence, so a segment is only reused once the draws that read it
+     * have completed. Writing never orphans or re-specifies the buffer.
+     *
+     * Usage per frame: BeginSegment, fill the returned memory, BindSegment, draw, EndSegment.
+     */
+    class PersistentRingBuffer
+    {
+    public:
+        static constexpr int SEGMENT_COUNT = 3; ///< Frames that may be in flight at once
+
+        /**
+         * @brief Creates an empty ring; storage is allocated by the first BeginSegment.
+         * @param target GL_SHADER_STORAGE_BUFFER or GL_UNIFORM_BUFFER.
+         */
+        explicit PersistentRingBuffer(GLenum target);
+        ~PersistentRingBuffer();
+
+        PersistentRingBuffer(const PersistentRingBuffer &) = delete;
+        PersistentRingBuffer &operator=(const PersistentRingBuffer &) = delete;
+
+        /**
+         * @brief Advances to the next segment and returns memory to write into.
+         *
+         * Waits for the GPU if the segment is still in use. Storage grows when size exceeds
+         * the segment capacity; this waits for all segments.
+         * @param size Number of bytes the caller will write.
+         * @return Write-only pointer to the segment, valid until EndSegment.
+         */
+        void *BeginSegment(std::size_t size);
+
+        /**
+         * @brief Binds the current segment to an indexed binding point of the target.
+         * @param binding Binding point shared with the shader block.
+         */
+        void BindSegment(GLuint binding) const;
+
+        /**
+         * @brief Fences the current segment. Call after the draws that read it were issued.
+         */
+        void EndSegment();
+
+        std::size_t GetSegmentCapacity() const { return m_SegmentSize; }
+
+    private:
+        void Allocate(std::size_t segmentSize);
+        void Release();
+        void WaitForSegment(int segment);
+
+        GLenum m_Target;
+        GLuint m_ID = 0;
+        unsigned char *m_Mapped = nullptr;
+        std::size_t m_SegmentSize = 0;
+        std::size_t m_Alignment = 1;
+        std::size_t m_UsedSize = 0;
+        int m_Current = 0;
+        GLsync m_Fences[SEGMENT_COUNT] = {};
+    };
+
+} // namespace Voltray::Engine
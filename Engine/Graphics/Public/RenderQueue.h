@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Voltray::Engine
+{
+
+    /**
+     * @brief A queued draw: a sort key and the caller's index of the thing to draw.
+     */
+    struct RenderItem
+    {
+        std::uint64_t key;
+        std::uint32_t index;
+    };
+
+    /**
+     * @class RenderQueue
+     * @brief Collects draws for a frame and orders them to minimise GL state changes.
+     *
+     * Each draw is tagged with a 64-bit key whose fields, from most to least significant, are
+     * shader program, vertex array, material and depth:
+     *
+     *     | shader (12) | vertex array (20) | material (16) | depth (16) |
+     *
+     * Sorting the keys therefore groups draws by program, then by mesh, then by material,
+     * and orders each group front to back. Fields are masked, so ids that do not fit only make
+     * the grouping less perfect; the state cache still checks real GL names.
+     *
+     * Keys are sorted with an LSD radix sort (8 bits per pass). Passes in which every key has
+     * the same byte are skipped, which is the common case for the upper fields.
+     */
+    class RenderQueue
+    {
+    public:
+        static constexpr int SHADER_BITS = 12;
+        static constexpr int VERTEX_ARRAY_BITS = 20;
+        static constexpr int MATERIAL_BITS = 16;
+        static constexpr int DEPTH_BITS = 16;
+
+        /**
+         * @brief Packs the sort key fields.
+         * @param shader Shader program id.
+         * @param vertexArray Vertex array id.
+         * @param material Material id (e.g. a packed color).
+         * @param depth Quantized view depth, see QuantizeDepth.
+         * @return The 64-bit sort key.
+         */
+        static std::uint64_t MakeKey(std::uint32_t shader, std::uint32_t vertexArray, std::uint32_t material, std::uint32_t depth);
+
+        /**
+         * @brief Maps a view depth between the near and far planes to the depth field.
+         * @param depth Distance along the view direction.
+         * @param nearPlane Camera near plane distance.
+         * @param farPlane Camera far plane distance.
+         * @return Quantized depth, 0 at the near plane.
+         */
+        static std::uint32_t QuantizeDepth(float depth, float nearPlane, float farPlane);
+
+        /**
+         * @brief Removes all queued draws, keeping the allocated storage.
+         */
+        void Clear() { m_Items.clear(); }
+
+        /**
+         * @brief Queues a draw.
+         * @param key Sort key from MakeKey.
+         * @param index Caller-defined index identifying what to draw.
+         */
+        void Submit(std::uint64_t key, std::uint32_t index) { m_Items.push_back({key, index}); }
+
+        /**
+         * @brief Sorts the queued draws by key. Draws with equal keys keep submission order.
+         */
+        void Sort();
+
+        const std::vector<RenderItem> &GetItems() const { return m_Items; }
+        std::size_t GetSize() const { return m_Items.size(); }
+        bool IsEmpty() const { return m_Items.empty(); }
+
+    private:
+        std::vector<RenderItem> m_Items;
+        std::vector<RenderItem> m_Scratch;
+    };
+
+} // namespace Voltray::Engine
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <glad/gl.h>
+#include <cstddef>
+
+namespace Voltray::Engine
+{
+
+    /**
+     * @class RenderStateCache
+     * @brief Thin shadow of the GL binding state that drops redundant binds.
+     *
+     * Only binds made through the cache are tracked. Code that binds programs or vertex
+     * arrays directly must call Invalidate afterwards so the next bind is not skipped.
+     */
+    class RenderStateCache
+    {
+    public:
+        /**
+         * @brief Counters since the last ResetStats call.
+         */
+        struct Stats
+        {
+            std::size_t programChanges = 0;     ///< glUseProgram calls issued
+            std::size_t programSkips = 0;       ///< glUseProgram calls avoided
+            std::size_t vertexArrayChanges = 0; ///< glBindVertexArray calls issued
+            std::size_t vertexArraySkips = 0;   ///< glBindVertexArray calls avoided
+            std::size_t drawCalls = 0;          ///< Draw calls issued
+            std::size_t instances = 0;          ///< Instances drawn (1 per non-instanced draw)
+        };
+
+        /**
+         * @brief Makes a program current unless it already is.
+         * @param program GL program name.
+         */
+        void UseProgram(GLuint program);
+
+        /**
+         * @brief Binds a vertex array unless it is already bound.
+         * @param vertexArray GL vertex array name.
+         */
+        void BindVertexArray(GLuint vertexArray);
+
+        /**
+         * @brief Draws indexed triangles from the bound vertex array.
+         * @param indexCount Number of indices.
+         */
+        void DrawElements(GLsizei indexCount);
+
+        /**
+         * @brief Draws instanced indexed triangles from the bound vertex array.
+         * @param indexCount Number of indices per instance.
+         * @param instanceCount Number of instances.
+         * @param baseInstance Offset added to the instance index for per-instance attributes.
+         */
+        void DrawElementsInstanced(GLsizei indexCount, GLsizei instanceCount, GLuint baseInstance);
+
+        /**
+         * @brief Forgets the tracked bindings so the next binds always reach GL.
+         */
+        void Invalidate();
+
+        void ResetStats() { m_Stats = Stats(); }
+        const Stats &GetStats() const { return m_Stats; }
+
+    private:
+        GLuint m_Program = 0;
+        GLuint m_VertexArray = 0;
+        bool m_ProgramValid = false;
+        bool m_VertexArrayValid = false;
+        Stats m_Stats;
+    };
+
+} // namespace Voltray::Engine
@@ -2,7 +2,7 @@
 
 #include "Shader.h"
 #include "Mesh.h"
-#include "Mat4.h"
+#include "RenderStateCache.h"
 
 namespace Voltray::Engine
 {
@@ -14,6 +14,8 @@ namespace Voltray::Engine
      * The Renderer class provides functionality to draw mesh objects
      * with a given shader. It encapsulates the rendering logic and
      * serves as an interface for graphics rendering operations.
+     * Program and vertex array binds go through a RenderStateCache, so
+     * consecutive draws that share state do not rebind it.
      *
      * @note This class assumes that the graphics context and resources
      *       (such as meshes and shaders) are properly initialized and managed.
@@ -24,12 +26,13 @@ namespace Voltray::Engine
         void Draw(const Mesh &mesh, const Shader &shader) const;
 
         /**
-         * @brief Draws a mesh with a specific model transformation matrix.
-         * @param mesh The mesh to draw.
-         * @param shader The shader to use for rendering.
-         * @param modelMatrix The model transformation matrix.
+         * @brief Gets the state cache used for all draws issued through this renderer.
+         * @return Reference to the state cache.
          */
-        void Draw(const Mesh &mesh, const Shader &shader, const Voltray::Math::Mat4 &modelMatrix) const;
+        RenderStateCache &GetStateCache() const { return m_StateCache; }
+
+    private:
+        mutable RenderStateCache m_StateCache;
     };
 
 } // namespace Voltray::Engine
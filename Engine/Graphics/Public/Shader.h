@@ -1,7 +1,12 @@
 #pragma once
 
+#include "UniformHandle.h"
+#include "Mat4.h"
+#include "Vec3.h"
+#include <cstdint>
 #include <string>
-#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace Voltray::Engine
 {
@@ -12,6 +17,10 @@ namespace Voltray::Engine
      *
      * The Shader class provides functionality to load, compile, and link vertex and fragment shaders,
      * as well as to bind and unbind the resulting shader program for rendering.
+     *
+     * Active uniforms are enumerated once after linking and stored by name hash. Hot paths
+     * should resolve a UniformHandle up front and use the Set overloads; the name-based
+     * setters hash the name on each call but never allocate.
      */
     class Shader
     {
@@ -21,18 +30,68 @@ namespace Voltray::Engine
         void Bind() const;
         void Unbind() const;
 
-        void SetUniformMat4(const std::string &name, const float *matrix) const;
-        void SetUniform3f(const std::string &name, float x, float y, float z) const;
-        void SetUniform1f(const std::string &name, float value) const;
+        /**
+         * @brief Gets the OpenGL program name.
+         * @return The program id.
+         */
+        unsigned int GetID() const { return m_RendererID; }
+
+        void SetUniformMat4(UniformName name, const float *matrix) const;
+        void SetUniform3f(UniformName name, float x, float y, float z) const;
+        void SetUniform1f(UniformName name, float value) const;
+
+        /**
+         * @brief Resolves a uniform name to a handle for the Set overloads.
+         * @param name Uniform name, ideally a constexpr UniformName.
+         * @return The handle; invalid if the program has no active uniform with that name.
+         */
+        UniformHandle GetUniformHandle(UniformName name) const;
+
+        /**
+         * @brief Sets a uniform of the bound program through a pre-resolved handle.
+         * @param handle Handle from GetUniformHandle of this shader.
+         * @param value Value to upload.
+         */
+        void Set(UniformHandle handle, const Voltray::Math::Mat4 &value) const;
+        void Set(UniformHandle handle, const Voltray::Math::Vec3 &value) const;
+        void Set(UniformHandle handle, float value) const;
+        void Set(UniformHandle handle, int value) const;
+
+        /**
+         * @brief Connects a uniform block of the program to a buffer binding point.
+         * @param blockName Name of the uniform block in GLSL.
+         * @param binding Binding point used with UniformBuffer::BindBase.
+         * @return False if the program has no active block with that name.
+         */
+        bool BindUniformBlock(const std::string &blockName, unsigned int binding) const;
+
+        /**
+         * @brief Connects a shader storage block of the program to a buffer binding point.
+         * @param blockName Name of the storage block in GLSL.
+         * @param binding Binding point used with glBindBufferBase / glBindBufferRange.
+         * @return False if the program has no active block with that name.
+         */
+        bool BindStorageBlock(const std::string &blockName, unsigned int binding) const;
 
     private:
         unsigned int m_RendererID;
-        mutable std::unordered_map<std::string, int> m_UniformLocationCache;
+        /**
+         * @brief Active uniform location keyed by name hash.
+         */
+        struct UniformEntry
+        {
+            std::uint32_t hash;
+            int location;
+        };
+
+        std::vector<UniformEntry> m_Uniforms;                         ///< Sorted by hash; programs have few uniforms
+        mutable std::unordered_set<std::uint32_t> m_ReportedUniforms; ///< Missing names already warned about
 
         std::string LoadShaderSource(const std::string &filepath);
         unsigned int CompileShader(unsigned int type, const std::string &source);
         unsigned int CreateShaderProgram(const std::string &vertexSource, const std::string &fragmentSource);
-        int GetUniformLocation(const std::string &name) const;
+        void ReflectUniforms();
+        int GetUniformLocation(UniformName name) const;
     };
 
 } // namespace Voltray::Engine
@@ -0,0 +1,43 @@
+#pragma once
+
+namespace Voltray::Engine
+{
+
+    /**
+     * @brief Per-frame camera data, mirrored by the std140 uniform block "FrameData".
+     *
+     * Uploaded once per frame into a UniformBuffer bound at BINDING, so shaders no longer
+     * need u_ViewProjection set on every program.
+     */
+    struct FrameData
+    {
+        static constexpr unsigned int BINDING = 0;
+        static constexpr const char *BLOCK_NAME = "FrameData";
+
+        float viewProjection[16];        ///< View-projection matrix, column-major
+        float inverseViewProjection[16]; ///< Inverse of viewProjection, used by the skybox
+        float cameraPosition[4];         ///< World space camera position (w unused)
+    };
+
+    /**
+     * @brief Per-object data, mirrored by the std430 storage block "ObjectData".
+     *
+     * One record per drawn object, written into a PersistentRingBuffer bound at BINDING.
+     * The vertex shader picks its record with gl_BaseInstance + gl_InstanceID, so the
+     * base instance of each draw is the index of its first object.
+     */
+    struct ObjectData
+    {
+        static constexpr unsigned int BINDING = 1;
+        static constexpr const char *BLOCK_NAME = "ObjectData";
+
+        float model[16];         ///< Model matrix, column-major (same layout as Mat4::data)
+        float materialColor[4];  ///< Material color (RGB, a unused)
+        float positionScale[4];  ///< Mesh position decode scale (xyz); w is 1 for octahedral normals
+        float positionOffset[4]; ///< Mesh position decode offset (xyz, w unused)
+    };
+
+    static_assert(sizeof(FrameData) == 144, "FrameData must match the std140 block layout");
+    static_assert(sizeof(ObjectData) == 112, "ObjectData must match the std430 block layout");
+
+} // namespace Voltray::Engine
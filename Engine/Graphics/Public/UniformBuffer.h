@@ -0,0 +1,50 @@
+#pragma once
+
+#include <glad/gl.h>
+#include <cstddef>
+
+namespace Voltray::Engine
+{
+
+    /**
+     * @class UniformBuffer
+     * @brief Owns a fixed-size OpenGL uniform buffer object.
+     *
+     * Meant for small blocks that change at most once per frame, such as FrameData.
+     */
+    class UniformBuffer
+    {
+    public:
+        /**
+         * @brief Creates the buffer.
+         * @param size Size of the buffer in bytes.
+         */
+        explicit UniformBuffer(std::size_t size);
+        ~UniformBuffer();
+
+        UniformBuffer(const UniformBuffer &) = delete;
+        UniformBuffer &operator=(const UniformBuffer &) = delete;
+
+        /**
+         * @brief Writes part of the buffer.
+         * @param data Source data.
+         * @param size Number of bytes to write.
+         * @param offset Byte offset into the buffer.
+         */
+        void SetData(const void *data, std::size_t size, std::size_t offset = 0);
+
+        /**
+         * @brief Binds the whole buffer to a uniform block binding point.
+         * @param binding Binding point shared with Shader::BindUniformBlock.
+         */
+        void BindBase(GLuint binding) const;
+
+        GLuint GetID() const { return m_ID; }
+        std::size_t GetSize() const { return m_Size; }
+
+    private:
+        GLuint m_ID;
+        std::size_t m_Size;
+    };
+
+} // namespace Voltray::Engine
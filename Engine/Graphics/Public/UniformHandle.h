@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace Voltray::Engine
+{
+
+    /**
+     * @brief Hashes a uniform name with 32-bit FNV-1a.
+     *
+     * constexpr so names known at compile time cost nothing at run time.
+     * @param name Uniform name as written in GLSL.
+     * @return The hash used to look the uniform up in a Shader.
+     */
+    constexpr std::uint32_t HashUniformName(std::string_view name)
+    {
+        std::uint32_t hash = 2166136261u;
+        for (char c : name)
+        {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    /**
+     * @brief A uniform name together with its precomputed hash.
+     *
+     * Converts implicitly from string literals, so existing call sites keep compiling. Declare
+     * names as constexpr constants to have the hash computed by the compiler:
+     *
+     *     constexpr UniformName MODEL_UNIFORM = "u_Model";
+     *
+     * The name is only viewed, never copied; it must outlive the call it is passed to.
+     */
+    struct UniformName
+    {
+        std::uint32_t hash;
+        std::string_view name;
+
+        constexpr UniformName(const char *text) : hash(HashUniformName(text)), name(text) {}
+        constexpr UniformName(std::string_view text) : hash(HashUniformName(text)), name(text) {}
+        UniformName(const std::string &text) : UniformName(std::string_view(text)) {}
+    };
+
+    /**
+     * @brief A uniform location resolved once from a Shader, see Shader::GetUniformHandle.
+     *
+     * Only valid for the shader that produced it. Setting an invalid handle is a no-op.
+     */
+    struct UniformHandle
+    {
+        int location = -1;
+
+        constexpr bool IsValid() const { return location >= 0; }
+    };
+
+} // namespace Voltray::Engine
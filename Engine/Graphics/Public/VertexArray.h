@@ -1,5 +1,6 @@
 #pragma once
 
+#include "VertexLayout.h"
 #include <glad/gl.h>
 
 namespace Voltray::Engine
@@ -23,6 +24,14 @@ namespace Voltray::Engine
 
         void AddVertexAttribute(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void *pointer);
 
+        /**
+         * @brief Adds one attribute pointer per element of a layout, at the attribute's location.
+         * @param layout Layout of the currently bound vertex buffer.
+         */
+        void AddVertexLayout(const VertexLayout &layout);
+
+        GLuint GetID() const { return m_ID; }
+
     private:
         GLuint m_ID;
     };
@@ -0,0 +1,213 @@
+#pragma once
+
+#include "Mat4.h"
+#include "Vec3.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Voltray::Engine
+{
+    /**
+     * @brief Meaning of a vertex attribute. The value is the shader attribute location.
+     */
+    enum class VertexAttribute : std::uint8_t
+    {
+        Position = 0,
+        Normal = 1,
+        TexCoord = 2,
+        Tangent = 3, ///< xyz tangent, w bitangent sign
+        Color = 4,
+        Joints = 5,
+        Weights = 6,
+        Count ///< Number of attributes, not an attribute
+    };
+
+    /**
+     * @brief Storage format of a vertex attribute.
+     *
+     * Every format is a whole number of 32-bit words, so vertices stay 4-byte aligned in the
+     * float arrays meshes are stored in. Normalized integer formats read as [0, 1] (UNorm) or
+     * [-1, 1] (SNorm) in the shader; UInt8x4 reads as whole numbers, for joint indices.
+     * Octahedral16 is a unit vector folded onto two SNorm16 components, which the shader
+     * unfolds back to xyz.
+     */
+    enum class VertexFormat : std::uint8_t
+    {
+        Float1,
+        Float2,
+        Float3,
+        Float4,
+        Half2,
+        Half4,
+        UNorm8x4,
+        UInt8x4,
+        UNorm16x2,
+        UNorm16x4,
+        SNorm16x2,
+        SNorm16x4,
+        Octahedral16,
+        Count ///< Number of formats, not a format
+    };
+
+    /**
+     * @brief One attribute of an interleaved vertex.
+     */
+    struct VertexElement
+    {
+        VertexAttribute attribute;
+        VertexFormat format;
+        std::uint16_t offset; ///< Byte offset from the start of the vertex
+    };
+
+    /**
+     * @class VertexLayout
+     * @brief Describes the attributes of an interleaved vertex buffer
+     *
+     * Attributes are packed in the order they are added, with no padding between them. The
+     * layout travels with the vertex data from the loaders to the Mesh, which uses it both to
+     * set up the vertex array and to find positions for bounds and picking.
+     *
+     * Quantized positions are mapped back to object space by a per-axis scale and offset,
+     * applied after the format's own decoding: position = offset + stored * scale.
+     */
+    class VertexLayout
+    {
+    public:
+        /**
+         * @brief Creates an empty layout.
+         */
+        VertexLayout() = default;
+
+        /**
+         * @brief Layout of the loaders and primitives: float position, normal and texture coordinate.
+         * @return The 32-byte standard layout.
+         */
+        static const VertexLayout &Standard();
+
+        /**
+         * @brief Layout holding only a float position.
+         * @return The 12-byte position layout.
+         */
+        static const VertexLayout &PositionOnly();
+
+        /**
+         * @brief Appends an attribute after the ones already added.
+         * @param attribute Attribute meaning; must not be in the layout yet.
+         * @param format Storage format.
+         * @return This layout, for chaining.
+         */
+        VertexLayout &Add(VertexAttribute attribute, VertexFormat format);
+
+        /**
+         * @brief Gets the attributes in the order they are stored.
+         * @return Const reference to the elements.
+         */
+        const std::vector<VertexElement> &GetElements() const { return m_Elements; }
+
+        /**
+         * @brief Finds an attribute.
+         * @param attribute Attribute to look up.
+         * @return The element, or nullptr if the layout does not have the attribute.
+         */
+        const VertexElement *Find(VertexAttribute attribute) const;
+
+        /**
+         * @brief Gets the size of one vertex.
+         * @return Stride in bytes.
+         */
+        unsigned int GetStride() const { return m_Stride; }
+
+        /**
+         * @brief Gets the size of one vertex in the float arrays vertices are stored in.
+         * @return Stride in 32-bit words.
+         */
+        unsigned int GetFloatStride() const { return m_Stride / sizeof(float); }
+
+        /**
+         * @brief Counts the vertices of a vertex array with this layout.
+         * @param vertices Interleaved vertex data.
+         * @return Number of whole vertices.
+         */
+        std::size_t GetVertexCount(const std::vector<float> &vertices) const;
+
+        /**
+         * @brief Checks whether positions are float xyz at the start of each vertex.
+         *
+         * Such vertex arrays can be used as-is by BVH and Ray with GetFloatStride() as stride.
+         * @return True if positions can be read in place.
+         */
+        bool HasInPlacePositions() const;
+
+        /**
+         * @brief Sets the transform from stored to object space positions.
+         * @param offset Added after scaling, typically the minimum of the quantized bounds.
+         * @param scale Per-axis scale, typically the extent of the quantized bounds.
+         */
+        void SetPositionDecode(const Voltray::Math::Vec3 &offset, const Voltray::Math::Vec3 &scale);
+
+        /**
+         * @brief Gets the offset added to decoded positions.
+         * @return Zero unless positions are quantized.
+         */
+        const Voltray::Math::Vec3 &GetPositionOffset() const { return m_PositionOffset; }
+
+        /**
+         * @brief Gets the per-axis scale of decoded positions.
+         * @return One unless positions are quantized.
+         */
+        const Voltray::Math::Vec3 &GetPositionScale() const { return m_PositionScale; }
+
+        /**
+         * @brief Gets the position decode as a matrix, to prepend to a model matrix.
+         *
+         * Lets shaders that only transform positions draw quantized meshes unchanged.
+         * @return Scale followed by translation, identity for unquantized positions.
+         */
+        Voltray::Math::Mat4 GetPositionDecodeMatrix() const;
+
+        /**
+         * @brief Checks whether normals are stored octahedral-encoded.
+         * @return True if the normal format is Octahedral16.
+         */
+        bool HasOctahedralNormals() const;
+
+        /**
+         * @brief Reads the object space position of a vertex.
+         * @param vertex Start of the vertex.
+         * @return The decoded position, or zero if the layout has no position.
+         */
+        Voltray::Math::Vec3 ReadPosition(const float *vertex) const;
+
+        /**
+         * @brief Decodes one attribute value to floats, as the shader would see it.
+         * @param format Storage format.
+         * @param data Start of the attribute value.
+         * @param output Receives GetComponentCount(format) floats, or xyz for Octahedral16.
+         */
+        static void Decode(VertexFormat format, const void *data, float *output);
+
+        /**
+         * @brief Gets the storage size of a format.
+         * @param format Storage format.
+         * @return Size in bytes.
+         */
+        static unsigned int GetFormatSize(VertexFormat format);
+
+        /**
+         * @brief Gets the number of components of a format.
+         * @param format Storage format.
+         * @return 1 to 4.
+         */
+        static unsigned int GetComponentCount(VertexFormat format);
+
+        bool operator==(const VertexLayout &other) const;
+        bool operator!=(const VertexLayout &other) const { return !(*this == other); }
+
+    private:
+        std::vector<VertexElement> m_Elements;
+        unsigned int m_Stride = 0;
+        Voltray::Math::Vec3 m_PositionOffset = Voltray::Math::Vec3(0.0f, 0.0f, 0.0f);
+        Voltray::Math::Vec3 m_PositionScale = Voltray::Math::Vec3(1.0f, 1.0f, 1.0f);
+    };
+}
@@ -1,5 +1,7 @@
 #include "IFormatLoader.h"
+#include "ThreadPool.h"
 #include <algorithm>
+#include <chrono>
 #include <iostream>
 
 // Include Assimp
@@ -9,6 +11,74 @@
 
 namespace Voltray::Engine
 {
+    namespace
+    {
+        // Configure import settings for optimal processing
+        constexpr unsigned int IMPORT_FLAGS =
+            aiProcess_Triangulate |              // Convert all faces to triangles
+            aiProcess_FlipUVs |                  // Flip UV coordinates (OpenGL convention)
+            aiProcess_GenSmoothNormals |         // Generate smooth normals if missing
+            aiProcess_CalcTangentSpace |         // Calculate tangent space for normal mapping
+            aiProcess_JoinIdenticalVertices |    // Remove duplicate vertices
+            aiProcess_SortByPType |              // Sort primitives by type
+            aiProcess_OptimizeMeshes |           // Optimize mesh structure
+            aiProcess_OptimizeGraph |            // Optimize scene graph
+            aiProcess_ValidateDataStructure |    // Validate data structure
+            aiProcess_ImproveCacheLocality |     // Improve cache locality
+            aiProcess_RemoveRedundantMaterials | // Remove redundant materials
+            aiProcess_FixInfacingNormals |       // Fix inward-facing normals
+            aiProcess_FindDegenerates |          // Find degenerate triangles
+            aiProcess_FindInvalidData |          // Find invalid data
+            aiProcess_GenBoundingBoxes;          // Generate bounding boxes
+
+        // Bump when ProcessMesh changes the data it produces
+        constexpr std::uint64_t CONVERSION_VERSION = 2;
+
+        /**
+         * @brief Writes interleaved Position(3) + Normal(3) + TexCoord(2) vertices
+         *
+         * Instantiated per attribute combination so the loop has no per-vertex branches.
+         */
+        template <bool HasNormals, bool HasTexCoords>
+        void ConvertVertices(const aiMesh *mesh, float *output)
+        {
+            const aiVector3D *positions = mesh->mVertices;
+            const aiVector3D *normals = mesh->mNormals;
+            const aiVector3D *texCoords = mesh->mTextureCoords[0];
+            for (unsigned int i = 0; i < mesh->mNumVertices; ++i, output += 8)
+            {
+                output[0] = positions[i].x;
+                output[1] = positions[i].y;
+                output[2] = positions[i].z;
+
+                // Normal (default to up if not present)
+                if constexpr (HasNormals)
+                {
+                    output[3] = normals[i].x;
+                    output[4] = normals[i].y;
+                    output[5] = normals[i].z;
+                }
+                else
+                {
+                    output[3] = 0.0f;
+                    output[4] = 1.0f;
+                    output[5] = 0.0f;
+                }
+
+                // Texture coordinates (use first UV channel, default to 0,0 if not present)
+                if constexpr (HasTexCoords)
+                {
+                    output[6] = texCoords[i].x;
+                    output[7] = texCoords[i].y;
+                }
+                else
+                {
+                    output[6] = 0.0f;
+                    output[7] = 0.0f;
+                }
+            }
+        }
+    }
 
     // ===== AssimpLoader Implementation =====
 
@@ -80,49 +150,36 @@ namespace Voltray::Engine
         return std::find(supportedFormats.begin(), supportedFormats.end(), ext) != supportedFormats.end();
     }
 
-    std::vector<MeshData> AssimpLoader::LoadMeshData(const std::string &filepath)
+    std::uint64_t AssimpLoader::GetImportSettingsKey() const
     {
-        std::vector<MeshData> result;
-
-        Assimp::Importer importer;
-
-        // Configure import settings for optimal processing
-        unsigned int flags =
-            aiProcess_Triangulate |              // Convert all faces to triangles
-            aiProcess_FlipUVs |                  // Flip UV coordinates (OpenGL convention)
-            aiProcess_GenSmoothNormals |         // Generate smooth normals if missing
-            aiProcess_CalcTangentSpace |         // Calculate tangent space for normal mapping
-            aiProcess_JoinIdenticalVertices |    // Remove duplicate vertices
-            aiProcess_SortByPType |              // Sort primitives by type
-            aiProcess_OptimizeMeshes |           // Optimize mesh structure
-            aiProcess_OptimizeGraph |            // Optimize scene graph
-            aiProcess_ValidateDataStructure |    // Validate data structure
-            aiProcess_ImproveCacheLocality |     // Improve cache locality
-            aiProcess_RemoveRedundantMaterials | // Remove redundant materials
-            aiProcess_FixInfacingNormals |       // Fix inward-facing normals
-            aiProcess_FindDegenerates |          // Find degenerate triangles
-            aiProcess_FindInvalidData |          // Find invalid data
-            aiProcess_GenBoundingBoxes;          // Generate bounding boxes
-
-        const aiScene *scene = importer.ReadFile(filepath, flags);
+        return (CONVERSION_VERSION << 32) | IMPORT_FLAGS;
+    }
 
+    const aiScene *AssimpLoader::ImportScene(Assimp::Importer &importer, const std::string &filepath)
+    {
+        const aiScene *scene = importer.ReadFile(filepath, IMPORT_FLAGS);
         if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode)
         {
             throw std::runtime_error("Assimp error loading " + filepath + ": " + std::string(importer.GetErrorString()));
         }
-        std::cout << "Loading with Assimp: " << filepath << std::endl;
-        std::cout << "Scene contains " << scene->mNumMeshes << " meshes" << std::endl;
+        return scene;
+    }
+
+    std::vector<MeshData> AssimpLoader::ConvertScene(const aiScene *scene)
+    {
+        // Meshes only read the scene, so they convert independently
+        std::vector<MeshData> converted(scene->mNumMeshes);
+        Utils::ThreadPool::GetInstance().ParallelFor(scene->mNumMeshes, [&](std::size_t i)
+                                                     { converted[i] = ProcessMesh(scene->mMeshes[i], const_cast<aiScene *>(scene)); });
 
-        // Process all meshes in the scene
+        std::vector<MeshData> result;
         for (unsigned int i = 0; i < scene->mNumMeshes; i++)
         {
-            aiMesh *mesh = scene->mMeshes[i];
-            MeshData data = ProcessMesh(mesh, const_cast<aiScene *>(scene));
-
+            MeshData &data = converted[i];
             if (!data.vertices.empty())
             {
                 // Set mesh name
-                data.name = mesh->mName.C_Str();
+                data.name = scene->mMeshes[i]->mName.C_Str();
                 if (data.name.empty())
                 {
                     data.name = "Mesh_" + std::to_string(i);
@@ -131,6 +188,22 @@ namespace Voltray::Engine
                 result.push_back(std::move(data));
             }
         }
+        return result;
+    }
+
+    std::vector<MeshData> AssimpLoader::LoadMeshData(const std::string &filepath)
+    {
+        Assimp::Importer importer;
+
+        const auto start = std::chrono::steady_clock::now();
+        const aiScene *scene = ImportScene(importer, filepath);
+        const auto parsed = std::chrono::steady_clock::now();
+        std::cout << "Loading with Assimp: " << filepath << std::endl;
+        std::cout << "Scene contains " << scene->mNumMeshes << " meshes" << std::endl;
+
+        std::vector<MeshData> result = ConvertScene(scene);
+        const std::chrono::duration<double, std::milli> conversionTime = std::chrono::steady_clock::now() - parsed;
+        const std::chrono::duration<double, std::milli> parseTime = parsed - start;
 
         if (!result.empty())
         {
@@ -138,10 +211,11 @@ namespace Voltray::Engine
             size_t totalVertices = 0, totalFaces = 0;
             for (const auto &mesh : result)
             {
-                totalVertices += mesh.vertices.size() / 8;
+                totalVertices += mesh.layout.GetVertexCount(mesh.vertices);
                 totalFaces += mesh.indices.size() / 3;
             }
             std::cout << "Total vertices: " << totalVertices << ", Total faces: " << totalFaces << std::endl;
+            std::cout << "Assimp import: " << parseTime.count() << " ms, conversion: " << conversionTime.count() << " ms" << std::endl;
         }
 
         return result;
@@ -152,51 +226,33 @@ namespace Voltray::Engine
         aiMesh *mesh = static_cast<aiMesh *>(meshPtr);
         const aiScene *scene = static_cast<const aiScene *>(scenePtr);
 
-        MeshData data;
+        // aiProcess_Triangulate and aiProcess_SortByPType leave points and lines in meshes of their own
+        if (mesh->mPrimitiveTypes != aiPrimitiveType_TRIANGLE)
+            return {}; // Points and lines are not rendered
 
-        // Process vertices
-        for (unsigned int i = 0; i < mesh->mNumVertices; i++)
-        {
-            // Position (required)
-            data.vertices.push_back(mesh->mVertices[i].x);
-            data.vertices.push_back(mesh->mVertices[i].y);
-            data.vertices.push_back(mesh->mVertices[i].z);
-
-            // Normal (default to up if not present)
-            if (mesh->HasNormals())
-            {
-                data.vertices.push_back(mesh->mNormals[i].x);
-                data.vertices.push_back(mesh->mNormals[i].y);
-                data.vertices.push_back(mesh->mNormals[i].z);
-            }
-            else
-            {
-                data.vertices.push_back(0.0f);
-                data.vertices.push_back(1.0f);
-                data.vertices.push_back(0.0f);
-            }
+        MeshData data;
 
-            // Texture coordinates (use first UV channel, default to 0,0 if not present)
-            if (mesh->mTextureCoords[0])
-            {
-                data.vertices.push_back(mesh->mTextureCoords[0][i].x);
-                data.vertices.push_back(mesh->mTextureCoords[0][i].y);
-            }
-            else
-            {
-                data.vertices.push_back(0.0f);
-                data.vertices.push_back(0.0f);
-            }
-        }
+        // Size both buffers once, then fill them with the loop matching the attributes present
+        data.vertices.resize(static_cast<std::size_t>(mesh->mNumVertices) * 8);
+        const bool hasNormals = mesh->HasNormals();
+        const bool hasTexCoords = mesh->mTextureCoords[0] != nullptr;
+        if (hasNormals && hasTexCoords)
+            ConvertVertices<true, true>(mesh, data.vertices.data());
+        else if (hasNormals)
+            ConvertVertices<true, false>(mesh, data.vertices.data());
+        else if (hasTexCoords)
+            ConvertVertices<false, true>(mesh, data.vertices.data());
+        else
+            ConvertVertices<false, false>(mesh, data.vertices.data());
 
-        // Process indices
-        for (unsigned int i = 0; i < mesh->mNumFaces; i++)
+        data.indices.resize(static_cast<std::size_t>(mesh->mNumFaces) * 3);
+        unsigned int *output = data.indices.data();
+        for (unsigned int i = 0; i < mesh->mNumFaces; i++, output += 3)
         {
-            aiFace face = mesh->mFaces[i];
-            for (unsigned int j = 0; j < face.mNumIndices; j++)
-            {
-                data.indices.push_back(face.mIndices[j]);
-            }
+            const unsigned int *face = mesh->mFaces[i].mIndices;
+            output[0] = face[0];
+            output[1] = face[1];
+            output[2] = face[2];
         }
 
         // Store material information if available
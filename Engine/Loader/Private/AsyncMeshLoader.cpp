@@ -0,0 +1,199 @@
+#include "AsyncMeshLoader.h"
+#include "EngineSettings.h"
+#include "MeshCache.h"
+#include "MeshLoader.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <exception>
+
+namespace Voltray::Engine
+{
+    AsyncMeshLoader::AsyncMeshLoader()
+    {
+        // Keep every worker busy and one parsed file per worker ready for upload
+        m_MaxInFlight = 2 * static_cast<std::size_t>(Utils::ThreadPool::GetInstance().GetThreadCount());
+    }
+
+    AsyncMeshLoader &AsyncMeshLoader::GetInstance()
+    {
+        // Never destroyed, so workers still parsing at exit never see a dead loader
+        static AsyncMeshLoader *instance = new AsyncMeshLoader();
+        return *instance;
+    }
+
+    AsyncMeshLoader::RequestId AsyncMeshLoader::LoadAsync(const std::string &filepath, CompletionCallback callback)
+    {
+        if (m_Jobs.empty())
+        {
+            // Start counting a new batch
+            m_Completed = 0;
+            m_Failed = 0;
+        }
+
+        const RequestId id = m_NextRequestId++;
+        const bool compressVertices = EngineSettings::CompressVertices;
+        const std::string key = compressVertices ? filepath + "|compressed" : filepath;
+        std::shared_ptr<Job> &job = m_Jobs[key];
+        if (job)
+        {
+            job->requests.emplace_back(id, std::move(callback));
+            return id;
+        }
+
+        job = std::make_shared<Job>();
+        job->filepath = filepath;
+        job->key = key;
+        job->compressVertices = compressVertices;
+        job->requests.emplace_back(id, std::move(callback));
+
+        // Loaded files skip the queue and are reported on the next ProcessUploads
+        job->cachedMeshes = MeshCache::GetInstance().Find(filepath, compressVertices);
+        if (!job->cachedMeshes.empty())
+        {
+            m_InFlight.push_back(job);
+            return id;
+        }
+
+        m_Queued.push_back(job);
+        StartJobs();
+        return id;
+    }
+
+    bool AsyncMeshLoader::Cancel(RequestId id)
+    {
+        for (auto it = m_Jobs.begin(); it != m_Jobs.end(); ++it)
+        {
+            Job &job = *it->second;
+            auto request = std::find_if(job.requests.begin(), job.requests.end(), [id](const auto &entry)
+                                        { return entry.first == id; });
+            if (request == job.requests.end())
+                continue;
+
+            CompletionCallback callback = std::move(request->second);
+            job.requests.erase(request);
+            if (job.requests.empty())
+            {
+                // Queued jobs are dropped, parsing ones are drained by ProcessUploads
+                job.cancelled = true;
+                m_Queued.erase(std::remove(m_Queued.begin(), m_Queued.end(), it->second), m_Queued.end());
+                m_Jobs.erase(it);
+            }
+
+            Result result;
+            result.cancelled = true;
+            if (callback)
+                callback(result);
+            return true;
+        }
+        return false;
+    }
+
+    void AsyncMeshLoader::CancelAll()
+    {
+        std::vector<RequestId> ids;
+        for (const auto &entry : m_Jobs)
+        {
+            for (const auto &request : entry.second->requests)
+                ids.push_back(request.first);
+        }
+        for (RequestId id : ids)
+        {
+            Cancel(id);
+        }
+    }
+
+    void AsyncMeshLoader::ProcessUploads(double budgetMilliseconds)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < m_InFlight.size();)
+        {
+            std::shared_ptr<Job> job = m_InFlight[i];
+            if (job->parsed.valid() && job->parsed.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            {
+                ++i;
+                continue;
+            }
+
+            m_InFlight.erase(m_InFlight.begin() + static_cast<std::ptrdiff_t>(i));
+            if (job->cancelled)
+                continue;
+
+            m_Jobs.erase(job->key);
+            FinishJob(*job);
+
+            const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+            if (elapsed.count() >= budgetMilliseconds)
+                break;
+        }
+
+        StartJobs();
+    }
+
+    void AsyncMeshLoader::SetMaxInFlight(std::size_t count)
+    {
+        m_MaxInFlight = std::max<std::size_t>(count, 1);
+        StartJobs();
+    }
+
+    AsyncMeshLoader::Progress AsyncMeshLoader::GetProgress() const
+    {
+        Progress progress;
+        progress.queued = m_Queued.size();
+        progress.loading = m_Jobs.size() - m_Queued.size();
+        progress.completed = m_Completed;
+        progress.failed = m_Failed;
+        return progress;
+    }
+
+    void AsyncMeshLoader::StartJobs()
+    {
+        while (!m_Queued.empty() && m_InFlight.size() < m_MaxInFlight)
+        {
+            std::shared_ptr<Job> job = std::move(m_Queued.front());
+            m_Queued.pop_front();
+
+            // The task keeps the job alive, so cancelling never frees it under the worker
+            job->parsed = Utils::ThreadPool::GetInstance().Submit([job]()
+                                                                   {
+                if (job->cancelled)
+                    return std::vector<MeshData>();
+                return MeshLoader::ImportMeshData(job->filepath, job->compressVertices); });
+            m_InFlight.push_back(std::move(job));
+        }
+    }
+
+    void AsyncMeshLoader::FinishJob(Job &job)
+    {
+        Result result;
+        if (job.parsed.valid())
+        {
+            try
+            {
+                result.meshes = MeshCache::GetInstance().Insert(job.filepath, job.compressVertices, job.parsed.get());
+                if (result.meshes.empty())
+                    result.error = "No meshes found in " + job.filepath;
+            }
+            catch (const std::exception &e)
+            {
+                result.error = e.what();
+            }
+        }
+        else
+        {
+            result.meshes = std::move(job.cachedMeshes);
+        }
+
+        if (result.IsSuccess())
+            ++m_Completed;
+        else
+            ++m_Failed;
+
+        // Callbacks may queue or cancel other requests, the job is already detached
+        for (auto &request : job.requests)
+        {
+            if (request.second)
+                request.second(result);
+        }
+    }
+}
@@ -0,0 +1,265 @@
+#include "CookedMeshCache.h"
+#include "CookedMeshFormat.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <thread>
+
+namespace Voltray::Engine
+{
+    std::filesystem::path CookedMeshCache::s_Directory;
+    std::mutex CookedMeshCache::s_DirectoryMutex;
+
+    namespace
+    {
+        constexpr std::uint64_t FNV_OFFSET_BASIS = 0xCBF29CE484222325ull;
+        constexpr std::uint64_t FNV_PRIME = 0x100000001B3ull;
+
+        // FNV-1a over 8-byte words, so hashing keeps up with reading the file
+        std::uint64_t HashBytes(const unsigned char *data, std::size_t size)
+        {
+            std::uint64_t hash = FNV_OFFSET_BASIS;
+            std::size_t i = 0;
+            for (; i + sizeof(std::uint64_t) <= size; i += sizeof(std::uint64_t))
+            {
+                std::uint64_t word;
+                std::memcpy(&word, data + i, sizeof(word));
+                hash = (hash ^ word) * FNV_PRIME;
+            }
+            for (; i < size; ++i)
+            {
+                hash = (hash ^ data[i]) * FNV_PRIME;
+            }
+            return hash;
+        }
+
+        bool IsInRange(std::uint64_t offset, std::uint64_t size, std::uint64_t fileSize)
+        {
+            return offset <= fileSize && size <= fileSize - offset;
+        }
+
+        CookedMeshFormat::StringRef AddString(std::string &strings, const std::string &value)
+        {
+            CookedMeshFormat::StringRef ref{static_cast<std::uint32_t>(strings.size()), static_cast<std::uint32_t>(value.size())};
+            strings += value;
+            return ref;
+        }
+
+        void WriteLayout(const VertexLayout &layout, CookedMeshFormat::Mesh &record)
+        {
+            const std::vector<VertexElement> &elements = layout.GetElements();
+            record.elementCount = static_cast<std::uint32_t>(elements.size());
+            record.vertexStride = layout.GetStride();
+            for (std::size_t i = 0; i < elements.size(); ++i)
+            {
+                record.attributes[i] = static_cast<std::uint8_t>(elements[i].attribute);
+                record.formats[i] = static_cast<std::uint8_t>(elements[i].format);
+            }
+
+            const Math::Vec3 &offset = layout.GetPositionOffset();
+            const Math::Vec3 &scale = layout.GetPositionScale();
+            record.positionOffset[0] = offset.x;
+            record.positionOffset[1] = offset.y;
+            record.positionOffset[2] = offset.z;
+            record.positionScale[0] = scale.x;
+            record.positionScale[1] = scale.y;
+            record.positionScale[2] = scale.z;
+        }
+
+        bool ReadLayout(const CookedMeshFormat::Mesh &record, VertexLayout &layout)
+        {
+            if (record.elementCount == 0 || record.elementCount > CookedMeshFormat::MAX_VERTEX_ELEMENTS)
+                return false;
+
+            layout = VertexLayout();
+            for (std::uint32_t i = 0; i < record.elementCount; ++i)
+            {
+                const auto attribute = static_cast<VertexAttribute>(record.attributes[i]);
+                const auto format = static_cast<VertexFormat>(record.formats[i]);
+                if (attribute >= VertexAttribute::Count || format >= VertexFormat::Count || layout.Find(attribute))
+                    return false;
+                layout.Add(attribute, format);
+            }
+            layout.SetPositionDecode(Math::Vec3(record.positionOffset[0], record.positionOffset[1], record.positionOffset[2]),
+                                     Math::Vec3(record.positionScale[0], record.positionScale[1], record.positionScale[2]));
+            return layout.GetStride() == record.vertexStride;
+        }
+    }
+
+    void CookedMeshCache::SetDirectory(const std::filesystem::path &directory)
+    {
+        std::lock_guard<std::mutex> lock(s_DirectoryMutex);
+        s_Directory = directory;
+    }
+
+    std::filesystem::path CookedMeshCache::GetDirectory()
+    {
+        std::lock_guard<std::mutex> lock(s_DirectoryMutex);
+        return s_Directory;
+    }
+
+    bool CookedMeshCache::GetSourceKey(const std::string &filepath, std::uint64_t settingsKey, SourceKey &key)
+    {
+        Utils::MappedFile source;
+        if (!source.Open(filepath))
+            return false;
+
+        key.sourceHash = HashBytes(source.GetData(), source.GetSize());
+        key.sourceSize = source.GetSize();
+        key.settingsKey = settingsKey;
+        return true;
+    }
+
+    bool CookedMeshCache::Load(const SourceKey &key, std::vector<MeshData> &meshData)
+    {
+        const std::filesystem::path directory = GetDirectory();
+        if (directory.empty())
+            return false;
+
+        Utils::MappedFile file;
+        if (!file.Open(GetCookedPath(directory, key)))
+            return false;
+
+        const unsigned char *data = file.GetData();
+        const std::uint64_t fileSize = file.GetSize();
+        CookedMeshFormat::Header header;
+        if (fileSize < sizeof(header))
+            return false;
+        std::memcpy(&header, data, sizeof(header));
+
+        if (header.magic != CookedMeshFormat::MAGIC || header.version != CookedMeshFormat::VERSION ||
+            header.meshSize != sizeof(CookedMeshFormat::Mesh) || header.sourceHash != key.sourceHash ||
+            header.sourceSize != key.sourceSize || header.settingsKey != key.settingsKey ||
+            !IsInRange(header.meshOffset, std::uint64_t(header.meshCount) * sizeof(CookedMeshFormat::Mesh), fileSize) ||
+            !IsInRange(header.stringTableOffset, header.stringTableSize, fileSize))
+        {
+            return false;
+        }
+
+        const char *strings = reinterpret_cast<const char *>(data + header.stringTableOffset);
+        auto getString = [&](const CookedMeshFormat::StringRef &ref, std::string &value)
+        {
+            if (!IsInRange(ref.offset, ref.length, header.stringTableSize))
+                return false;
+            value.assign(strings + ref.offset, ref.length);
+            return true;
+        };
+
+        std::vector<MeshData> result(header.meshCount);
+        for (std::uint32_t i = 0; i < header.meshCount; ++i)
+        {
+            CookedMeshFormat::Mesh record;
+            std::memcpy(&record, data + header.meshOffset + i * sizeof(record), sizeof(record));
+
+            const std::uint64_t vertexBytes = std::uint64_t(record.vertexCount) * sizeof(float);
+            const std::uint64_t indexBytes = std::uint64_t(record.indexCount) * sizeof(unsigned int);
+            if (!IsInRange(record.vertexOffset, vertexBytes, fileSize) || !IsInRange(record.indexOffset, indexBytes, fileSize))
+                return false;
+
+            MeshData &mesh = result[i];
+            if (!getString(record.name, mesh.name) || !getString(record.materialName, mesh.materialName) ||
+                !ReadLayout(record, mesh.layout) || record.vertexCount % mesh.layout.GetFloatStride() != 0)
+                return false;
+
+            mesh.vertices.resize(record.vertexCount);
+            std::memcpy(mesh.vertices.data(), data + record.vertexOffset, vertexBytes);
+            mesh.indices.resize(record.indexCount);
+            std::memcpy(mesh.indices.data(), data + record.indexOffset, indexBytes);
+
+            // Picking and drawing index the vertices unchecked, so a corrupt file must not get past here
+            const std::size_t meshVertexCount = mesh.layout.GetVertexCount(mesh.vertices);
+            if (mesh.indices.size() % 3 != 0 ||
+                std::any_of(mesh.indices.begin(), mesh.indices.end(), [meshVertexCount](unsigned int index)
+                            { return index >= meshVertexCount; }))
+                return false;
+        }
+
+        meshData = std::move(result);
+        return true;
+    }
+
+    bool CookedMeshCache::Store(const SourceKey &key, const std::vector<MeshData> &meshData)
+    {
+        const std::filesystem::path directory = GetDirectory();
+        if (directory.empty())
+            return false;
+
+        std::error_code error;
+        std::filesystem::create_directories(directory, error);
+        if (error)
+            return false;
+
+        // Lay out the records, then the arrays one after another, then the strings
+        std::vector<CookedMeshFormat::Mesh> records(meshData.size());
+        std::string strings;
+        std::uint64_t offset = sizeof(CookedMeshFormat::Header) + records.size() * sizeof(CookedMeshFormat::Mesh);
+        for (std::size_t i = 0; i < meshData.size(); ++i)
+        {
+            const MeshData &mesh = meshData[i];
+            CookedMeshFormat::Mesh &record = records[i];
+            record.vertexCount = static_cast<std::uint32_t>(mesh.vertices.size());
+            record.indexCount = static_cast<std::uint32_t>(mesh.indices.size());
+            record.vertexOffset = offset;
+            offset += mesh.vertices.size() * sizeof(float);
+            record.indexOffset = offset;
+            offset += mesh.indices.size() * sizeof(unsigned int);
+            record.name = AddString(strings, mesh.name);
+            record.materialName = AddString(strings, mesh.materialName);
+            WriteLayout(mesh.layout, record);
+        }
+
+        CookedMeshFormat::Header header{};
+        header.magic = CookedMeshFormat::MAGIC;
+        header.version = CookedMeshFormat::VERSION;
+        header.meshCount = static_cast<std::uint32_t>(records.size());
+        header.meshSize = sizeof(CookedMeshFormat::Mesh);
+        header.sourceHash = key.sourceHash;
+        header.sourceSize = key.sourceSize;
+        header.settingsKey = key.settingsKey;
+        header.meshOffset = sizeof(CookedMeshFormat::Header);
+        header.stringTableOffset = offset;
+        header.stringTableSize = strings.size();
+
+        // Write under a temporary name so concurrent loads never map a partial file
+        const std::filesystem::path cookedPath = GetCookedPath(directory, key);
+        std::filesystem::path temporaryPath = cookedPath;
+        temporaryPath += "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+        {
+            std::ofstream file(temporaryPath, std::ios::binary);
+            file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            file.write(reinterpret_cast<const char *>(records.data()), static_cast<std::streamsize>(records.size() * sizeof(CookedMeshFormat::Mesh)));
+            for (const MeshData &mesh : meshData)
+            {
+                file.write(reinterpret_cast<const char *>(mesh.vertices.data()), static_cast<std::streamsize>(mesh.vertices.size() * sizeof(float)));
+                file.write(reinterpret_cast<const char *>(mesh.indices.data()), static_cast<std::streamsize>(mesh.indices.size() * sizeof(unsigned int)));
+            }
+            file.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+            if (!file)
+            {
+                std::cerr << "Error: Failed to write cooked mesh: " << temporaryPath << std::endl;
+                file.close();
+                std::filesystem::remove(temporaryPath, error);
+                return false;
+            }
+        }
+
+        std::filesystem::rename(temporaryPath, cookedPath, error);
+        if (error)
+        {
+            std::filesystem::remove(temporaryPath, error);
+            return false;
+        }
+        return true;
+    }
+
+    std::filesystem::path CookedMeshCache::GetCookedPath(const std::filesystem::path &directory, const SourceKey &key)
+    {
+        char name[64];
+        std::snprintf(name, sizeof(name), "%016llx_%016llx.vmesh", static_cast<unsigned long long>(key.sourceHash), static_cast<unsigned long long>(key.settingsKey));
+        return directory / name;
+    }
+}
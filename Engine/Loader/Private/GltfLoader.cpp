@@ -0,0 +1,830 @@
+#include "GltfLoader.h"
+#include "MappedFile.h"
+#include "MeshLoader.h"
+#include "ThreadPool.h"
+#include "Mat4.h"
+#include "Quat.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+namespace Voltray::Engine
+{
+    namespace
+    {
+        constexpr std::uint32_t GLB_MAGIC = 0x46546C67;      // "glTF"
+        constexpr std::uint32_t GLB_CHUNK_JSON = 0x4E4F534A; // "JSON"
+        constexpr std::uint32_t GLB_CHUNK_BIN = 0x004E4942;  // "BIN\0"
+        constexpr std::size_t GLB_HEADER_SIZE = 12;
+        constexpr std::size_t GLB_CHUNK_HEADER_SIZE = 8;
+
+        // Accessor component types
+        constexpr int COMPONENT_BYTE = 5120;
+        constexpr int COMPONENT_UNSIGNED_BYTE = 5121;
+        constexpr int COMPONENT_SHORT = 5122;
+        constexpr int COMPONENT_UNSIGNED_SHORT = 5123;
+        constexpr int COMPONENT_UNSIGNED_INT = 5125;
+        constexpr int COMPONENT_FLOAT = 5126;
+
+        // Primitive modes
+        constexpr int MODE_TRIANGLES = 4;
+        constexpr int MODE_TRIANGLE_STRIP = 5;
+        constexpr int MODE_TRIANGLE_FAN = 6;
+
+        /**
+         * @brief Extensions that change nothing this loader reads
+         */
+        bool IsExtensionSupported(const std::string &name)
+        {
+            return name == "KHR_mesh_quantization" || name == "KHR_texture_transform" || name.rfind("KHR_materials_", 0) == 0;
+        }
+
+        struct Buffer
+        {
+            const unsigned char *data = nullptr;
+            std::size_t size = 0;
+        };
+
+        /**
+         * @brief Typed view of accessor data inside a buffer
+         */
+        struct Accessor
+        {
+            const unsigned char *data = nullptr; ///< First element, nullptr for accessors without a buffer view (all zeros)
+            std::size_t count = 0;
+            std::size_t stride = 0;
+            int componentType = COMPONENT_FLOAT;
+            int componentCount = 1;
+            bool normalized = false;
+
+            bool IsPacked(int type, int components) const
+            {
+                return componentType == type && componentCount == components && stride == GetElementSize();
+            }
+
+            std::size_t GetComponentSize() const
+            {
+                switch (componentType)
+                {
+                case COMPONENT_BYTE:
+                case COMPONENT_UNSIGNED_BYTE:
+                    return 1;
+                case COMPONENT_SHORT:
+                case COMPONENT_UNSIGNED_SHORT:
+                    return 2;
+                default:
+                    return 4;
+                }
+            }
+
+            std::size_t GetElementSize() const { return GetComponentSize() * static_cast<std::size_t>(componentCount); }
+
+            /**
+             * @brief Reads one component as float, applying normalization
+             */
+            float ReadFloat(std::size_t element, int component) const
+            {
+                if (!data)
+                    return 0.0f;
+
+                const unsigned char *source = data + element * stride + static_cast<std::size_t>(component) * GetComponentSize();
+                switch (componentType)
+                {
+                case COMPONENT_BYTE:
+                {
+                    const float value = static_cast<std::int8_t>(*source);
+                    return normalized ? std::max(value / 127.0f, -1.0f) : value;
+                }
+                case COMPONENT_UNSIGNED_BYTE:
+                    return normalized ? *source / 255.0f : *source;
+                case COMPONENT_SHORT:
+                {
+                    std::int16_t value;
+                    std::memcpy(&value, source, sizeof(value));
+                    return normalized ? std::max(value / 32767.0f, -1.0f) : value;
+                }
+                case COMPONENT_UNSIGNED_SHORT:
+                {
+                    std::uint16_t value;
+                    std::memcpy(&value, source, sizeof(value));
+                    return normalized ? value / 65535.0f : value;
+                }
+                case COMPONENT_UNSIGNED_INT:
+                {
+                    std::uint32_t value;
+                    std::memcpy(&value, source, sizeof(value));
+                    return static_cast<float>(value);
+                }
+                default:
+                {
+                    float value;
+                    std::memcpy(&value, source, sizeof(value));
+                    return value;
+                }
+                }
+            }
+
+            std::uint32_t ReadIndex(std::size_t element) const
+            {
+                if (!data)
+                    return 0;
+
+                const unsigned char *source = data + element * stride;
+                switch (componentType)
+                {
+                case COMPONENT_UNSIGNED_BYTE:
+                    return *source;
+                case COMPONENT_UNSIGNED_SHORT:
+                {
+                    std::uint16_t value;
+                    std::memcpy(&value, source, sizeof(value));
+                    return value;
+                }
+                case COMPONENT_UNSIGNED_INT:
+                {
+                    std::uint32_t value;
+                    std::memcpy(&value, source, sizeof(value));
+                    return value;
+                }
+                default:
+                    return 0;
+                }
+            }
+        };
+
+        /**
+         * @brief One primitive of a mesh node, converted into one MeshData
+         */
+        struct PrimitiveInstance
+        {
+            const json *primitive;
+            Math::Mat4 world;
+            std::string name;
+            std::string materialName;
+        };
+
+        int GetComponentCount(const std::string &type)
+        {
+            if (type == "SCALAR")
+                return 1;
+            if (type == "VEC2")
+                return 2;
+            if (type == "VEC3")
+                return 3;
+            if (type == "VEC4" || type == "MAT2")
+                return 4;
+            if (type == "MAT3")
+                return 9;
+            if (type == "MAT4")
+                return 16;
+            throw std::runtime_error("Unknown glTF accessor type: " + type);
+        }
+
+        std::vector<unsigned char> DecodeBase64(const char *text, std::size_t length)
+        {
+            auto decodeChar = [](char c) -> int
+            {
+                if (c >= 'A' && c <= 'Z')
+                    return c - 'A';
+                if (c >= 'a' && c <= 'z')
+                    return c - 'a' + 26;
+                if (c >= '0' && c <= '9')
+                    return c - '0' + 52;
+                if (c == '+' || c == '-')
+                    return 62;
+                if (c == '/' || c == '_')
+                    return 63;
+                return -1;
+            };
+
+            std::vector<unsigned char> result;
+            result.reserve(length / 4 * 3);
+            std::uint32_t bits = 0;
+            int bitCount = 0;
+            for (std::size_t i = 0; i < length; ++i)
+            {
+                const int value = decodeChar(text[i]);
+                if (value < 0)
+                    continue; // Padding and whitespace
+                bits = (bits << 6) | static_cast<std::uint32_t>(value);
+                bitCount += 6;
+                if (bitCount >= 8)
+                {
+                    bitCount -= 8;
+                    result.push_back(static_cast<unsigned char>(bits >> bitCount));
+                }
+            }
+            return result;
+        }
+
+        std::string DecodeUri(const std::string &uri)
+        {
+            std::string result;
+            result.reserve(uri.size());
+            for (std::size_t i = 0; i < uri.size(); ++i)
+            {
+                if (uri[i] == '%' && i + 2 < uri.size())
+                {
+                    result.push_back(static_cast<char>(std::stoi(uri.substr(i + 1, 2), nullptr, 16)));
+                    i += 2;
+                }
+                else
+                {
+                    result.push_back(uri[i]);
+                }
+            }
+            return result;
+        }
+
+        /**
+         * @brief Local transform of a node, from its matrix or its translation, rotation and scale
+         */
+        Math::Mat4 GetLocalTransform(const json &node)
+        {
+            Math::Mat4 result;
+            if (node.contains("matrix"))
+            {
+                const json &matrix = node["matrix"];
+                for (int i = 0; i < 16; ++i)
+                    result.data[i] = matrix.at(i).get<float>(); // Both column-major
+                return result;
+            }
+
+            // Scale, then rotate, then translate; Mat4 products apply the left operand first
+            if (node.contains("scale"))
+            {
+                const json &s = node["scale"];
+                result = result * Math::Mat4::Scale(Math::Vec3(s.at(0).get<float>(), s.at(1).get<float>(), s.at(2).get<float>()));
+            }
+            if (node.contains("rotation"))
+            {
+                const json &r = node["rotation"];
+                result = result * Math::Quat(r.at(0).get<float>(), r.at(1).get<float>(), r.at(2).get<float>(), r.at(3).get<float>()).ToMat4();
+            }
+            if (node.contains("translation"))
+            {
+                const json &t = node["translation"];
+                result = result * Math::Mat4::Translate(Math::Vec3(t.at(0).get<float>(), t.at(1).get<float>(), t.at(2).get<float>()));
+            }
+            return result;
+        }
+
+        bool IsIdentity(const Math::Mat4 &matrix)
+        {
+            static const Math::Mat4 identity;
+            return std::equal(matrix.data, matrix.data + 16, identity.data);
+        }
+
+        /**
+         * @brief Parsed document with its buffers resolved
+         */
+        class Document
+        {
+        public:
+            explicit Document(const std::string &filepath)
+            {
+                if (!m_File.Open(filepath))
+                    throw std::runtime_error("Cannot open glTF file: " + filepath);
+
+                const unsigned char *data = m_File.GetData();
+                const std::size_t size = m_File.GetSize();
+                std::uint32_t magic = 0;
+                if (size >= sizeof(magic))
+                    std::memcpy(&magic, data, sizeof(magic));
+
+                Buffer binaryChunk;
+                if (magic == GLB_MAGIC)
+                {
+                    // Header (magic, version, length), then a JSON chunk and an optional binary chunk
+                    std::size_t offset = GLB_HEADER_SIZE;
+                    while (offset + GLB_CHUNK_HEADER_SIZE <= size)
+                    {
+                        std::uint32_t chunkLength, chunkType;
+                        std::memcpy(&chunkLength, data + offset, sizeof(chunkLength));
+                        std::memcpy(&chunkType, data + offset + 4, sizeof(chunkType));
+                        offset += GLB_CHUNK_HEADER_SIZE;
+                        if (chunkLength > size - offset)
+                            throw std::runtime_error("GLB chunk exceeds the file: " + filepath);
+
+                        if (chunkType == GLB_CHUNK_JSON && m_Json.is_null())
+                            m_Json = json::parse(data + offset, data + offset + chunkLength);
+                        else if (chunkType == GLB_CHUNK_BIN && !binaryChunk.data)
+                            binaryChunk = Buffer{data + offset, chunkLength};
+                        offset += chunkLength;
+                    }
+                    if (m_Json.is_null())
+                        throw std::runtime_error("GLB file has no JSON chunk: " + filepath);
+                }
+                else
+                {
+                    m_Json = json::parse(data, data + size);
+                }
+
+                const std::filesystem::path directory = std::filesystem::path(filepath).parent_path();
+                for (const json &buffer : m_Json.value("buffers", json::array()))
+                {
+                    if (!buffer.contains("uri"))
+                    {
+                        // The GLB binary chunk; valid only as the first buffer
+                        m_Buffers.push_back(binaryChunk);
+                        continue;
+                    }
+
+                    const std::string uri = buffer["uri"].get<std::string>();
+                    if (uri.rfind("data:", 0) == 0)
+                    {
+                        const std::size_t comma = uri.find(',');
+                        if (comma == std::string::npos)
+                            throw std::runtime_error("Malformed glTF data URI in " + filepath);
+                        m_EmbeddedData.push_back(DecodeBase64(uri.data() + comma + 1, uri.size() - comma - 1));
+                        m_Buffers.push_back(Buffer{m_EmbeddedData.back().data(), m_EmbeddedData.back().size()});
+                        continue;
+                    }
+
+                    Utils::MappedFile external;
+                    const std::filesystem::path bufferPath = directory / DecodeUri(uri);
+                    if (!external.Open(bufferPath))
+                        throw std::runtime_error("Cannot open glTF buffer: " + bufferPath.string());
+                    m_Buffers.push_back(Buffer{external.GetData(), external.GetSize()});
+                    m_ExternalFiles.push_back(std::move(external));
+                }
+            }
+
+            const json &GetJson() const { return m_Json; }
+
+            /**
+             * @brief Checks for data this loader cannot decode
+             */
+            bool IsSupported() const
+            {
+                for (const json &extension : m_Json.value("extensionsRequired", json::array()))
+                {
+                    if (!IsExtensionSupported(extension.get<std::string>()))
+                        return false;
+                }
+                for (const json &accessor : m_Json.value("accessors", json::array()))
+                {
+                    if (accessor.contains("sparse"))
+                        return false;
+                }
+                return true;
+            }
+
+            Accessor GetAccessor(std::size_t index) const
+            {
+                const json &accessor = m_Json.at("accessors").at(index);
+                Accessor result;
+                result.count = accessor.at("count").get<std::size_t>();
+                result.componentType = accessor.at("componentType").get<int>();
+                result.componentCount = GetComponentCount(accessor.at("type").get<std::string>());
+                result.normalized = accessor.value("normalized", false);
+                result.stride = result.GetElementSize();
+                if (!accessor.contains("bufferView"))
+                    return result;
+
+                const json &view = m_Json.at("bufferViews").at(accessor["bufferView"].get<std::size_t>());
+                const Buffer &buffer = m_Buffers.at(view.at("buffer").get<std::size_t>());
+                const std::size_t viewOffset = view.value("byteOffset", std::size_t(0));
+                const std::size_t viewLength = view.at("byteLength").get<std::size_t>();
+                const std::size_t offset = accessor.value("byteOffset", std::size_t(0));
+                result.stride = view.value("byteStride", result.GetElementSize());
+
+                // Checked first, the fit test below divides by the stride
+                const std::size_t elementSize = result.GetElementSize();
+                if (result.stride < elementSize)
+                    throw std::runtime_error("glTF accessor " + std::to_string(index) + " has a byte stride smaller than its elements");
+
+                // The last element has to end inside the view, and the view inside the buffer
+                const bool viewFits = buffer.data && viewOffset <= buffer.size && viewLength <= buffer.size - viewOffset;
+                const bool accessorFits = result.count == 0 ||
+                                          (offset <= viewLength && elementSize <= viewLength - offset &&
+                                           result.count - 1 <= (viewLength - offset - elementSize) / result.stride);
+                if (!viewFits || !accessorFits)
+                    throw std::runtime_error("glTF accessor " + std::to_string(index) + " exceeds its buffer");
+
+                result.data = buffer.data + viewOffset + offset;
+                return result;
+            }
+
+        private:
+            Utils::MappedFile m_File;
+            json m_Json;
+            std::vector<Buffer> m_Buffers;
+            std::vector<Utils::MappedFile> m_ExternalFiles;
+            std::vector<std::vector<unsigned char>> m_EmbeddedData;
+        };
+
+        /**
+         * @brief Collects the primitives of all mesh nodes with their world transforms
+         */
+        void CollectPrimitives(const json &document, std::size_t nodeIndex, const Math::Mat4 &parent, std::vector<PrimitiveInstance> &output, int depth)
+        {
+            // Guards against cyclic hierarchies in malformed files
+            if (depth > 256)
+                throw std::runtime_error("glTF node hierarchy is too deep");
+
+            const json &node = document.at("nodes").at(nodeIndex);
+            const Math::Mat4 world = GetLocalTransform(node) * parent;
+            if (node.contains("mesh"))
+            {
+                const std::size_t meshIndex = node["mesh"].get<std::size_t>();
+                const json &mesh = document.at("meshes").at(meshIndex);
+                const json &primitives = mesh.at("primitives");
+                std::string baseName = node.value("name", std::string());
+                if (baseName.empty())
+                    baseName = mesh.value("name", std::string());
+                if (baseName.empty())
+                    baseName = "Mesh_" + std::to_string(meshIndex);
+
+                for (std::size_t i = 0; i < primitives.size(); ++i)
+                {
+                    PrimitiveInstance instance{&primitives[i], world, baseName, std::string()};
+                    if (primitives.size() > 1)
+                        instance.name += "_" + std::to_string(i);
+                    if (primitives[i].contains("material"))
+                    {
+                        const json &material = document.at("materials").at(primitives[i]["material"].get<std::size_t>());
+                        instance.materialName = material.value("name", std::string());
+                    }
+                    output.push_back(std::move(instance));
+                }
+            }
+
+            for (const json &child : node.value("children", json::array()))
+            {
+                CollectPrimitives(document, child.get<std::size_t>(), world, output, depth + 1);
+            }
+        }
+
+        /**
+         * @brief Builds the triangle list of a primitive, reading the index accessor in place
+         */
+        std::vector<unsigned int> ReadTriangles(const Document &document, const json &primitive, std::size_t vertexCount)
+        {
+            const int mode = primitive.value("mode", MODE_TRIANGLES);
+            if (mode != MODE_TRIANGLES && mode != MODE_TRIANGLE_STRIP && mode != MODE_TRIANGLE_FAN)
+                return {}; // Points and lines are not rendered
+
+            Accessor indices;
+            const bool indexed = primitive.contains("indices");
+            if (indexed)
+            {
+                indices = document.GetAccessor(primitive["indices"].get<std::size_t>());
+                if (indices.componentType != COMPONENT_UNSIGNED_BYTE && indices.componentType != COMPONENT_UNSIGNED_SHORT &&
+                    indices.componentType != COMPONENT_UNSIGNED_INT)
+                    throw std::runtime_error("glTF index accessor has an invalid component type");
+            }
+            const std::size_t count = indexed ? indices.count : vertexCount;
+            auto getIndex = [&](std::size_t i) -> std::uint32_t
+            { return indexed ? indices.ReadIndex(i) : static_cast<std::uint32_t>(i); };
+
+            std::vector<unsigned int> result;
+            if (mode == MODE_TRIANGLES)
+            {
+                result.resize(count - count % 3);
+                if (indexed && indices.data && indices.IsPacked(COMPONENT_UNSIGNED_INT, 1))
+                {
+                    std::memcpy(result.data(), indices.data, result.size() * sizeof(unsigned int));
+                }
+                else
+                {
+                    for (std::size_t i = 0; i < result.size(); ++i)
+                        result[i] = getIndex(i);
+                }
+            }
+            else if (count >= 3)
+            {
+                result.reserve((count - 2) * 3);
+                for (std::size_t i = 2; i < count; ++i)
+                {
+                    if (mode == MODE_TRIANGLE_FAN)
+                        result.insert(result.end(), {getIndex(0), getIndex(i - 1), getIndex(i)});
+                    else if (i % 2 == 0)
+                        result.insert(result.end(), {getIndex(i - 2), getIndex(i - 1), getIndex(i)});
+                    else
+                        result.insert(result.end(), {getIndex(i - 1), getIndex(i - 2), getIndex(i)}); // Keep the winding
+                }
+            }
+
+            for (unsigned int index : result)
+            {
+                if (index >= vertexCount)
+                    throw std::runtime_error("glTF primitive references a missing vertex");
+            }
+            return result;
+        }
+
+        /**
+         * @brief Finds the vertex format the shader can read an attribute in, straight from the file
+         * @param size Bytes the attribute occupies in its vertex, including padding up to the next attribute
+         * @param valueScale Receives the factor from the format's decoded values to the stored ones,
+         *                   which is not one for integers read as normalized values
+         * @return False if no format matches
+         */
+        bool GetVertexFormat(const Accessor &accessor, std::size_t size, VertexFormat &format, float &valueScale)
+        {
+            const int components = accessor.componentCount;
+            valueScale = 1.0f;
+            switch (accessor.componentType)
+            {
+            case COMPONENT_FLOAT:
+                if (components > 4)
+                    return false;
+                format = static_cast<VertexFormat>(static_cast<int>(VertexFormat::Float1) + components - 1);
+                break;
+            case COMPONENT_UNSIGNED_BYTE:
+                if (components < 3 || components > 4)
+                    return false;
+                format = VertexFormat::UNorm8x4;
+                valueScale = accessor.normalized ? 1.0f : 255.0f;
+                break;
+            case COMPONENT_UNSIGNED_SHORT:
+                if (components < 2 || components > 4)
+                    return false;
+                format = components == 2 ? VertexFormat::UNorm16x2 : VertexFormat::UNorm16x4;
+                valueScale = accessor.normalized ? 1.0f : 65535.0f;
+                break;
+            case COMPONENT_SHORT:
+                // Unnormalized values cannot be scaled back exactly: the GPU reads -32768 as -32767
+                if (!accessor.normalized || components < 2 || components > 4)
+                    return false;
+                format = components == 2 ? VertexFormat::SNorm16x2 : VertexFormat::SNorm16x4;
+                break;
+            default:
+                return false;
+            }
+            return VertexLayout::GetFormatSize(format) == size && accessor.GetElementSize() <= size;
+        }
+
+        /**
+         * @brief Applies a node transform to float positions and normals in place
+         *
+         * Normals use the inverse transpose so non-uniform scale keeps them perpendicular; normals
+         * in other formats are left as they are, so the transform must not rotate them.
+         */
+        void BakeTransform(MeshData &mesh, const Math::Mat4 &world)
+        {
+            const VertexLayout &layout = mesh.layout;
+            const VertexElement *normal = layout.Find(VertexAttribute::Normal);
+            const bool hasFloatNormals = normal && normal->format == VertexFormat::Float3;
+            const std::size_t stride = layout.GetFloatStride();
+            const std::size_t positionOffset = layout.Find(VertexAttribute::Position)->offset / sizeof(float);
+            const std::size_t normalOffset = hasFloatNormals ? normal->offset / sizeof(float) : 0;
+            const std::size_t vertexCount = layout.GetVertexCount(mesh.vertices);
+
+            const Math::Mat4 normalMatrix = world.Inverse();
+            const float *m = world.data;
+            const float *inverse = normalMatrix.data;
+            for (std::size_t i = 0; i < vertexCount; ++i)
+            {
+                float *vertex = mesh.vertices.data() + i * stride;
+                float *position = vertex + positionOffset;
+                const float p[3] = {position[0], position[1], position[2]};
+                for (int row = 0; row < 3; ++row)
+                    position[row] = m[row] * p[0] + m[4 + row] * p[1] + m[8 + row] * p[2] + m[12 + row];
+
+                if (!hasFloatNormals)
+                    continue;
+                float *vertexNormal = vertex + normalOffset;
+                const float n[3] = {vertexNormal[0], vertexNormal[1], vertexNormal[2]};
+                float transformed[3];
+                for (int row = 0; row < 3; ++row)
+                    transformed[row] = inverse[row * 4] * n[0] + inverse[row * 4 + 1] * n[1] + inverse[row * 4 + 2] * n[2];
+                const float length = std::sqrt(transformed[0] * transformed[0] + transformed[1] * transformed[1] + transformed[2] * transformed[2]);
+                for (int row = 0; row < 3; ++row)
+                    vertexNormal[row] = length > 0.0f ? transformed[row] / length : transformed[row];
+            }
+
+            // Mirroring transforms flip the winding
+            const float determinant = m[0] * (m[5] * m[10] - m[9] * m[6]) - m[4] * (m[1] * m[10] - m[9] * m[2]) + m[8] * (m[1] * m[6] - m[5] * m[2]);
+            if (determinant < 0.0f)
+            {
+                for (std::size_t i = 0; i + 2 < mesh.indices.size(); i += 3)
+                    std::swap(mesh.indices[i + 1], mesh.indices[i + 2]);
+            }
+        }
+
+        /**
+         * @brief Copies the vertices of a primitive whose attributes interleave in one buffer view
+         *
+         * The attributes have to fill each vertex without gaps, in formats the shader reads as
+         * stored, so quantized data (KHR_mesh_quantization) keeps its size. The mesh gets the
+         * file's layout; a node transform is baked into float positions, or folded into the
+         * position decode of quantized ones if it is a uniform scale and translation.
+         * @return False if the vertices have to be converted to the standard layout instead
+         */
+        bool CopyInterleaved(const Accessor &positions, const Accessor &normals, const Accessor *texCoords, const Math::Mat4 &world, MeshData &mesh)
+        {
+            struct Stream
+            {
+                const Accessor *accessor;
+                VertexAttribute attribute;
+                int componentCount;
+            };
+            std::vector<Stream> streams = {{&positions, VertexAttribute::Position, 3}, {&normals, VertexAttribute::Normal, 3}};
+            if (texCoords)
+                streams.push_back({texCoords, VertexAttribute::TexCoord, 2});
+            for (const Stream &stream : streams)
+            {
+                if (!stream.accessor->data || stream.accessor->stride != positions.stride || stream.accessor->componentCount != stream.componentCount)
+                    return false;
+            }
+
+            // Attributes in the order they are stored in a vertex, the first starting it
+            std::sort(streams.begin(), streams.end(), [](const Stream &a, const Stream &b)
+                      { return a.accessor->data < b.accessor->data; });
+            const unsigned char *base = streams.front().accessor->data;
+            const std::size_t stride = positions.stride;
+            VertexLayout layout;
+            float positionScale = 1.0f;
+            std::size_t usedBytes = 0; // Of the last vertex, whose padding may lie outside the buffer
+            for (std::size_t i = 0; i < streams.size(); ++i)
+            {
+                const Accessor &accessor = *streams[i].accessor;
+                const std::size_t offset = static_cast<std::size_t>(accessor.data - base);
+                const std::size_t end = i + 1 < streams.size() ? static_cast<std::size_t>(streams[i + 1].accessor->data - base) : stride;
+                VertexFormat format;
+                float valueScale;
+                if (offset != layout.GetStride() || end > stride || !GetVertexFormat(accessor, end - offset, format, valueScale))
+                    return false;
+                if (valueScale != 1.0f && streams[i].attribute != VertexAttribute::Position)
+                    return false; // Only positions have a decode to undo the scale
+                if (streams[i].attribute == VertexAttribute::Position)
+                    positionScale = valueScale;
+                layout.Add(streams[i].attribute, format);
+                usedBytes = offset + accessor.GetElementSize();
+            }
+            if (layout.GetStride() != stride)
+                return false;
+
+            const bool floatPositions = layout.Find(VertexAttribute::Position)->format == VertexFormat::Float3 && positionScale == 1.0f;
+            const bool floatNormals = layout.Find(VertexAttribute::Normal)->format == VertexFormat::Float3;
+            const float *m = world.data;
+            const bool isIdentity = IsIdentity(world);
+            if (!isIdentity && !(floatPositions && floatNormals))
+            {
+                const bool uniformScale = m[1] == 0.0f && m[2] == 0.0f && m[4] == 0.0f && m[6] == 0.0f && m[8] == 0.0f && m[9] == 0.0f &&
+                                          m[0] > 0.0f && m[0] == m[5] && m[0] == m[10];
+                if (!uniformScale)
+                    return false;
+            }
+
+            const std::size_t vertexCount = positions.count;
+            mesh.vertices.resize(vertexCount * layout.GetFloatStride());
+            std::memcpy(mesh.vertices.data(), base, (vertexCount - 1) * stride + usedBytes);
+            if (floatPositions)
+            {
+                mesh.layout = layout;
+                if (!isIdentity)
+                    BakeTransform(mesh, world);
+                return true;
+            }
+
+            const float scale = isIdentity ? positionScale : m[0] * positionScale;
+            const Math::Vec3 offset = isIdentity ? Math::Vec3(0.0f, 0.0f, 0.0f) : Math::Vec3(m[12], m[13], m[14]);
+            layout.SetPositionDecode(offset, Math::Vec3(scale, scale, scale));
+            mesh.layout = layout;
+            return true;
+        }
+
+        MeshData BuildPrimitive(const Document &document, const PrimitiveInstance &instance)
+        {
+            const json &attributes = instance.primitive->at("attributes");
+            if (!attributes.contains("POSITION"))
+                return {};
+
+            const Accessor positions = document.GetAccessor(attributes["POSITION"].get<std::size_t>());
+            Accessor normals, texCoords;
+            const bool hasNormals = attributes.contains("NORMAL");
+            const bool hasTexCoords = attributes.contains("TEXCOORD_0");
+            if (hasNormals)
+                normals = document.GetAccessor(attributes["NORMAL"].get<std::size_t>());
+            if (hasTexCoords)
+                texCoords = document.GetAccessor(attributes["TEXCOORD_0"].get<std::size_t>());
+            if ((hasNormals && normals.count != positions.count) || (hasTexCoords && texCoords.count != positions.count))
+                throw std::runtime_error("glTF primitive attributes differ in length");
+
+            MeshData mesh;
+            mesh.name = instance.name;
+            mesh.materialName = instance.materialName;
+            mesh.indices = ReadTriangles(document, *instance.primitive, positions.count);
+            if (mesh.indices.empty())
+                return {};
+
+            // Interleaved files are uploaded in their own layout
+            if (hasNormals && CopyInterleaved(positions, normals, hasTexCoords ? &texCoords : nullptr, instance.world, mesh))
+                return mesh;
+
+            const std::size_t vertexCount = positions.count;
+            mesh.vertices.resize(vertexCount * 8);
+            float *output = mesh.vertices.data();
+            const bool packedPositions = positions.data && positions.componentType == COMPONENT_FLOAT && positions.componentCount == 3;
+            const bool packedNormals = normals.data && normals.componentType == COMPONENT_FLOAT && normals.componentCount == 3;
+            const bool packedTexCoords = texCoords.data && texCoords.componentType == COMPONENT_FLOAT && texCoords.componentCount == 2;
+            for (std::size_t i = 0; i < vertexCount; ++i)
+            {
+                float *vertex = output + i * 8;
+                if (packedPositions)
+                {
+                    std::memcpy(vertex, positions.data + i * positions.stride, 3 * sizeof(float));
+                }
+                else
+                {
+                    for (int c = 0; c < 3; ++c)
+                        vertex[c] = positions.ReadFloat(i, c);
+                }
+
+                if (packedNormals)
+                {
+                    std::memcpy(vertex + 3, normals.data + i * normals.stride, 3 * sizeof(float));
+                }
+                else if (hasNormals)
+                {
+                    for (int c = 0; c < 3; ++c)
+                        vertex[3 + c] = normals.ReadFloat(i, c);
+                }
+
+                if (packedTexCoords)
+                {
+                    std::memcpy(vertex + 6, texCoords.data + i * texCoords.stride, 2 * sizeof(float));
+                }
+                else if (hasTexCoords)
+                {
+                    vertex[6] = texCoords.ReadFloat(i, 0);
+                    vertex[7] = texCoords.ReadFloat(i, 1);
+                }
+            }
+
+            if (!IsIdentity(instance.world))
+                BakeTransform(mesh, instance.world);
+            if (!hasNormals)
+                MeshLoader::GenerateSmoothNormals(mesh);
+            return mesh;
+        }
+    }
+
+    bool GltfLoader::CanLoad(const std::string &extension) const
+    {
+        std::string ext = extension;
+        std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+        return ext == ".gltf" || ext == ".glb";
+    }
+
+    std::vector<MeshData> GltfLoader::LoadMeshData(const std::string &filepath)
+    {
+        const Document document(filepath);
+        if (!document.IsSupported())
+            return AssimpLoader().LoadMeshData(filepath);
+
+        // Walk the default scene, or every root node if the file names none
+        const json &root = document.GetJson();
+        std::vector<PrimitiveInstance> instances;
+        std::vector<std::size_t> rootNodes;
+        if (root.contains("scenes") && !root["scenes"].empty())
+        {
+            const json &scene = root["scenes"].at(root.value("scene", std::size_t(0)));
+            for (const json &node : scene.value("nodes", json::array()))
+                rootNodes.push_back(node.get<std::size_t>());
+        }
+        else if (root.contains("nodes"))
+        {
+            const std::size_t nodeCount = root["nodes"].size();
+            std::vector<bool> isChild(nodeCount, false);
+            for (const json &node : root["nodes"])
+            {
+                for (const json &child : node.value("children", json::array()))
+                    isChild.at(child.get<std::size_t>()) = true;
+            }
+            for (std::size_t i = 0; i < nodeCount; ++i)
+            {
+                if (!isChild[i])
+                    rootNodes.push_back(i);
+            }
+        }
+        for (std::size_t node : rootNodes)
+        {
+            CollectPrimitives(root, node, Math::Mat4::Identity(), instances, 0);
+        }
+
+        std::vector<MeshData> converted(instances.size());
+        Utils::ThreadPool::GetInstance().ParallelFor(instances.size(), [&](std::size_t i)
+                                                     { converted[i] = BuildPrimitive(document, instances[i]); });
+
+        std::vector<MeshData> result;
+        for (MeshData &mesh : converted)
+        {
+            if (!mesh.indices.empty())
+                result.push_back(std::move(mesh));
+        }
+
+        std::cout << "Loaded " << result.size() << " meshes from glTF file: " << filepath << std::endl;
+        return result;
+    }
+}
@@ -0,0 +1,252 @@
+#include "MeshCache.h"
+#include <algorithm>
+#include <filesystem>
+
+namespace Voltray::Engine
+{
+    namespace
+    {
+        std::size_t GetByteSize(const std::vector<MeshData> &meshData)
+        {
+            std::size_t bytes = 0;
+            for (const auto &data : meshData)
+            {
+                bytes += data.vertices.size() * sizeof(float) + data.indices.size() * sizeof(unsigned int);
+                bytes += data.name.size() + data.materialName.size();
+            }
+            return bytes;
+        }
+    }
+
+    MeshCache &MeshCache::GetInstance()
+    {
+        // Never destroyed, so meshes released during static destruction can still report back
+        static MeshCache *instance = new MeshCache();
+        return *instance;
+    }
+
+    std::vector<std::shared_ptr<Mesh>> MeshCache::Find(const std::string &filepath, bool compressedVertices)
+    {
+        FileKey key;
+        const bool exists = GetFileKey(filepath, compressedVertices, key);
+
+        // Declared before the lock so a mesh dropped on the way out is released after unlocking
+        std::vector<std::shared_ptr<Mesh>> meshes;
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (!exists)
+        {
+            ++m_Misses;
+            return {};
+        }
+
+        auto live = m_Live.find(key.name);
+        if (live != m_Live.end())
+        {
+            LiveEntry &entry = live->second;
+            bool complete = entry.key.IsSameVersion(key);
+            for (std::size_t slot = 0; complete && slot < entry.meshes.size(); ++slot)
+            {
+                if (auto mesh = entry.meshes[slot].lock())
+                {
+                    meshes.push_back(std::move(mesh));
+                }
+                else if (entry.isReleased[slot])
+                {
+                    // Another mesh of the file is still in use; rebuild this one from its data
+                    auto rebuilt = CreateMesh(entry, slot, entry.released[slot]);
+                    entry.meshes[slot] = rebuilt;
+                    entry.released[slot] = MeshData();
+                    entry.isReleased[slot] = 0;
+                    --entry.releasedCount;
+                    meshes.push_back(std::move(rebuilt));
+                }
+                else
+                {
+                    // Destroyed but not reported back yet
+                    complete = false;
+                }
+            }
+
+            if (complete)
+            {
+                ++m_Hits;
+                return meshes;
+            }
+
+            // Outdated: meshes still in use keep working but are no longer handed out
+            m_Live.erase(live);
+        }
+
+        auto cached = m_LruIndex.find(key.name);
+        if (cached != m_LruIndex.end())
+        {
+            const LruList::iterator entry = cached->second;
+            m_LruIndex.erase(cached);
+            m_ResidentBytes -= entry->bytes;
+
+            std::vector<MeshData> meshData = std::move(entry->meshData);
+            const bool upToDate = entry->key.IsSameVersion(key);
+            m_Lru.erase(entry);
+            if (upToDate)
+            {
+                ++m_Hits;
+                return Register(key, std::move(meshData));
+            }
+        }
+
+        ++m_Misses;
+        return {};
+    }
+
+    std::vector<std::shared_ptr<Mesh>> MeshCache::Insert(const std::string &filepath, bool compressedVertices, std::vector<MeshData> meshData)
+    {
+        meshData.erase(std::remove_if(meshData.begin(), meshData.end(), [](const MeshData &data)
+                                      { return data.vertices.empty() || data.indices.empty(); }),
+                       meshData.end());
+        if (meshData.empty())
+            return {};
+
+        FileKey key;
+        if (!GetFileKey(filepath, compressedVertices, key))
+        {
+            // Nothing to key the data on, hand out uncached meshes
+            std::vector<std::shared_ptr<Mesh>> meshes;
+            for (const auto &data : meshData)
+            {
+                meshes.push_back(std::make_shared<Mesh>(data.vertices, data.indices, data.layout));
+            }
+            return meshes;
+        }
+
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        auto cached = m_LruIndex.find(key.name);
+        if (cached != m_LruIndex.end())
+        {
+            m_ResidentBytes -= cached->second->bytes;
+            m_Lru.erase(cached->second);
+            m_LruIndex.erase(cached);
+        }
+        return Register(key, std::move(meshData));
+    }
+
+    void MeshCache::SetMemoryBudget(std::size_t bytes)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_BudgetBytes = bytes;
+        TrimToBudget();
+    }
+
+    void MeshCache::Clear()
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Live.clear();
+        m_Lru.clear();
+        m_LruIndex.clear();
+        m_ResidentBytes = 0;
+    }
+
+    MeshCache::Stats MeshCache::GetStats() const
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        Stats stats;
+        stats.hits = m_Hits;
+        stats.misses = m_Misses;
+        stats.residentBytes = m_ResidentBytes;
+        stats.budgetBytes = m_BudgetBytes;
+        stats.liveFiles = m_Live.size();
+        stats.cachedFiles = m_Lru.size();
+        return stats;
+    }
+
+    bool MeshCache::GetFileKey(const std::string &filepath, bool compressedVertices, FileKey &key)
+    {
+        std::error_code error;
+        const std::filesystem::path path = std::filesystem::weakly_canonical(filepath, error);
+        if (error)
+            return false;
+
+        const auto modifiedTime = std::filesystem::last_write_time(path, error);
+        if (error)
+            return false;
+
+        const std::uintmax_t size = std::filesystem::file_size(path, error);
+        if (error)
+            return false;
+
+        key.path = path.string();
+        key.modifiedTime = static_cast<std::int64_t>(modifiedTime.time_since_epoch().count());
+        key.size = size;
+        key.name = compressedVertices ? key.path + "|compressed" : key.path;
+        return true;
+    }
+
+    std::vector<std::shared_ptr<Mesh>> MeshCache::Register(const FileKey &key, std::vector<MeshData> meshData)
+    {
+        LiveEntry &entry = m_Live[key.name];
+        entry = LiveEntry();
+        entry.key = key;
+        entry.id = m_NextId++;
+        entry.released.resize(meshData.size());
+        entry.isReleased.assign(meshData.size(), 0);
+
+        std::vector<std::shared_ptr<Mesh>> meshes;
+        meshes.reserve(meshData.size());
+        for (std::size_t slot = 0; slot < meshData.size(); ++slot)
+        {
+            auto mesh = CreateMesh(entry, slot, meshData[slot]);
+            entry.meshes.push_back(mesh);
+            meshes.push_back(std::move(mesh));
+        }
+        return meshes;
+    }
+
+    std::shared_ptr<Mesh> MeshCache::CreateMesh(const LiveEntry &entry, std::size_t slot, const MeshData &data)
+    {
+        return std::shared_ptr<Mesh>(
+            new Mesh(data.vertices, data.indices, data.layout),
+            [entryName = entry.key.name, id = entry.id, slot, name = data.name, materialName = data.materialName](Mesh *mesh)
+            {
+                MeshData released{mesh->GetVertices(), mesh->GetIndices(), name, materialName, mesh->GetLayout()};
+                delete mesh;
+                MeshCache::GetInstance().OnMeshReleased(entryName, id, slot, std::move(released));
+            });
+    }
+
+    void MeshCache::OnMeshReleased(const std::string &name, std::uint64_t id, std::size_t slot, MeshData data)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        auto live = m_Live.find(name);
+        if (live == m_Live.end() || live->second.id != id)
+            return;
+
+        LiveEntry &entry = live->second;
+        entry.released[slot] = std::move(data);
+        entry.isReleased[slot] = 1;
+        if (++entry.releasedCount < entry.meshes.size())
+            return;
+
+        // Last mesh of the file is gone, keep its data for a later reload
+        CachedEntry cached;
+        cached.key = std::move(entry.key);
+        cached.meshData = std::move(entry.released);
+        cached.bytes = GetByteSize(cached.meshData);
+        m_Live.erase(live);
+        if (cached.bytes > m_BudgetBytes)
+            return;
+
+        m_ResidentBytes += cached.bytes;
+        m_Lru.push_front(std::move(cached));
+        m_LruIndex[name] = m_Lru.begin();
+        TrimToBudget();
+    }
+
+    void MeshCache::TrimToBudget()
+    {
+        while (m_ResidentBytes > m_BudgetBytes && !m_Lru.empty())
+        {
+            m_ResidentBytes -= m_Lru.back().bytes;
+            m_LruIndex.erase(m_Lru.back().key.name);
+            m_Lru.pop_back();
+        }
+    }
+}
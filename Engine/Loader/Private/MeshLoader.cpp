@@ -1,11 +1,29 @@
 #include "MeshLoader.h"
+#include "MeshCache.h"
+#include "CookedMeshCache.h"
+#include "EngineSettings.h"
+#include "GltfLoader.h"
 #include "IFormatLoader.h"
+#include "ObjLoader.h"
+#include "PlyLoader.h"
+#include "StlLoader.h"
+#include "ThreadPool.h"
+#include "VertexCompressor.h"
 #include <filesystem>
 #include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <stdexcept>
+#include <unordered_map>
 
 namespace Voltray::Engine
 {
+    namespace
+    {
+        // Set in the import settings key of compressed imports, so they are cooked separately
+        constexpr std::uint64_t COMPRESSED_SETTINGS_BIT = 1ull << 63;
+    }
+
     std::shared_ptr<Mesh> MeshLoader::LoadMesh(const std::string &filepath)
     {
         auto meshes = LoadMeshes(filepath);
@@ -20,47 +38,75 @@ namespace Voltray::Engine
 
     std::vector<std::shared_ptr<Mesh>> MeshLoader::LoadMeshes(const std::string &filepath)
     {
-        std::vector<std::shared_ptr<Mesh>> meshes;
-        if (!std::filesystem::exists(filepath))
-        {
-            std::cerr << "Error: File does not exist: " << filepath << std::endl;
+        const bool compress = EngineSettings::CompressVertices;
+        auto &cache = MeshCache::GetInstance();
+        auto meshes = cache.Find(filepath, compress);
+        if (!meshes.empty())
             return meshes;
-        }
-        if (!IsFormatSupported(filepath))
+
+        return cache.Insert(filepath, compress, LoadMeshData(filepath, compress));
+    }
+
+    std::vector<std::shared_ptr<Mesh>> MeshLoader::LoadMeshBatch(const std::vector<std::string> &filepaths)
+    {
+        // Map each input to its distinct path
+        std::unordered_map<std::string, size_t> uniqueIndices;
+        std::vector<size_t> inputToUnique;
+        inputToUnique.reserve(filepaths.size());
+        for (const auto &filepath : filepaths)
         {
-            std::cerr << "Error: Unsupported file format: " << filepath << std::endl;
-            return meshes;
+            auto it = uniqueIndices.emplace(filepath, uniqueIndices.size()).first;
+            inputToUnique.push_back(it->second);
         }
 
-        auto meshData = LoadMeshData(filepath);
-
-        for (const auto &data : meshData)
+        // Serve cached files directly and parse the rest on the pool, indexed like the distinct paths
+        const bool compress = EngineSettings::CompressVertices;
+        auto &cache = MeshCache::GetInstance();
+        std::vector<std::shared_ptr<Mesh>> uniqueMeshes(uniqueIndices.size());
+        std::vector<std::future<std::vector<MeshData>>> parsed(uniqueIndices.size());
+        for (const auto &entry : uniqueIndices)
         {
-            if (!data.vertices.empty() && !data.indices.empty())
+            auto cached = cache.Find(entry.first, compress);
+            if (!cached.empty())
             {
-                auto mesh = std::make_shared<Mesh>(data.vertices, data.indices);
-                meshes.push_back(mesh);
+                uniqueMeshes[entry.second] = cached[0];
+                continue;
             }
+            parsed[entry.second] = Utils::ThreadPool::GetInstance().Submit([filepath = entry.first, compress]()
+                                                                          { return LoadMeshData(filepath, compress); });
         }
 
+        // Create GL buffers here as each file finishes, while later files are still parsing
+        for (const auto &entry : uniqueIndices)
+        {
+            auto &pending = parsed[entry.second];
+            if (!pending.valid())
+                continue;
+
+            auto meshes = cache.Insert(entry.first, compress, pending.get());
+            if (!meshes.empty())
+                uniqueMeshes[entry.second] = meshes[0];
+        }
+
+        std::vector<std::shared_ptr<Mesh>> meshes;
+        meshes.reserve(filepaths.size());
+        for (size_t index : inputToUnique)
+        {
+            meshes.push_back(uniqueMeshes[index]);
+        }
         return meshes;
     }
 
     std::vector<MeshData> MeshLoader::LoadMeshData(const std::string &filepath)
+    {
+        return LoadMeshData(filepath, EngineSettings::CompressVertices);
+    }
+
+    std::vector<MeshData> MeshLoader::LoadMeshData(const std::string &filepath, bool compressVertices)
     {
         try
         {
-            std::string extension = GetFileExtension(filepath);
-            auto loader = GetLoaderForExtension(extension);
-
-            if (!loader)
-            {
-                std::cerr << "Error: No loader available for extension: " << extension << std::endl;
-                return {};
-            }
-
-            std::cout << "Using " << loader->GetLoaderName() << " for file: " << filepath << std::endl;
-            return loader->LoadMeshData(filepath);
+            return ImportMeshData(filepath, compressVertices);
         }
         catch (const std::exception &e)
         {
@@ -69,6 +115,111 @@ namespace Voltray::Engine
         }
     }
 
+    std::vector<MeshData> MeshLoader::ImportMeshData(const std::string &filepath, bool compressVertices)
+    {
+        if (!std::filesystem::exists(filepath))
+        {
+            throw std::runtime_error("File does not exist: " + filepath);
+        }
+
+        std::string extension = GetFileExtension(filepath);
+        auto loader = GetLoaderForExtension(extension);
+        if (!loader)
+        {
+            throw std::runtime_error("Unsupported file format: " + filepath);
+        }
+
+        // Reuse the processed result of an earlier import of the same contents and settings
+        std::uint64_t settingsKey = loader->GetImportSettingsKey();
+        if (settingsKey != 0 && compressVertices)
+            settingsKey |= COMPRESSED_SETTINGS_BIT;
+        CookedMeshCache::SourceKey cookedKey;
+        const bool cookable = settingsKey != 0 && !CookedMeshCache::GetDirectory().empty() &&
+                              CookedMeshCache::GetSourceKey(filepath, settingsKey, cookedKey);
+        std::vector<MeshData> meshData;
+        if (cookable && CookedMeshCache::Load(cookedKey, meshData))
+        {
+            std::cout << "Using cooked mesh for file: " << filepath << std::endl;
+            return meshData;
+        }
+
+        std::cout << "Using " << loader->GetLoaderName() << " for file: " << filepath << std::endl;
+        meshData = loader->LoadMeshData(filepath);
+        if (compressVertices)
+        {
+            CompressVertices(meshData);
+        }
+        if (cookable && !meshData.empty())
+        {
+            CookedMeshCache::Store(cookedKey, meshData);
+        }
+        return meshData;
+    }
+
+    void MeshLoader::CompressVertices(std::vector<MeshData> &meshData)
+    {
+        std::vector<VertexCompressionReport> reports(meshData.size());
+        Utils::ThreadPool::GetInstance().ParallelFor(meshData.size(), [&](std::size_t i)
+                                                     { reports[i] = VertexCompressor::Compress(meshData[i]); });
+
+        for (const VertexCompressionReport &report : reports)
+        {
+            std::cout << report.ToString() << std::endl;
+        }
+    }
+
+    void MeshLoader::GenerateSmoothNormals(MeshData &meshData)
+    {
+        const VertexLayout &layout = meshData.layout;
+        const VertexElement *normalElement = layout.Find(VertexAttribute::Normal);
+        if (!layout.HasInPlacePositions() || !normalElement || normalElement->format != VertexFormat::Float3)
+            return;
+
+        const std::size_t stride = layout.GetFloatStride();
+        const std::size_t normalOffset = normalElement->offset / sizeof(float);
+        std::vector<float> &vertices = meshData.vertices;
+        const std::size_t vertexCount = layout.GetVertexCount(vertices);
+        for (std::size_t vertex = 0; vertex < vertexCount; ++vertex)
+        {
+            std::fill_n(&vertices[vertex * stride + normalOffset], 3, 0.0f);
+        }
+
+        // Unnormalized face normals have the length of twice the triangle area, which weights them
+        const std::vector<unsigned int> &indices = meshData.indices;
+        for (std::size_t i = 0; i + 2 < indices.size(); i += 3)
+        {
+            const float *a = &vertices[indices[i] * stride];
+            const float *b = &vertices[indices[i + 1] * stride];
+            const float *c = &vertices[indices[i + 2] * stride];
+            const float e1[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+            const float e2[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+            const float normal[3] = {e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0]};
+            for (std::size_t corner = 0; corner < 3; ++corner)
+            {
+                float *sum = &vertices[indices[i + corner] * stride + normalOffset];
+                sum[0] += normal[0];
+                sum[1] += normal[1];
+                sum[2] += normal[2];
+            }
+        }
+
+        for (std::size_t vertex = 0; vertex < vertexCount; ++vertex)
+        {
+            float *normal = &vertices[vertex * stride + normalOffset];
+            const float length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+            if (length > 0.0f)
+            {
+                normal[0] /= length;
+                normal[1] /= length;
+                normal[2] /= length;
+            }
+            else
+            {
+                normal[1] = 1.0f;
+            }
+        }
+    }
+
     bool MeshLoader::IsFormatSupported(const std::string &filepath)
     {
         std::string extension = GetFileExtension(filepath);
@@ -167,12 +318,15 @@ namespace Voltray::Engine
 
     std::vector<std::shared_ptr<IFormatLoader>> MeshLoader::GetAllLoaders()
     {
-        static std::vector<std::shared_ptr<IFormatLoader>> loaders; // Initialize loaders only once
-        if (loaders.empty())
-        {
+        // Initialized once; static initialization is thread-safe, so batch loads can query it from workers
+        // Loaders are tried in order, so native fast paths come before the Assimp fallback
+        static const std::vector<std::shared_ptr<IFormatLoader>> loaders = {
+            std::make_shared<GltfLoader>(),
+            std::make_shared<ObjLoader>(),
+            std::make_shared<PlyLoader>(),
+            std::make_shared<StlLoader>(),
             // Add Assimp loader (comprehensive, handles all formats including OBJ)
-            loaders.push_back(std::make_shared<AssimpLoader>());
-        }
+            std::make_shared<AssimpLoader>()};
 
         return loaders;
     }
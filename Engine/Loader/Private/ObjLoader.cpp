@@ -0,0 +1,672 @@
+#include "ObjLoader.h"
+#include "MappedFile.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace Voltray::Engine
+{
+    namespace
+    {
+        constexpr std::int32_t MISSING_INDEX = std::numeric_limits<std::int32_t>::min();
+        constexpr std::uint32_t EMPTY_SLOT = std::numeric_limits<std::uint32_t>::max();
+
+        // Smaller files are parsed on the calling thread alone
+        constexpr std::size_t MIN_CHUNK_SIZE = 1 << 20;
+
+        // Bits of Corner::relative, set for negative indices counted back from the chunk's own elements
+        enum RelativeIndex : std::uint8_t
+        {
+            RELATIVE_POSITION = 1 << 0,
+            RELATIVE_TEXCOORD = 1 << 1,
+            RELATIVE_NORMAL = 1 << 2,
+        };
+
+        struct Corner
+        {
+            std::int32_t position;
+            std::int32_t texCoord; ///< MISSING_INDEX if the face has no texture coordinates
+            std::int32_t normal;   ///< MISSING_INDEX if the face has no normals
+            std::uint8_t relative;
+        };
+
+        struct Face
+        {
+            std::uint32_t firstCorner;
+            std::uint32_t cornerCount;
+            std::int32_t material; ///< Index into Chunk::materials, -1 until the chunk's first usemtl
+        };
+
+        /**
+         * @brief Everything parsed from one range of lines
+         */
+        struct Chunk
+        {
+            const char *begin = nullptr;
+            const char *end = nullptr;
+            std::vector<float> positions; // xyz
+            std::vector<float> texCoords; // uv
+            std::vector<float> normals;   // xyz
+            std::vector<Corner> corners;
+            std::vector<Face> faces;
+            std::vector<std::string> materials;
+            std::vector<std::int32_t> globalMaterials; ///< Chunk material index to file material index
+            std::int32_t inheritedMaterial = 0;         ///< Material active where the chunk starts
+            std::int32_t lastMaterial = -1;             ///< Index into materials active where the chunk ends, -1 without usemtl
+            std::string objectName;                     ///< First o or g name in the chunk
+            std::size_t positionBase = 0, texCoordBase = 0, normalBase = 0;
+        };
+
+        inline bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+        inline bool IsSpace(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+        const char *SkipSpaces(const char *p, const char *end)
+        {
+            while (p < end && IsSpace(*p))
+                ++p;
+            return p;
+        }
+
+        double PowerOfTen(int exponent)
+        {
+            // Exactly representable powers, the common case for mesh data
+            static constexpr double exact[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                               1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+            if (exponent >= 0 && exponent <= 22)
+                return exact[exponent];
+            return std::pow(10.0, exponent);
+        }
+
+        /**
+         * @brief Parses a decimal number with optional sign, fraction and exponent
+         * @return Pointer past the number, or nullptr if there is none
+         */
+        const char *ParseFloat(const char *p, const char *end, float &value)
+        {
+            bool negative = false;
+            if (p < end && (*p == '-' || *p == '+'))
+            {
+                negative = *p == '-';
+                ++p;
+            }
+
+            // Up to 19 significant digits fit a 64-bit mantissa; further ones only shift the exponent
+            std::uint64_t mantissa = 0;
+            int significantDigits = 0;
+            int exponent = 0;
+            bool anyDigits = false;
+            for (; p < end && IsDigit(*p); ++p)
+            {
+                anyDigits = true;
+                if (significantDigits < 19)
+                {
+                    mantissa = mantissa * 10 + static_cast<std::uint64_t>(*p - '0');
+                    significantDigits += mantissa != 0;
+                }
+                else
+                {
+                    ++exponent;
+                }
+            }
+            if (p < end && *p == '.')
+            {
+                for (++p; p < end && IsDigit(*p); ++p)
+                {
+                    anyDigits = true;
+                    if (significantDigits < 19)
+                    {
+                        mantissa = mantissa * 10 + static_cast<std::uint64_t>(*p - '0');
+                        significantDigits += mantissa != 0;
+                        --exponent;
+                    }
+                }
+            }
+            if (!anyDigits)
+                return nullptr;
+
+            if (p < end && (*p == 'e' || *p == 'E'))
+            {
+                const char *exponentStart = p++;
+                bool negativeExponent = false;
+                if (p < end && (*p == '-' || *p == '+'))
+                {
+                    negativeExponent = *p == '-';
+                    ++p;
+                }
+                if (p < end && IsDigit(*p))
+                {
+                    int explicitExponent = 0;
+                    for (; p < end && IsDigit(*p); ++p)
+                    {
+                        if (explicitExponent < 10000)
+                            explicitExponent = explicitExponent * 10 + (*p - '0');
+                    }
+                    exponent += negativeExponent ? -explicitExponent : explicitExponent;
+                }
+                else
+                {
+                    // Not an exponent after all, e.g. "1e" followed by text
+                    p = exponentStart;
+                }
+            }
+
+            double result = static_cast<double>(mantissa);
+            if (exponent < 0)
+                result /= PowerOfTen(-exponent);
+            else if (exponent > 0)
+                result *= PowerOfTen(exponent);
+            value = static_cast<float>(negative ? -result : result);
+            return p;
+        }
+
+        /**
+         * @brief Parses an optionally signed integer
+         * @return Pointer past the number, or nullptr if there is none
+         */
+        const char *ParseInt(const char *p, const char *end, std::int64_t &value)
+        {
+            bool negative = false;
+            if (p < end && (*p == '-' || *p == '+'))
+            {
+                negative = *p == '-';
+                ++p;
+            }
+            if (p >= end || !IsDigit(*p))
+                return nullptr;
+
+            std::int64_t result = 0;
+            for (; p < end && IsDigit(*p); ++p)
+            {
+                if (result < std::numeric_limits<std::int32_t>::max())
+                    result = result * 10 + (*p - '0');
+            }
+            value = negative ? -result : result;
+            return p;
+        }
+
+        /**
+         * @brief Parses whitespace-separated floats into an array, filling missing ones with zero
+         */
+        void ParseFloats(const char *p, const char *end, std::vector<float> &output, int count)
+        {
+            for (int i = 0; i < count; ++i)
+            {
+                float value = 0.0f;
+                p = SkipSpaces(p, end);
+                if (const char *next = ParseFloat(p, end, value))
+                {
+                    p = next;
+                }
+                else if (i == 0)
+                {
+                    throw std::runtime_error("Malformed number in OBJ vertex data");
+                }
+                output.push_back(value);
+            }
+        }
+
+        /**
+         * @brief Converts an OBJ index to a 0-based one; negative indices stay relative to the chunk
+         * @param index Index as written in the file
+         * @param localCount Number of elements of that kind parsed so far in the chunk
+         * @param relative Set if the result is relative to the chunk
+         */
+        std::int32_t ResolveIndex(std::int64_t index, std::size_t localCount, bool &relative)
+        {
+            if (index > 0)
+            {
+                relative = false;
+                return static_cast<std::int32_t>(index - 1);
+            }
+            if (index < 0)
+            {
+                relative = true;
+                return static_cast<std::int32_t>(static_cast<std::int64_t>(localCount) + index);
+            }
+            throw std::runtime_error("OBJ face uses index 0");
+        }
+
+        std::string ParseName(const char *p, const char *end)
+        {
+            p = SkipSpaces(p, end);
+            while (end > p && IsSpace(end[-1]))
+                --end;
+            return std::string(p, end);
+        }
+
+        void ParseFace(const char *p, const char *end, Chunk &chunk, std::int32_t material)
+        {
+            const std::size_t firstCorner = chunk.corners.size();
+            const std::size_t positionCount = chunk.positions.size() / 3;
+            const std::size_t texCoordCount = chunk.texCoords.size() / 2;
+            const std::size_t normalCount = chunk.normals.size() / 3;
+
+            while (true)
+            {
+                p = SkipSpaces(p, end);
+                std::int64_t index;
+                const char *next = ParseInt(p, end, index);
+                if (!next)
+                    break;
+                p = next;
+
+                Corner corner{0, MISSING_INDEX, MISSING_INDEX, 0};
+                bool relative;
+                corner.position = ResolveIndex(index, positionCount, relative);
+                corner.relative |= relative ? RELATIVE_POSITION : 0;
+
+                // v, v/vt, v//vn or v/vt/vn
+                if (p < end && *p == '/')
+                {
+                    ++p;
+                    if ((next = ParseInt(p, end, index)))
+                    {
+                        p = next;
+                        corner.texCoord = ResolveIndex(index, texCoordCount, relative);
+                        corner.relative |= relative ? RELATIVE_TEXCOORD : 0;
+                    }
+                    if (p < end && *p == '/')
+                    {
+                        ++p;
+                        if ((next = ParseInt(p, end, index)))
+                        {
+                            p = next;
+                            corner.normal = ResolveIndex(index, normalCount, relative);
+                            corner.relative |= relative ? RELATIVE_NORMAL : 0;
+                        }
+                    }
+                }
+                chunk.corners.push_back(corner);
+            }
+
+            const std::size_t cornerCount = chunk.corners.size() - firstCorner;
+            if (cornerCount < 3)
+            {
+                // Points and lines are not rendered
+                chunk.corners.resize(firstCorner);
+                return;
+            }
+            chunk.faces.push_back({static_cast<std::uint32_t>(firstCorner), static_cast<std::uint32_t>(cornerCount), material});
+        }
+
+        void ParseChunk(Chunk &chunk)
+        {
+            std::int32_t material = -1;
+            const char *p = chunk.begin;
+            const char *end = chunk.end;
+            while (p < end)
+            {
+                const char *lineEnd = static_cast<const char *>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+                if (!lineEnd)
+                    lineEnd = end;
+
+                p = SkipSpaces(p, lineEnd);
+                const std::size_t length = static_cast<std::size_t>(lineEnd - p);
+                if (length >= 2 && IsSpace(p[1]))
+                {
+                    if (p[0] == 'v')
+                        ParseFloats(p + 2, lineEnd, chunk.positions, 3);
+                    else if (p[0] == 'f')
+                        ParseFace(p + 2, lineEnd, chunk, material);
+                    else if ((p[0] == 'o' || p[0] == 'g') && chunk.objectName.empty())
+                        chunk.objectName = ParseName(p + 2, lineEnd);
+                }
+                else if (length >= 3 && p[0] == 'v' && IsSpace(p[2]))
+                {
+                    if (p[1] == 't')
+                        ParseFloats(p + 3, lineEnd, chunk.texCoords, 2);
+                    else if (p[1] == 'n')
+                        ParseFloats(p + 3, lineEnd, chunk.normals, 3);
+                }
+                else if (length >= 7 && std::memcmp(p, "usemtl", 6) == 0 && IsSpace(p[6]))
+                {
+                    const std::string name = ParseName(p + 7, lineEnd);
+                    auto it = std::find(chunk.materials.begin(), chunk.materials.end(), name);
+                    material = static_cast<std::int32_t>(it - chunk.materials.begin());
+                    if (it == chunk.materials.end())
+                        chunk.materials.push_back(name);
+                }
+
+                p = lineEnd + 1;
+            }
+            chunk.lastMaterial = material;
+        }
+
+        /**
+         * @brief Turns chunk-relative and file-wide indices into checked offsets into the merged arrays
+         */
+        void ResolveChunk(Chunk &chunk, std::size_t positionCount, std::size_t texCoordCount, std::size_t normalCount)
+        {
+            auto resolve = [](std::int32_t &index, bool relative, std::size_t base, std::size_t count)
+            {
+                std::int64_t resolved = relative ? static_cast<std::int64_t>(base) + index : index;
+                if (resolved < 0 || resolved >= static_cast<std::int64_t>(count))
+                    throw std::runtime_error("OBJ face references a missing vertex");
+                index = static_cast<std::int32_t>(resolved);
+            };
+
+            for (Corner &corner : chunk.corners)
+            {
+                resolve(corner.position, corner.relative & RELATIVE_POSITION, chunk.positionBase, positionCount);
+                if (corner.texCoord != MISSING_INDEX)
+                    resolve(corner.texCoord, corner.relative & RELATIVE_TEXCOORD, chunk.texCoordBase, texCoordCount);
+                if (corner.normal != MISSING_INDEX)
+                    resolve(corner.normal, corner.relative & RELATIVE_NORMAL, chunk.normalBase, normalCount);
+            }
+            for (Face &face : chunk.faces)
+            {
+                face.material = face.material < 0 ? chunk.inheritedMaterial : chunk.globalMaterials[face.material];
+            }
+        }
+
+        /**
+         * @brief Open-addressing map from position/texcoord/normal triplets to output vertices
+         */
+        class VertexMap
+        {
+        public:
+            explicit VertexMap(std::size_t expectedCount)
+            {
+                std::size_t capacity = 16;
+                while (capacity < expectedCount * 2)
+                    capacity <<= 1;
+                m_Entries.assign(capacity, Entry{0, 0, 0, EMPTY_SLOT});
+            }
+
+            /**
+             * @brief Looks up a triplet, adding it with the given vertex index if it is new
+             * @return The vertex index of the triplet
+             */
+            std::uint32_t FindOrInsert(const Corner &corner, std::uint32_t newVertex)
+            {
+                if ((m_Count + 1) * 2 > m_Entries.size())
+                    Grow();
+
+                const std::size_t mask = m_Entries.size() - 1;
+                for (std::size_t slot = Hash(corner) & mask;; slot = (slot + 1) & mask)
+                {
+                    Entry &entry = m_Entries[slot];
+                    if (entry.vertex == EMPTY_SLOT)
+                    {
+                        entry = Entry{corner.position, corner.texCoord, corner.normal, newVertex};
+                        ++m_Count;
+                        return newVertex;
+                    }
+                    if (entry.position == corner.position && entry.texCoord == corner.texCoord && entry.normal == corner.normal)
+                        return entry.vertex;
+                }
+            }
+
+        private:
+            struct Entry
+            {
+                std::int32_t position, texCoord, normal;
+                std::uint32_t vertex;
+            };
+
+            static std::size_t Hash(const Corner &corner)
+            {
+                std::uint64_t hash = static_cast<std::uint32_t>(corner.position) * 0x9E3779B97F4A7C15ull;
+                hash ^= static_cast<std::uint32_t>(corner.texCoord) * 0xC2B2AE3D27D4EB4Full;
+                hash ^= static_cast<std::uint32_t>(corner.normal) * 0x165667B19E3779F9ull;
+                return static_cast<std::size_t>(hash ^ (hash >> 29));
+            }
+
+            void Grow()
+            {
+                std::vector<Entry> old(m_Entries.size() * 2, Entry{0, 0, 0, EMPTY_SLOT});
+                old.swap(m_Entries);
+                const std::size_t mask = m_Entries.size() - 1;
+                for (const Entry &entry : old)
+                {
+                    if (entry.vertex == EMPTY_SLOT)
+                        continue;
+                    std::size_t slot = Hash(Corner{entry.position, entry.texCoord, entry.normal, 0}) & mask;
+                    while (m_Entries[slot].vertex != EMPTY_SLOT)
+                        slot = (slot + 1) & mask;
+                    m_Entries[slot] = entry;
+                }
+            }
+
+            std::vector<Entry> m_Entries;
+            std::size_t m_Count = 0;
+        };
+
+        /**
+         * @brief Builds the indexed mesh of one material from the resolved chunks
+         */
+        MeshData BuildMesh(const std::vector<Chunk> &chunks, std::int32_t material, std::size_t cornerCount,
+                           const std::vector<float> &positions, const std::vector<float> &texCoords, const std::vector<float> &normals)
+        {
+            // Typical meshes share each vertex between four to six corners; the map grows if
+            // fewer are shared
+            const std::size_t expectedVertices = cornerCount / 4 + 1;
+
+            MeshData mesh;
+            VertexMap vertexMap(expectedVertices);
+            std::vector<std::int32_t> vertexPositions; // Position index of each output vertex
+            std::vector<std::uint8_t> missingNormal;
+            bool anyMissingNormal = false;
+            std::vector<std::uint32_t> faceVertices;
+
+            for (const Chunk &chunk : chunks)
+            {
+                for (const Face &face : chunk.faces)
+                {
+                    if (face.material != material)
+                        continue;
+
+                    faceVertices.clear();
+                    for (std::uint32_t i = 0; i < face.cornerCount; ++i)
+                    {
+                        const Corner &corner = chunk.corners[face.firstCorner + i];
+                        const std::uint32_t newVertex = static_cast<std::uint32_t>(vertexPositions.size());
+                        const std::uint32_t vertex = vertexMap.FindOrInsert(corner, newVertex);
+                        faceVertices.push_back(vertex);
+                        if (vertex != newVertex)
+                            continue;
+
+                        // Position (3) + Normal (3) + TexCoord (2), texture V flipped for OpenGL like AssimpLoader
+                        const float *position = &positions[static_cast<std::size_t>(corner.position) * 3];
+                        mesh.vertices.insert(mesh.vertices.end(), position, position + 3);
+                        if (corner.normal != MISSING_INDEX)
+                        {
+                            const float *normal = &normals[static_cast<std::size_t>(corner.normal) * 3];
+                            mesh.vertices.insert(mesh.vertices.end(), normal, normal + 3);
+                        }
+                        else
+                        {
+                            mesh.vertices.insert(mesh.vertices.end(), {0.0f, 0.0f, 0.0f});
+                            anyMissingNormal = true;
+                        }
+                        if (corner.texCoord != MISSING_INDEX)
+                        {
+                            const float *texCoord = &texCoords[static_cast<std::size_t>(corner.texCoord) * 2];
+                            mesh.vertices.push_back(texCoord[0]);
+                            mesh.vertices.push_back(1.0f - texCoord[1]);
+                        }
+                        else
+                        {
+                            mesh.vertices.insert(mesh.vertices.end(), {0.0f, 0.0f});
+                        }
+                        vertexPositions.push_back(corner.position);
+                        missingNormal.push_back(corner.normal == MISSING_INDEX);
+                    }
+
+                    // Fan triangulation, as aiProcess_Triangulate does for convex polygons
+                    for (std::size_t i = 1; i + 1 < faceVertices.size(); ++i)
+                    {
+                        mesh.indices.push_back(faceVertices[0]);
+                        mesh.indices.push_back(faceVertices[i]);
+                        mesh.indices.push_back(faceVertices[i + 1]);
+                    }
+                }
+            }
+
+            if (anyMissingNormal)
+            {
+                // Smooth normals: area-weighted face normals summed per shared position
+                std::vector<float> sums(positions.size(), 0.0f);
+                for (std::size_t i = 0; i + 2 < mesh.indices.size(); i += 3)
+                {
+                    const float *a = &mesh.vertices[mesh.indices[i] * 8];
+                    const float *b = &mesh.vertices[mesh.indices[i + 1] * 8];
+                    const float *c = &mesh.vertices[mesh.indices[i + 2] * 8];
+                    const float e1[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+                    const float e2[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+                    const float normal[3] = {e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0]};
+                    for (int corner = 0; corner < 3; ++corner)
+                    {
+                        float *sum = &sums[static_cast<std::size_t>(vertexPositions[mesh.indices[i + corner]]) * 3];
+                        sum[0] += normal[0];
+                        sum[1] += normal[1];
+                        sum[2] += normal[2];
+                    }
+                }
+                for (std::size_t vertex = 0; vertex < vertexPositions.size(); ++vertex)
+                {
+                    if (!missingNormal[vertex])
+                        continue;
+                    const float *sum = &sums[static_cast<std::size_t>(vertexPositions[vertex]) * 3];
+                    const float length = std::sqrt(sum[0] * sum[0] + sum[1] * sum[1] + sum[2] * sum[2]);
+                    float *normal = &mesh.vertices[vertex * 8 + 3];
+                    if (length > 0.0f)
+                    {
+                        normal[0] = sum[0] / length;
+                        normal[1] = sum[1] / length;
+                        normal[2] = sum[2] / length;
+                    }
+                    else
+                    {
+                        normal[1] = 1.0f;
+                    }
+                }
+            }
+
+            return mesh;
+        }
+    }
+
+    bool ObjLoader::CanLoad(const std::string &extension) const
+    {
+        std::string ext = extension;
+        std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+        return ext == ".obj";
+    }
+
+    std::vector<MeshData> ObjLoader::LoadMeshData(const std::string &filepath)
+    {
+        Utils::MappedFile file;
+        if (!file.Open(filepath))
+            throw std::runtime_error("Cannot open OBJ file: " + filepath);
+
+        const char *data = reinterpret_cast<const char *>(file.GetData());
+        const std::size_t size = file.GetSize();
+        auto &pool = Utils::ThreadPool::GetInstance();
+
+        // Split at line starts into a few chunks per thread so uneven chunks even out
+        const std::size_t maxChunks = 4 * (static_cast<std::size_t>(pool.GetThreadCount()) + 1);
+        const std::size_t chunkCount = std::clamp<std::size_t>(size / MIN_CHUNK_SIZE, 1, maxChunks);
+        std::vector<Chunk> chunks;
+        chunks.reserve(chunkCount);
+        const char *chunkBegin = data;
+        for (std::size_t i = 1; i <= chunkCount && chunkBegin < data + size; ++i)
+        {
+            const char *chunkEnd = data + size;
+            if (i < chunkCount)
+            {
+                const char *target = std::max(data + size / chunkCount * i, chunkBegin);
+                const char *newline = static_cast<const char *>(std::memchr(target, '\n', static_cast<std::size_t>(data + size - target)));
+                chunkEnd = newline ? newline + 1 : data + size;
+            }
+            chunks.emplace_back();
+            chunks.back().begin = chunkBegin;
+            chunks.back().end = chunkEnd;
+            chunkBegin = chunkEnd;
+        }
+
+        pool.ParallelFor(chunks.size(), [&chunks](std::size_t i)
+                         { ParseChunk(chunks[i]); });
+
+        // Concatenate the vertex arrays and number the materials in order of first use
+        std::vector<float> positions, texCoords, normals;
+        std::vector<std::string> materialNames{""};
+        std::unordered_map<std::string, std::int32_t> materialIds{{"", 0}};
+        std::string objectName;
+        std::vector<std::size_t> materialCorners{0}; // Corners per file material, to size the vertex maps
+        std::int32_t currentMaterial = 0;
+        for (Chunk &chunk : chunks)
+        {
+            chunk.positionBase = positions.size() / 3;
+            chunk.texCoordBase = texCoords.size() / 2;
+            chunk.normalBase = normals.size() / 3;
+            positions.insert(positions.end(), chunk.positions.begin(), chunk.positions.end());
+            texCoords.insert(texCoords.end(), chunk.texCoords.begin(), chunk.texCoords.end());
+            normals.insert(normals.end(), chunk.normals.begin(), chunk.normals.end());
+
+            for (const std::string &name : chunk.materials)
+            {
+                auto it = materialIds.emplace(name, static_cast<std::int32_t>(materialNames.size())).first;
+                if (it->second == static_cast<std::int32_t>(materialNames.size()))
+                    materialNames.push_back(name);
+                chunk.globalMaterials.push_back(it->second);
+            }
+            materialCorners.resize(materialNames.size(), 0);
+
+            // Faces before the chunk's first usemtl continue the previous material
+            chunk.inheritedMaterial = currentMaterial;
+            for (const Face &face : chunk.faces)
+            {
+                const std::int32_t material = face.material < 0 ? chunk.inheritedMaterial : chunk.globalMaterials[face.material];
+                materialCorners[static_cast<std::size_t>(material)] += face.cornerCount;
+            }
+            if (chunk.lastMaterial >= 0)
+                currentMaterial = chunk.globalMaterials[chunk.lastMaterial];
+
+            if (objectName.empty())
+                objectName = chunk.objectName;
+        }
+
+        pool.ParallelFor(chunks.size(), [&](std::size_t i)
+                         { ResolveChunk(chunks[i], positions.size() / 3, texCoords.size() / 2, normals.size() / 3); });
+
+        // One mesh per material, like the Assimp OBJ importer after mesh optimization
+        std::vector<MeshData> meshes(materialNames.size());
+        pool.ParallelFor(meshes.size(), [&](std::size_t i)
+                         {
+            if (materialCorners[i] > 0)
+                meshes[i] = BuildMesh(chunks, static_cast<std::int32_t>(i), materialCorners[i], positions, texCoords, normals); });
+
+        if (objectName.empty())
+            objectName = std::filesystem::path(filepath).stem().string();
+
+        std::vector<MeshData> result;
+        for (std::size_t i = 0; i < meshes.size(); ++i)
+        {
+            if (meshes[i].indices.empty())
+                continue;
+
+            meshes[i].materialName = materialNames[i];
+            meshes[i].name = objectName;
+            result.push_back(std::move(meshes[i]));
+        }
+        if (result.size() > 1)
+        {
+            for (MeshData &mesh : result)
+            {
+                if (!mesh.materialName.empty())
+                    mesh.name += "_" + mesh.materialName;
+            }
+        }
+
+        std::cout << "Loaded " << result.size() << " meshes from OBJ file: " << filepath << std::endl;
+        return result;
+    }
+}
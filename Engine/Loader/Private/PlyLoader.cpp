@@ -0,0 +1,457 @@
+#include "PlyLoader.h"
+#include "MappedFile.h"
+#include "MeshLoader.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace Voltray::Engine
+{
+    namespace
+    {
+        constexpr std::size_t VERTICES_PER_TASK = 1 << 16;
+        constexpr std::size_t FACES_PER_TASK = 1 << 16;
+
+        enum class ScalarType : std::uint8_t
+        {
+            Int8,
+            UInt8,
+            Int16,
+            UInt16,
+            Int32,
+            UInt32,
+            Float32,
+            Float64
+        };
+
+        struct Property
+        {
+            std::string name;
+            ScalarType type = ScalarType::Float32; ///< Type of the value, or of the items of a list
+            ScalarType countType = ScalarType::UInt8;
+            bool isList = false;
+            std::size_t offset = 0; ///< Offset in the record, only meaningful for elements without lists
+        };
+
+        struct Element
+        {
+            std::string name;
+            std::size_t count = 0;
+            std::vector<Property> properties;
+            std::size_t stride = 0; ///< Record size, only meaningful for elements without lists
+            bool hasLists = false;
+
+            const Property *FindProperty(const char *propertyName) const
+            {
+                for (const Property &property : properties)
+                {
+                    if (property.name == propertyName)
+                        return &property;
+                }
+                return nullptr;
+            }
+        };
+
+        struct Header
+        {
+            std::vector<Element> elements;
+            bool binary = false;
+            bool bigEndian = false;
+            std::size_t dataOffset = 0;
+        };
+
+        std::size_t GetScalarSize(ScalarType type)
+        {
+            switch (type)
+            {
+            case ScalarType::Int8:
+            case ScalarType::UInt8:
+                return 1;
+            case ScalarType::Int16:
+            case ScalarType::UInt16:
+                return 2;
+            case ScalarType::Int32:
+            case ScalarType::UInt32:
+            case ScalarType::Float32:
+                return 4;
+            case ScalarType::Float64:
+                return 8;
+            }
+            return 0;
+        }
+
+        bool ParseScalarType(const std::string &name, ScalarType &type)
+        {
+            static const std::pair<const char *, ScalarType> names[] = {
+                {"char", ScalarType::Int8}, {"int8", ScalarType::Int8}, {"uchar", ScalarType::UInt8}, {"uint8", ScalarType::UInt8}, {"short", ScalarType::Int16}, {"int16", ScalarType::Int16}, {"ushort", ScalarType::UInt16}, {"uint16", ScalarType::UInt16}, {"int", ScalarType::Int32}, {"int32", ScalarType::Int32}, {"uint", ScalarType::UInt32}, {"uint32", ScalarType::UInt32}, {"float", ScalarType::Float32}, {"float32", ScalarType::Float32}, {"double", ScalarType::Float64}, {"float64", ScalarType::Float64}};
+            for (const auto &entry : names)
+            {
+                if (name == entry.first)
+                {
+                    type = entry.second;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        template <typename T>
+        T Load(const unsigned char *data, bool swap)
+        {
+            unsigned char bytes[sizeof(T)];
+            std::memcpy(bytes, data, sizeof(T));
+            if (swap)
+                std::reverse(bytes, bytes + sizeof(T));
+            T value;
+            std::memcpy(&value, bytes, sizeof(T));
+            return value;
+        }
+
+        double ReadScalar(const unsigned char *data, ScalarType type, bool swap)
+        {
+            switch (type)
+            {
+            case ScalarType::Int8:
+                return Load<std::int8_t>(data, swap);
+            case ScalarType::UInt8:
+                return Load<std::uint8_t>(data, swap);
+            case ScalarType::Int16:
+                return Load<std::int16_t>(data, swap);
+            case ScalarType::UInt16:
+                return Load<std::uint16_t>(data, swap);
+            case ScalarType::Int32:
+                return Load<std::int32_t>(data, swap);
+            case ScalarType::UInt32:
+                return Load<std::uint32_t>(data, swap);
+            case ScalarType::Float32:
+                return Load<float>(data, swap);
+            case ScalarType::Float64:
+                return Load<double>(data, swap);
+            }
+            return 0.0;
+        }
+
+        std::int64_t ReadInteger(const unsigned char *data, ScalarType type, bool swap)
+        {
+            switch (type)
+            {
+            case ScalarType::Int8:
+                return Load<std::int8_t>(data, swap);
+            case ScalarType::UInt8:
+                return Load<std::uint8_t>(data, swap);
+            case ScalarType::Int16:
+                return Load<std::int16_t>(data, swap);
+            case ScalarType::UInt16:
+                return Load<std::uint16_t>(data, swap);
+            case ScalarType::Int32:
+                return Load<std::int32_t>(data, swap);
+            case ScalarType::UInt32:
+                return Load<std::uint32_t>(data, swap);
+            default:
+                return static_cast<std::int64_t>(ReadScalar(data, type, swap));
+            }
+        }
+
+        /**
+         * @brief Parses the text header
+         * @return False if the file is not a PLY file
+         */
+        bool ParseHeader(const unsigned char *data, std::size_t size, Header &header)
+        {
+            static const char END_HEADER[] = "end_header";
+            const char *text = reinterpret_cast<const char *>(data);
+            const char *end = text + size;
+            const char *found = std::search(text, end, END_HEADER, END_HEADER + sizeof(END_HEADER) - 1);
+            if (size < 3 || std::memcmp(text, "ply", 3) != 0 || found == end)
+                return false;
+
+            const char *dataStart = static_cast<const char *>(std::memchr(found, '\n', static_cast<std::size_t>(end - found)));
+            header.dataOffset = dataStart ? static_cast<std::size_t>(dataStart + 1 - text) : size;
+
+            std::istringstream lines(std::string(text, found));
+            std::string line;
+            while (std::getline(lines, line))
+            {
+                std::istringstream words(line);
+                std::string keyword;
+                words >> keyword;
+                if (keyword == "format")
+                {
+                    std::string format;
+                    words >> format;
+                    header.binary = format != "ascii";
+                    header.bigEndian = format == "binary_big_endian";
+                }
+                else if (keyword == "element")
+                {
+                    Element element;
+                    words >> element.name >> element.count;
+                    if (!words)
+                        throw std::runtime_error("Malformed PLY element: " + line);
+                    header.elements.push_back(std::move(element));
+                }
+                else if (keyword == "property")
+                {
+                    if (header.elements.empty())
+                        throw std::runtime_error("PLY property outside an element: " + line);
+
+                    Element &element = header.elements.back();
+                    Property property;
+                    std::string type;
+                    words >> type;
+                    if (type == "list")
+                    {
+                        std::string countType;
+                        words >> countType >> type;
+                        property.isList = true;
+                        element.hasLists = true;
+                        if (!ParseScalarType(countType, property.countType))
+                            throw std::runtime_error("Unknown PLY type: " + line);
+                    }
+                    words >> property.name;
+                    if (!ParseScalarType(type, property.type))
+                        throw std::runtime_error("Unknown PLY type: " + line);
+
+                    property.offset = element.stride;
+                    element.stride += GetScalarSize(property.type);
+                    element.properties.push_back(std::move(property));
+                }
+            }
+            return true;
+        }
+
+        /**
+         * @brief Gets the size of one record of an element with list properties
+         */
+        std::size_t GetRecordSize(const Element &element, const unsigned char *record, const unsigned char *end, bool swap)
+        {
+            std::size_t size = 0;
+            for (const Property &property : element.properties)
+            {
+                if (!property.isList)
+                {
+                    size += GetScalarSize(property.type);
+                    continue;
+                }
+
+                const std::size_t countSize = GetScalarSize(property.countType);
+                if (record + size + countSize > end)
+                    throw std::runtime_error("PLY file is truncated");
+                const std::int64_t count = ReadInteger(record + size, property.countType, swap);
+                if (count < 0)
+                    throw std::runtime_error("PLY list has a negative length");
+                size += countSize + static_cast<std::size_t>(count) * GetScalarSize(property.type);
+            }
+            if (record + size > end)
+                throw std::runtime_error("PLY file is truncated");
+            return size;
+        }
+    }
+
+    bool PlyLoader::CanLoad(const std::string &extension) const
+    {
+        std::string ext = extension;
+        std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+        return ext == ".ply";
+    }
+
+    std::vector<MeshData> PlyLoader::LoadMeshData(const std::string &filepath)
+    {
+        Utils::MappedFile file;
+        if (!file.Open(filepath))
+            throw std::runtime_error("Cannot open PLY file: " + filepath);
+
+        Header header;
+        if (!ParseHeader(file.GetData(), file.GetSize(), header))
+            throw std::runtime_error("Not a PLY file: " + filepath);
+
+        auto findElement = [&header](const char *name) -> const Element *
+        {
+            for (const Element &element : header.elements)
+            {
+                if (element.name == name)
+                    return &element;
+            }
+            return nullptr;
+        };
+        const Element *vertexElement = findElement("vertex");
+        const Element *faceElement = findElement("face");
+        if (!header.binary || !vertexElement || vertexElement->hasLists)
+        {
+            file.Close();
+            return AssimpLoader().LoadMeshData(filepath);
+        }
+
+        const bool swap = header.bigEndian;
+        const unsigned char *data = file.GetData();
+        const unsigned char *end = data + file.GetSize();
+
+        const Property *indexProperty = nullptr;
+        if (faceElement)
+        {
+            indexProperty = faceElement->FindProperty("vertex_indices");
+            if (!indexProperty)
+                indexProperty = faceElement->FindProperty("vertex_index");
+            if (!indexProperty || !indexProperty->isList)
+                throw std::runtime_error("PLY faces have no vertex index list: " + filepath);
+        }
+
+        // Walk the elements in file order; face records vary in size, so note where every task starts
+        const unsigned char *vertexData = nullptr;
+        std::vector<const unsigned char *> faceTaskStarts;
+        std::vector<std::size_t> faceTaskTriangles;
+        std::size_t triangleCount = 0;
+        const unsigned char *position = data + header.dataOffset;
+        for (const Element &element : header.elements)
+        {
+            if (!element.hasLists)
+            {
+                if (element.stride != 0 && element.count > static_cast<std::size_t>(end - position) / element.stride)
+                    throw std::runtime_error("PLY file is truncated: " + filepath);
+                if (&element == vertexElement)
+                    vertexData = position;
+                position += element.count * element.stride;
+                continue;
+            }
+
+            const bool isFace = &element == faceElement;
+            for (std::size_t i = 0; i < element.count; ++i)
+            {
+                if (isFace && i % FACES_PER_TASK == 0)
+                {
+                    faceTaskStarts.push_back(position);
+                    faceTaskTriangles.push_back(triangleCount);
+                }
+
+                const unsigned char *record = position;
+                position += GetRecordSize(element, record, end, swap);
+                if (isFace)
+                {
+                    // The index list sits after the fixed-size properties before it
+                    std::size_t offset = 0;
+                    for (const Property &property : element.properties)
+                    {
+                        if (&property == indexProperty)
+                            break;
+                        offset += property.isList ? GetScalarSize(property.countType) + static_cast<std::size_t>(ReadInteger(record + offset, property.countType, swap)) * GetScalarSize(property.type)
+                                                  : GetScalarSize(property.type);
+                    }
+                    const std::int64_t cornerCount = ReadInteger(record + offset, indexProperty->countType, swap);
+                    triangleCount += cornerCount >= 3 ? static_cast<std::size_t>(cornerCount - 2) : 0;
+                }
+            }
+        }
+
+        // Point clouds have nothing to render
+        if (triangleCount == 0)
+            return {};
+
+        MeshData mesh;
+        mesh.name = std::filesystem::path(filepath).stem().string();
+        mesh.vertices.resize(vertexElement->count * 8);
+        mesh.indices.resize(triangleCount * 3);
+        auto &pool = Utils::ThreadPool::GetInstance();
+
+        const Property *x = vertexElement->FindProperty("x");
+        const Property *y = vertexElement->FindProperty("y");
+        const Property *z = vertexElement->FindProperty("z");
+        if (!x || !y || !z)
+            throw std::runtime_error("PLY vertices have no position: " + filepath);
+        const Property *nx = vertexElement->FindProperty("nx");
+        const Property *ny = vertexElement->FindProperty("ny");
+        const Property *nz = vertexElement->FindProperty("nz");
+        const bool hasNormals = nx && ny && nz;
+        const Property *u = nullptr;
+        const Property *v = nullptr;
+        static const std::pair<const char *, const char *> TEXCOORD_NAMES[] = {{"u", "v"}, {"s", "t"}, {"texture_u", "texture_v"}, {"texture_s", "texture_t"}};
+        for (const auto &names : TEXCOORD_NAMES)
+        {
+            u = vertexElement->FindProperty(names.first);
+            v = vertexElement->FindProperty(names.second);
+            if (u && v)
+                break;
+        }
+
+        const std::size_t vertexCount = vertexElement->count;
+        const std::size_t stride = vertexElement->stride;
+        pool.ParallelFor((vertexCount + VERTICES_PER_TASK - 1) / VERTICES_PER_TASK, [&](std::size_t task)
+                         {
+            const std::size_t last = std::min((task + 1) * VERTICES_PER_TASK, vertexCount);
+            for (std::size_t i = task * VERTICES_PER_TASK; i < last; ++i)
+            {
+                const unsigned char *record = vertexData + i * stride;
+                float *vertex = &mesh.vertices[i * 8];
+                vertex[0] = static_cast<float>(ReadScalar(record + x->offset, x->type, swap));
+                vertex[1] = static_cast<float>(ReadScalar(record + y->offset, y->type, swap));
+                vertex[2] = static_cast<float>(ReadScalar(record + z->offset, z->type, swap));
+                if (hasNormals)
+                {
+                    vertex[3] = static_cast<float>(ReadScalar(record + nx->offset, nx->type, swap));
+                    vertex[4] = static_cast<float>(ReadScalar(record + ny->offset, ny->type, swap));
+                    vertex[5] = static_cast<float>(ReadScalar(record + nz->offset, nz->type, swap));
+                }
+                if (u && v)
+                {
+                    // Flipped for OpenGL like AssimpLoader
+                    vertex[6] = static_cast<float>(ReadScalar(record + u->offset, u->type, swap));
+                    vertex[7] = 1.0f - static_cast<float>(ReadScalar(record + v->offset, v->type, swap));
+                }
+            } });
+
+        pool.ParallelFor(faceTaskStarts.size(), [&](std::size_t task)
+                         {
+            const unsigned char *record = faceTaskStarts[task];
+            unsigned int *output = &mesh.indices[faceTaskTriangles[task] * 3];
+            const std::size_t last = std::min((task + 1) * FACES_PER_TASK, faceElement->count);
+            const std::size_t indexSize = GetScalarSize(indexProperty->type);
+            for (std::size_t i = task * FACES_PER_TASK; i < last; ++i)
+            {
+                std::size_t offset = 0;
+                for (const Property &property : faceElement->properties)
+                {
+                    if (!property.isList)
+                    {
+                        offset += GetScalarSize(property.type);
+                        continue;
+                    }
+
+                    const std::int64_t count = ReadInteger(record + offset, property.countType, swap);
+                    offset += GetScalarSize(property.countType);
+                    if (&property == indexProperty)
+                    {
+                        // Fan triangulation, as aiProcess_Triangulate does for convex polygons
+                        const unsigned char *indices = record + offset;
+                        auto readIndex = [&](std::int64_t corner)
+                        {
+                            const std::int64_t index = ReadInteger(indices + corner * indexSize, indexProperty->type, swap);
+                            if (index < 0 || static_cast<std::size_t>(index) >= vertexCount)
+                                throw std::runtime_error("PLY face references a missing vertex");
+                            return static_cast<unsigned int>(index);
+                        };
+                        for (std::int64_t corner = 1; corner + 1 < count; ++corner)
+                        {
+                            *output++ = readIndex(0);
+                            *output++ = readIndex(corner);
+                            *output++ = readIndex(corner + 1);
+                        }
+                    }
+                    offset += static_cast<std::size_t>(count) * GetScalarSize(property.type);
+                }
+                record += offset;
+            } });
+
+        if (!hasNormals)
+            MeshLoader::GenerateSmoothNormals(mesh);
+
+        std::cout << "Loaded PLY file: " << filepath << " (" << triangleCount << " triangles, "
+                  << vertexCount << " vertices)" << std::endl;
+        std::vector<MeshData> result;
+        result.push_back(std::move(mesh));
+        return result;
+    }
+}
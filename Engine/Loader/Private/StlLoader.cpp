@@ -0,0 +1,312 @@
+#include "StlLoader.h"
+#include "MappedFile.h"
+#include "MeshLoader.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+
+namespace Voltray::Engine
+{
+    namespace
+    {
+        constexpr std::size_t HEADER_SIZE = 80 + sizeof(std::uint32_t); // Comment, triangle count
+        constexpr std::size_t TRIANGLE_SIZE = 50;                      // Normal, three corners, attribute
+        constexpr std::size_t CORNER_OFFSET = 12;                       // Corners follow the facet normal
+        constexpr std::size_t CORNER_SIZE = 3 * sizeof(float);
+        constexpr std::size_t TRIANGLES_PER_TASK = 1 << 14; // Keeps every task's table in cache
+        constexpr std::size_t BUCKET_BITS = 10;
+        constexpr std::size_t BUCKET_COUNT = std::size_t(1) << BUCKET_BITS;
+
+        // Marks the first corner of a position within a task, and the first position of a vertex
+        constexpr std::uint32_t LEADER_BIT = 0x80000000u;
+        constexpr std::uint32_t EMPTY_SLOT = 0xFFFFFFFFu;
+
+        struct PositionKey
+        {
+            std::uint32_t x, y, z;
+
+            bool operator==(const PositionKey &other) const { return x == other.x && y == other.y && z == other.z; }
+        };
+
+        /**
+         * @brief Reads the bit pattern of a corner position, with -0 folded into +0 so both weld
+         */
+        PositionKey ReadKey(const unsigned char *triangles, std::size_t corner)
+        {
+            PositionKey key;
+            std::memcpy(&key, triangles + corner / 3 * TRIANGLE_SIZE + CORNER_OFFSET + corner % 3 * CORNER_SIZE, sizeof(key));
+            key.x = key.x == 0x80000000u ? 0 : key.x;
+            key.y = key.y == 0x80000000u ? 0 : key.y;
+            key.z = key.z == 0x80000000u ? 0 : key.z;
+            return key;
+        }
+
+        std::uint64_t HashKey(const PositionKey &key)
+        {
+            std::uint64_t hash = key.x * 0x9E3779B97F4A7C15ull;
+            hash ^= key.y * 0xC2B2AE3D27D4EB4Full;
+            hash ^= key.z * 0x165667B19E3779F9ull;
+            hash ^= hash >> 29;
+            return hash * 0xBF58476D1CE4E5B9ull;
+        }
+
+        std::size_t GetBucket(std::uint64_t hash) { return static_cast<std::size_t>(hash >> (64 - BUCKET_BITS)); }
+
+        /**
+         * @brief Corner position with the number of the first corner that has it
+         */
+        struct KeyedCorner
+        {
+            PositionKey key;
+            std::uint32_t id;
+        };
+
+        /**
+         * @brief Open-addressing map from positions to the id of their first occurrence
+         */
+        class PositionMap
+        {
+        public:
+            explicit PositionMap(std::size_t expectedCount)
+            {
+                std::size_t capacity = 16;
+                while (capacity < expectedCount * 2)
+                    capacity <<= 1;
+                m_Slots.assign(capacity, KeyedCorner{{0, 0, 0}, EMPTY_SLOT});
+            }
+
+            /**
+             * @brief Looks up a position, adding it with the given id if it is new
+             * @return Id of the first occurrence of the position
+             */
+            std::uint32_t FindOrInsert(const PositionKey &key, std::uint64_t hash, std::uint32_t id)
+            {
+                if ((m_Count + 1) * 2 > m_Slots.size())
+                    Grow();
+
+                const std::size_t mask = m_Slots.size() - 1;
+                for (std::size_t slot = static_cast<std::size_t>(hash) & mask;; slot = (slot + 1) & mask)
+                {
+                    KeyedCorner &entry = m_Slots[slot];
+                    if (entry.id == EMPTY_SLOT)
+                    {
+                        entry = KeyedCorner{key, id};
+                        ++m_Count;
+                        return id;
+                    }
+                    if (entry.key == key)
+                        return entry.id;
+                }
+            }
+
+        private:
+            void Grow()
+            {
+                std::vector<KeyedCorner> old(m_Slots.size() * 2, KeyedCorner{{0, 0, 0}, EMPTY_SLOT});
+                old.swap(m_Slots);
+                const std::size_t mask = m_Slots.size() - 1;
+                for (const KeyedCorner &entry : old)
+                {
+                    if (entry.id == EMPTY_SLOT)
+                        continue;
+                    std::size_t slot = static_cast<std::size_t>(HashKey(entry.key)) & mask;
+                    while (m_Slots[slot].id != EMPTY_SLOT)
+                        slot = (slot + 1) & mask;
+                    m_Slots[slot] = entry;
+                }
+            }
+
+            std::vector<KeyedCorner> m_Slots;
+            std::size_t m_Count = 0;
+        };
+    }
+
+    bool StlLoader::CanLoad(const std::string &extension) const
+    {
+        std::string ext = extension;
+        std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+        return ext == ".stl";
+    }
+
+    std::vector<MeshData> StlLoader::LoadMeshData(const std::string &filepath)
+    {
+        Utils::MappedFile file;
+        if (!file.Open(filepath))
+            throw std::runtime_error("Cannot open STL file: " + filepath);
+
+        // Binary files are exactly as long as their triangle count says; anything else is ASCII
+        std::uint32_t triangleCount = 0;
+        if (file.GetSize() >= HEADER_SIZE)
+            std::memcpy(&triangleCount, file.GetData() + 80, sizeof(triangleCount));
+        if (file.GetSize() < HEADER_SIZE || file.GetSize() != HEADER_SIZE + std::size_t(triangleCount) * TRIANGLE_SIZE)
+        {
+            file.Close();
+            return AssimpLoader().LoadMeshData(filepath);
+        }
+
+        const std::size_t cornerCount = std::size_t(triangleCount) * 3;
+        if (cornerCount >= LEADER_BIT)
+            throw std::runtime_error("STL file has too many triangles: " + filepath);
+        if (cornerCount == 0)
+            return {};
+
+        const unsigned char *triangles = file.GetData() + HEADER_SIZE;
+        auto &pool = Utils::ThreadPool::GetInstance();
+        const std::size_t taskCount = (triangleCount + TRIANGLES_PER_TASK - 1) / TRIANGLES_PER_TASK;
+        auto getTaskCorners = [&](std::size_t task)
+        {
+            const std::size_t begin = task * TRIANGLES_PER_TASK * 3;
+            return std::make_pair(begin, std::min(begin + TRIANGLES_PER_TASK * 3, cornerCount));
+        };
+
+        MeshData mesh;
+        mesh.name = std::filesystem::path(filepath).stem().string();
+        mesh.indices.resize(cornerCount);
+
+        // Weld within every task first: neighbouring triangles share most corners, and the
+        // tables stay in cache. Indices temporarily hold the task-local position number.
+        std::vector<std::vector<PositionKey>> taskPositions(taskCount);
+        pool.ParallelFor(taskCount, [&](std::size_t task)
+                         {
+            auto [begin, end] = getTaskCorners(task);
+            std::vector<PositionKey> &positions = taskPositions[task];
+            PositionMap map((end - begin) / 2);
+            for (std::size_t corner = begin; corner < end; ++corner)
+            {
+                const PositionKey key = ReadKey(triangles, corner);
+                const std::uint32_t local = static_cast<std::uint32_t>(positions.size());
+                const std::uint32_t found = map.FindOrInsert(key, HashKey(key), local);
+                if (found == local)
+                {
+                    positions.push_back(key);
+                    mesh.indices[corner] = local | LEADER_BIT;
+                }
+                else
+                {
+                    mesh.indices[corner] = found;
+                }
+            } });
+
+        std::vector<std::size_t> positionStarts(taskCount + 1, 0);
+        for (std::size_t task = 0; task < taskCount; ++task)
+        {
+            positionStarts[task + 1] = positionStarts[task] + taskPositions[task].size();
+        }
+        const std::size_t positionCount = positionStarts[taskCount];
+
+        // Weld the task positions across tasks: partition them by a spatial hash, keeping file order
+        // within each bucket, and point each at the first position with the same key
+        std::vector<std::uint32_t> vertexIds(positionCount);
+        {
+            std::vector<std::uint32_t> bucketOffsets(taskCount * BUCKET_COUNT, 0);
+            pool.ParallelFor(taskCount, [&](std::size_t task)
+                             {
+                std::uint32_t *counts = &bucketOffsets[task * BUCKET_COUNT];
+                for (const PositionKey &key : taskPositions[task])
+                    ++counts[GetBucket(HashKey(key))]; });
+
+            std::vector<std::size_t> bucketStarts(BUCKET_COUNT + 1, 0);
+            std::uint32_t offset = 0;
+            for (std::size_t bucket = 0; bucket < BUCKET_COUNT; ++bucket)
+            {
+                bucketStarts[bucket] = offset;
+                for (std::size_t task = 0; task < taskCount; ++task)
+                {
+                    const std::uint32_t count = bucketOffsets[task * BUCKET_COUNT + bucket];
+                    bucketOffsets[task * BUCKET_COUNT + bucket] = offset;
+                    offset += count;
+                }
+            }
+            bucketStarts[BUCKET_COUNT] = offset;
+
+            std::vector<KeyedCorner> partitioned(positionCount);
+            pool.ParallelFor(taskCount, [&](std::size_t task)
+                             {
+                std::uint32_t *offsets = &bucketOffsets[task * BUCKET_COUNT];
+                std::uint32_t id = static_cast<std::uint32_t>(positionStarts[task]);
+                for (const PositionKey &key : taskPositions[task])
+                    partitioned[offsets[GetBucket(HashKey(key))]++] = KeyedCorner{key, id++};
+                std::vector<PositionKey>().swap(taskPositions[task]); });
+
+            pool.ParallelFor(BUCKET_COUNT, [&](std::size_t bucket)
+                             {
+                PositionMap map(bucketStarts[bucket + 1] - bucketStarts[bucket]);
+                for (std::size_t i = bucketStarts[bucket]; i < bucketStarts[bucket + 1]; ++i)
+                {
+                    const KeyedCorner &entry = partitioned[i];
+                    vertexIds[entry.id] = map.FindOrInsert(entry.key, HashKey(entry.key), entry.id);
+                } });
+        }
+
+        // Number vertices in order of first use; first positions point at themselves
+        std::vector<std::size_t> vertexStarts(taskCount + 1, 0);
+        pool.ParallelFor(taskCount, [&](std::size_t task)
+                         {
+            std::size_t count = 0;
+            for (std::size_t id = positionStarts[task]; id < positionStarts[task + 1]; ++id)
+                count += vertexIds[id] == id;
+            vertexStarts[task + 1] = count; });
+        for (std::size_t task = 0; task < taskCount; ++task)
+        {
+            vertexStarts[task + 1] += vertexStarts[task];
+        }
+        pool.ParallelFor(taskCount, [&](std::size_t task)
+                         {
+            std::uint32_t vertex = static_cast<std::uint32_t>(vertexStarts[task]);
+            for (std::size_t id = positionStarts[task]; id < positionStarts[task + 1]; ++id)
+            {
+                if (vertexIds[id] == id)
+                    vertexIds[id] = vertex++ | LEADER_BIT;
+            } });
+
+        // Other positions only read first ones, which keep their marker until the indices are written
+        pool.ParallelFor(taskCount, [&](std::size_t task)
+                         {
+            for (std::size_t id = positionStarts[task]; id < positionStarts[task + 1]; ++id)
+            {
+                if (!(vertexIds[id] & LEADER_BIT))
+                    vertexIds[id] = vertexIds[vertexIds[id]] & ~LEADER_BIT;
+            } });
+
+        // Resolve the indices and copy each vertex position from the corner that first had it
+        mesh.vertices.assign(vertexStarts[taskCount] * 8, 0.0f);
+        pool.ParallelFor(taskCount, [&](std::size_t task)
+                         {
+            auto [begin, end] = getTaskCorners(task);
+            const std::uint32_t *ids = &vertexIds[positionStarts[task]];
+            for (std::size_t corner = begin; corner < end; ++corner)
+            {
+                const std::uint32_t index = mesh.indices[corner];
+                const std::uint32_t vertex = ids[index & ~LEADER_BIT];
+                mesh.indices[corner] = vertex & ~LEADER_BIT;
+                if ((index & LEADER_BIT) && (vertex & LEADER_BIT))
+                    std::memcpy(&mesh.vertices[std::size_t(vertex & ~LEADER_BIT) * 8], triangles + corner / 3 * TRIANGLE_SIZE + CORNER_OFFSET + corner % 3 * CORNER_SIZE, CORNER_SIZE);
+            } });
+        std::vector<std::uint32_t>().swap(vertexIds);
+
+        // Drop triangles that collapsed in the weld
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < cornerCount; i += 3)
+        {
+            const unsigned int a = mesh.indices[i], b = mesh.indices[i + 1], c = mesh.indices[i + 2];
+            if (a == b || b == c || a == c)
+                continue;
+            mesh.indices[kept++] = a;
+            mesh.indices[kept++] = b;
+            mesh.indices[kept++] = c;
+        }
+        mesh.indices.resize(kept);
+
+        MeshLoader::GenerateSmoothNormals(mesh);
+
+        std::cout << "Loaded STL file: " << filepath << " (" << triangleCount << " triangles, "
+                  << mesh.layout.GetVertexCount(mesh.vertices) << " vertices)" << std::endl;
+        std::vector<MeshData> result;
+        result.push_back(std::move(mesh));
+        return result;
+    }
+}
@@ -0,0 +1,286 @@
+#include "VertexCompressor.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <sstream>
+
+namespace Voltray::Engine
+{
+    namespace
+    {
+        constexpr std::size_t VERTICES_PER_TASK = 1 << 15;
+        constexpr float HALF_MAX = 65504.0f;
+
+        std::uint16_t ToUNorm16(float value)
+        {
+            return static_cast<std::uint16_t>(std::clamp(value, 0.0f, 1.0f) * 65535.0f + 0.5f);
+        }
+
+        std::int16_t ToSNorm16(float value)
+        {
+            const float scaled = std::clamp(value, -1.0f, 1.0f) * 32767.0f;
+            return static_cast<std::int16_t>(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        }
+
+        // Round to nearest even; callers keep values within the half range
+        std::uint16_t ToHalf(float value)
+        {
+            std::uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            const std::uint16_t sign = static_cast<std::uint16_t>((bits >> 16) & 0x8000);
+            const std::uint32_t magnitude = bits & 0x7FFFFFFF;
+
+            if (magnitude >= 0x477FF000) // Rounds to infinity, or is infinity or NaN
+                return sign | (magnitude > 0x7F800000 ? 0x7E00 : 0x7C00);
+            if (magnitude < 0x38800000) // Below the smallest normal half
+                return sign | static_cast<std::uint16_t>(std::nearbyint(std::fabs(value) * 16777216.0f));
+
+            // Rebias the exponent from 127 to 15 and round the dropped 13 mantissa bits
+            const std::uint32_t rounded = magnitude + 0xC8000FFF + ((magnitude >> 13) & 1);
+            return sign | static_cast<std::uint16_t>(rounded >> 13);
+        }
+
+        void EncodeOctahedral(const float *normal, std::int16_t *output)
+        {
+            float x = normal[0], y = normal[1], z = normal[2];
+            const float length = std::fabs(x) + std::fabs(y) + std::fabs(z);
+            if (length == 0.0f)
+            {
+                // Same up normal GenerateSmoothNormals gives unused vertices
+                x = 0.0f;
+                y = 1.0f;
+                z = 0.0f;
+            }
+            else
+            {
+                const float inverseLength = 1.0f / length;
+                x *= inverseLength;
+                y *= inverseLength;
+                z *= inverseLength;
+            }
+
+            // Fold the lower hemisphere over the diagonals of the upper one
+            if (z < 0.0f)
+            {
+                const float foldedX = (1.0f - std::fabs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+                const float foldedY = (1.0f - std::fabs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+                x = foldedX;
+                y = foldedY;
+            }
+            output[0] = ToSNorm16(x);
+            output[1] = ToSNorm16(y);
+        }
+
+        // Angle between a normal and its decoded unit copy, as a value that orders like the angle
+        // and is cheap per vertex: the squared sine of the normalized cross product below 90
+        // degrees, and two plus the cosine's magnitude beyond. The sine resolves the tiny angles
+        // of 16-bit encodings far better than the cosine.
+        float GetAngleError(const float *normal, const float *decoded)
+        {
+            const float cross[3] = {normal[1] * decoded[2] - normal[2] * decoded[1], normal[2] * decoded[0] - normal[0] * decoded[2],
+                                    normal[0] * decoded[1] - normal[1] * decoded[0]};
+            const float lengthSquared = normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2];
+            const float cosine = (normal[0] * decoded[0] + normal[1] * decoded[1] + normal[2] * decoded[2]) / std::sqrt(lengthSquared);
+            if (cosine <= 0.0f)
+                return 2.0f - cosine;
+            return (cross[0] * cross[0] + cross[1] * cross[1] + cross[2] * cross[2]) / lengthSquared;
+        }
+
+        float ToAngle(float angleError)
+        {
+            if (angleError > 1.0f)
+                return std::acos(std::clamp(2.0f - angleError, -1.0f, 0.0f));
+            return std::asin(std::sqrt(angleError));
+        }
+
+        struct TaskRange
+        {
+            Math::Vec3 minBounds = Math::Vec3(std::numeric_limits<float>::max());
+            Math::Vec3 maxBounds = Math::Vec3(std::numeric_limits<float>::lowest());
+            float minTexCoord = std::numeric_limits<float>::max();
+            float maxTexCoord = std::numeric_limits<float>::lowest();
+            float positionError = 0.0f; ///< Squared distance
+            float normalError = 0.0f;   ///< See GetAngleError
+            float texCoordError = 0.0f;
+        };
+    }
+
+    std::string VertexCompressionReport::ToString() const
+    {
+        const double originalBytes = double(originalStride) * vertexCount;
+        const double compressedBytes = double(compressedStride) * vertexCount;
+
+        std::ostringstream stream;
+        stream << "Compressed " << name << ": " << vertexCount << " vertices, " << originalStride << " -> " << compressedStride
+               << " bytes per vertex, " << originalBytes / (1024.0 * 1024.0) << " -> " << compressedBytes / (1024.0 * 1024.0)
+               << " MB (" << (originalBytes > 0.0 ? 100.0 * compressedBytes / originalBytes : 100.0) << "%); max error: position "
+               << maxPositionError << " (" << (boundsDiagonal > 0.0f ? 100.0f * maxPositionError / boundsDiagonal : 0.0f)
+               << "% of diagonal), normal " << maxNormalError << " deg, texcoord " << maxTexCoordError;
+        return stream.str();
+    }
+
+    VertexCompressionReport VertexCompressor::Compress(MeshData &meshData)
+    {
+        const VertexLayout &source = meshData.layout;
+        const std::size_t vertexCount = source.GetVertexCount(meshData.vertices);
+        const std::size_t sourceStride = source.GetFloatStride();
+
+        VertexCompressionReport report;
+        report.name = meshData.name;
+        report.vertexCount = vertexCount;
+        report.originalStride = source.GetStride();
+        report.compressedStride = source.GetStride();
+
+        const VertexElement *position = source.HasInPlacePositions() ? source.Find(VertexAttribute::Position) : nullptr;
+        const VertexElement *normal = source.Find(VertexAttribute::Normal);
+        if (normal && normal->format != VertexFormat::Float3)
+            normal = nullptr;
+        const VertexElement *texCoord = source.Find(VertexAttribute::TexCoord);
+        if (texCoord && texCoord->format != VertexFormat::Float2)
+            texCoord = nullptr;
+        if (vertexCount == 0 || (!position && !normal && !texCoord))
+            return report;
+
+        // Bounds of the positions and range of the texture coordinates decide the encodings
+        auto &pool = Utils::ThreadPool::GetInstance();
+        const std::size_t taskCount = (vertexCount + VERTICES_PER_TASK - 1) / VERTICES_PER_TASK;
+        std::vector<TaskRange> ranges(taskCount);
+        pool.ParallelFor(taskCount, [&](std::size_t task)
+                         {
+            TaskRange &range = ranges[task];
+            const std::size_t end = std::min(vertexCount, (task + 1) * VERTICES_PER_TASK);
+            for (std::size_t i = task * VERTICES_PER_TASK; i < end; ++i)
+            {
+                const float *vertex = &meshData.vertices[i * sourceStride];
+                if (position)
+                {
+                    range.minBounds = Math::Vec3(std::min(range.minBounds.x, vertex[0]), std::min(range.minBounds.y, vertex[1]), std::min(range.minBounds.z, vertex[2]));
+                    range.maxBounds = Math::Vec3(std::max(range.maxBounds.x, vertex[0]), std::max(range.maxBounds.y, vertex[1]), std::max(range.maxBounds.z, vertex[2]));
+                }
+                if (texCoord)
+                {
+                    const float *uv = vertex + texCoord->offset / sizeof(float);
+                    range.minTexCoord = std::min({range.minTexCoord, uv[0], uv[1]});
+                    range.maxTexCoord = std::max({range.maxTexCoord, uv[0], uv[1]});
+                }
+            } });
+
+        TaskRange total;
+        for (const TaskRange &range : ranges)
+        {
+            total.minBounds = Math::Vec3(std::min(total.minBounds.x, range.minBounds.x), std::min(total.minBounds.y, range.minBounds.y), std::min(total.minBounds.z, range.minBounds.z));
+            total.maxBounds = Math::Vec3(std::max(total.maxBounds.x, range.maxBounds.x), std::max(total.maxBounds.y, range.maxBounds.y), std::max(total.maxBounds.z, range.maxBounds.z));
+            total.minTexCoord = std::min(total.minTexCoord, range.minTexCoord);
+            total.maxTexCoord = std::max(total.maxTexCoord, range.maxTexCoord);
+        }
+
+        const Math::Vec3 extent = total.maxBounds - total.minBounds;
+        if (position && !(std::isfinite(extent.x) && std::isfinite(extent.y) && std::isfinite(extent.z)))
+            position = nullptr;
+
+        VertexFormat texCoordFormat = VertexFormat::Float2;
+        if (texCoord && total.minTexCoord >= 0.0f && total.maxTexCoord <= 1.0f)
+            texCoordFormat = VertexFormat::UNorm16x2;
+        else if (texCoord && total.minTexCoord >= -HALF_MAX && total.maxTexCoord <= HALF_MAX)
+            texCoordFormat = VertexFormat::Half2;
+
+        VertexLayout target;
+        for (const VertexElement &element : source.GetElements())
+        {
+            VertexFormat format = element.format;
+            if (&element == position)
+                format = VertexFormat::UNorm16x4;
+            else if (&element == normal)
+                format = VertexFormat::Octahedral16;
+            else if (&element == texCoord)
+                format = texCoordFormat;
+            target.Add(element.attribute, format);
+        }
+        if (position)
+            target.SetPositionDecode(total.minBounds, extent);
+        else
+            target.SetPositionDecode(source.GetPositionOffset(), source.GetPositionScale());
+
+        // Encode, then decode what was written to measure the error the shader will see
+        const Math::Vec3 inverseExtent(extent.x > 0.0f ? 1.0f / extent.x : 0.0f, extent.y > 0.0f ? 1.0f / extent.y : 0.0f,
+                                       extent.z > 0.0f ? 1.0f / extent.z : 0.0f);
+        const float extents[3] = {extent.x, extent.y, extent.z};
+        const std::size_t targetStride = target.GetFloatStride();
+        std::vector<float> vertices(vertexCount * targetStride);
+        pool.ParallelFor(taskCount, [&](std::size_t task)
+                         {
+            TaskRange &range = ranges[task];
+            const std::size_t end = std::min(vertexCount, (task + 1) * VERTICES_PER_TASK);
+            for (std::size_t i = task * VERTICES_PER_TASK; i < end; ++i)
+            {
+                const unsigned char *input = reinterpret_cast<const unsigned char *>(&meshData.vertices[i * sourceStride]);
+                unsigned char *output = reinterpret_cast<unsigned char *>(&vertices[i * targetStride]);
+                for (std::size_t e = 0; e < target.GetElements().size(); ++e)
+                {
+                    const VertexElement &from = source.GetElements()[e];
+                    const VertexElement &to = target.GetElements()[e];
+                    const float *value = reinterpret_cast<const float *>(input + from.offset);
+                    unsigned char *encoded = output + to.offset;
+
+                    if (&from == position)
+                    {
+                        const float scaled[3] = {(value[0] - total.minBounds.x) * inverseExtent.x, (value[1] - total.minBounds.y) * inverseExtent.y,
+                                                 (value[2] - total.minBounds.z) * inverseExtent.z};
+                        const std::uint16_t quantized[4] = {ToUNorm16(scaled[0]), ToUNorm16(scaled[1]), ToUNorm16(scaled[2]), 0};
+                        std::memcpy(encoded, quantized, sizeof(quantized));
+
+                        float error = 0.0f;
+                        for (int axis = 0; axis < 3; ++axis)
+                        {
+                            const float difference = (quantized[axis] * (1.0f / 65535.0f) - scaled[axis]) * extents[axis];
+                            error += difference * difference;
+                        }
+                        range.positionError = std::max(range.positionError, error);
+                    }
+                    else if (&from == normal)
+                    {
+                        std::int16_t octahedral[2];
+                        EncodeOctahedral(value, octahedral);
+                        std::memcpy(encoded, octahedral, sizeof(octahedral));
+
+                        float decoded[3];
+                        VertexLayout::Decode(VertexFormat::Octahedral16, encoded, decoded);
+                        if (value[0] != 0.0f || value[1] != 0.0f || value[2] != 0.0f)
+                            range.normalError = std::max(range.normalError, GetAngleError(value, decoded));
+                    }
+                    else if (&from == texCoord && to.format != from.format)
+                    {
+                        const std::uint16_t packed[2] = {
+                            to.format == VertexFormat::UNorm16x2 ? ToUNorm16(value[0]) : ToHalf(value[0]),
+                            to.format == VertexFormat::UNorm16x2 ? ToUNorm16(value[1]) : ToHalf(value[1])};
+                        std::memcpy(encoded, packed, sizeof(packed));
+
+                        float decoded[2];
+                        VertexLayout::Decode(to.format, encoded, decoded);
+                        range.texCoordError = std::max({range.texCoordError, std::fabs(decoded[0] - value[0]), std::fabs(decoded[1] - value[1])});
+                    }
+                    else
+                    {
+                        std::memcpy(encoded, value, VertexLayout::GetFormatSize(to.format));
+                    }
+                }
+            } });
+
+        for (const TaskRange &range : ranges)
+        {
+            report.maxPositionError = std::max(report.maxPositionError, std::sqrt(range.positionError));
+            report.maxNormalError = std::max(report.maxNormalError, ToAngle(range.normalError));
+            report.maxTexCoordError = std::max(report.maxTexCoordError, range.texCoordError);
+        }
+        report.maxNormalError *= 180.0f / 3.14159265358979f;
+        report.boundsDiagonal = position ? extent.Length() : 0.0f;
+        report.compressedStride = target.GetStride();
+
+        meshData.vertices = std::move(vertices);
+        meshData.layout = std::move(target);
+        return report;
+    }
+}
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Mesh.h"
+#include "IFormatLoader.h"
+
+namespace Voltray::Engine
+{
+    /**
+     * @class AsyncMeshLoader
+     * @brief Imports mesh files in the background and creates their meshes a few per frame
+     *
+     * Files are parsed into MeshData on the shared thread pool. Parsed files wait in a queue
+     * until ProcessUploads, called once per frame on the thread owning the GL context, turns
+     * them into meshes within a time budget and reports them to the requesters. The number of
+     * files being parsed or waiting for upload is bounded, so a large batch of requests does not
+     * hold all of its parsed data in memory at once; the rest wait for a free slot.
+     *
+     * Requests for a file that is already queued with the same vertex compression setting share
+     * one import. The setting is read when a file is requested, never by the workers. Meshes go through MeshCache,
+     * so files that are already loaded complete on the next ProcessUploads without parsing.
+     *
+     * All functions must be called on the thread owning the GL context.
+     */
+    class AsyncMeshLoader
+    {
+    public:
+        using RequestId = std::uint32_t;
+
+        /**
+         * @struct Result
+         * @brief Outcome of a request, passed to its callback
+         */
+        struct Result
+        {
+            std::vector<std::shared_ptr<Mesh>> meshes; ///< Empty if the import failed or was cancelled
+            std::string error;                         ///< Reason of a failed import
+            bool cancelled = false;
+
+            bool IsSuccess() const { return !meshes.empty(); }
+        };
+
+        using CompletionCallback = std::function<void(const Result &)>;
+
+        /**
+         * @struct Progress
+         * @brief Counters of the requests made since the loader was last idle
+         */
+        struct Progress
+        {
+            std::size_t queued = 0;    ///< Files waiting for a free slot
+            std::size_t loading = 0;   ///< Files being parsed or waiting for upload
+            std::size_t completed = 0; ///< Files loaded successfully
+            std::size_t failed = 0;    ///< Files that failed to import
+
+            std::size_t GetPending() const { return queued + loading; }
+            std::size_t GetTotal() const { return queued + loading + completed + failed; }
+        };
+
+        /**
+         * @brief Get the loader shared by the editor
+         * @return Reference to the loader instance
+         */
+        static AsyncMeshLoader &GetInstance();
+
+        /**
+         * @brief Start loading all meshes of a file
+         * @param filepath Path to the mesh file
+         * @param callback Called from ProcessUploads or Cancel once the request finishes
+         * @return Id that can be passed to Cancel
+         */
+        RequestId LoadAsync(const std::string &filepath, CompletionCallback callback);
+
+        /**
+         * @brief Cancel a request; its callback is invoked right away with a cancelled result
+         *
+         * A file that is already being parsed finishes in the background, but its meshes are
+         * only created if another request still needs them.
+         *
+         * @param id Request to cancel
+         * @return False if the request already finished
+         */
+        bool Cancel(RequestId id);
+
+        /**
+         * @brief Cancel all pending requests
+         */
+        void CancelAll();
+
+        /**
+         * @brief Create meshes for parsed files and report finished requests
+         *
+         * At least one parsed file is handled per call, further ones while the budget lasts.
+         *
+         * @param budgetMilliseconds Time to spend creating meshes
+         */
+        void ProcessUploads(double budgetMilliseconds);
+
+        /**
+         * @brief Set how many files may be parsing or waiting for upload at once
+         * @param count Maximum number of files, at least one
+         */
+        void SetMaxInFlight(std::size_t count);
+
+        /**
+         * @brief Get the request counters
+         * @return Counter snapshot
+         */
+        Progress GetProgress() const;
+
+        /**
+         * @brief Check whether any request is pending
+         * @return True while files are queued, parsing or waiting for upload
+         */
+        bool IsBusy() const { return !m_Jobs.empty(); }
+
+    private:
+        /**
+         * @brief Import of one file, shared by all requests for it
+         */
+        struct Job
+        {
+            std::string filepath;
+            std::string key;        ///< Path plus import variant, the key of m_Jobs
+            bool compressVertices;  ///< EngineSettings::CompressVertices when requested
+            std::vector<std::pair<RequestId, CompletionCallback>> requests;
+            std::future<std::vector<MeshData>> parsed;       ///< Valid once submitted to the pool
+            std::vector<std::shared_ptr<Mesh>> cachedMeshes; ///< Set if the file was already loaded
+            std::atomic<bool> cancelled{false};              ///< Read by the worker before parsing
+        };
+
+        AsyncMeshLoader();
+
+        /**
+         * @brief Submit queued jobs to the pool while slots are free
+         */
+        void StartJobs();
+
+        /**
+         * @brief Create the meshes of a finished job and run its callbacks
+         */
+        void FinishJob(Job &job);
+
+        std::unordered_map<std::string, std::shared_ptr<Job>> m_Jobs; ///< Pending jobs by Job::key
+        std::deque<std::shared_ptr<Job>> m_Queued;
+        std::vector<std::shared_ptr<Job>> m_InFlight;
+        std::size_t m_MaxInFlight;
+        std::size_t m_Completed = 0;
+        std::size_t m_Failed = 0;
+        RequestId m_NextRequestId = 1;
+    };
+}
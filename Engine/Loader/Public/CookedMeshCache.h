@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "IFormatLoader.h"
+
+namespace Voltray::Engine
+{
+    /**
+     * @class CookedMeshCache
+     * @brief On-disk copies of imported mesh data
+     *
+     * Importers such as Assimp spend most of a load in post-processing. The processed MeshData
+     * of each import is written to one binary file in the cache directory, named after a hash
+     * of the source file contents and the importer settings. Later loads of an unchanged file
+     * map the cooked copy instead, so they cost a read of the source for hashing plus a copy of
+     * the cooked arrays.
+     *
+     * All functions may be called from worker threads.
+     */
+    class CookedMeshCache
+    {
+    public:
+        /**
+         * @brief Set the directory cooked files are stored in, created on first write
+         * @param directory Cache directory; empty disables the cache
+         */
+        static void SetDirectory(const std::filesystem::path &directory);
+
+        /**
+         * @brief Get the directory cooked files are stored in
+         * @return Cache directory, empty if disabled
+         */
+        static std::filesystem::path GetDirectory();
+
+        /**
+         * @struct SourceKey
+         * @brief Identity of one import: source contents plus importer settings
+         */
+        struct SourceKey
+        {
+            std::uint64_t sourceHash = 0;
+            std::uint64_t sourceSize = 0;
+            std::uint64_t settingsKey = 0; ///< See IFormatLoader::GetImportSettingsKey
+        };
+
+        /**
+         * @brief Hash a source file to build its key
+         * @param filepath Path to the source mesh file
+         * @param settingsKey Import settings key of the loader
+         * @param key Receives the key
+         * @return False if the file cannot be read
+         */
+        static bool GetSourceKey(const std::string &filepath, std::uint64_t settingsKey, SourceKey &key);
+
+        /**
+         * @brief Load the cooked copy of an import
+         * @param key Key of the source file
+         * @param meshData Receives the cooked data
+         * @return True if a valid cooked copy was found
+         */
+        static bool Load(const SourceKey &key, std::vector<MeshData> &meshData);
+
+        /**
+         * @brief Write the cooked copy of an import
+         * @param key Key of the source file
+         * @param meshData Imported data to store
+         * @return True if the cooked file was written
+         */
+        static bool Store(const SourceKey &key, const std::vector<MeshData> &meshData);
+
+    private:
+        /**
+         * @brief Get the path of the cooked file for a key
+         */
+        static std::filesystem::path GetCookedPath(const std::filesystem::path &directory, const SourceKey &key);
+
+        static std::filesystem::path s_Directory;
+        static std::mutex s_DirectoryMutex;
+    };
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+namespace Voltray::Engine::CookedMeshFormat
+{
+    /**
+     * On-disk layout of cooked mesh files (.vmesh).
+     *
+     * A file is a Header, followed by meshCount fixed-size Mesh records, the vertex and index
+     * arrays of all meshes, and a string table. Arrays start at 4-byte aligned offsets so they
+     * can be copied straight out of a memory-mapped file. Strings are referenced by offset and
+     * length into the table and are not null-terminated. All values are little-endian.
+     *
+     * The header repeats the key the file is named after, so a truncated hash or a stale file
+     * is rejected instead of loaded. Files with another version are ignored and re-cooked.
+     */
+
+    constexpr std::uint32_t MAGIC = 0x48534D56; ///< "VMSH" read as a little-endian integer
+    constexpr std::uint32_t VERSION = 3;
+    constexpr std::uint32_t MAX_VERTEX_ELEMENTS = 8;
+
+    struct Header
+    {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint32_t meshCount;
+        std::uint32_t meshSize; ///< sizeof(Mesh) of the writer, checked on load
+        std::uint64_t sourceHash;
+        std::uint64_t sourceSize;
+        std::uint64_t settingsKey;
+        std::uint64_t meshOffset;
+        std::uint64_t stringTableOffset;
+        std::uint64_t stringTableSize;
+    };
+
+    struct StringRef
+    {
+        std::uint32_t offset;
+        std::uint32_t length;
+    };
+
+    struct Mesh
+    {
+        std::uint64_t vertexOffset;
+        std::uint64_t indexOffset;
+        std::uint32_t vertexCount; ///< Number of floats
+        std::uint32_t indexCount;
+        StringRef name;
+        StringRef materialName;
+        std::uint32_t elementCount;                         ///< Number of vertex attributes, in storage order
+        std::uint32_t vertexStride;                         ///< Bytes per vertex, checked against the rebuilt layout
+        std::uint8_t attributes[MAX_VERTEX_ELEMENTS];       ///< VertexAttribute values
+        std::uint8_t formats[MAX_VERTEX_ELEMENTS];          ///< VertexFormat values
+        float positionOffset[3];                            ///< VertexLayout position decode
+        float positionScale[3];
+    };
+
+    static_assert(sizeof(Header) == 64 && std::is_trivially_copyable_v<Header>, "Header layout is part of the file format");
+    static_assert(sizeof(Mesh) == 88 && std::is_trivially_copyable_v<Mesh>, "Mesh layout is part of the file format");
+}
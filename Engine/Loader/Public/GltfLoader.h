@@ -0,0 +1,30 @@
+#pragma once
+
+#include "IFormatLoader.h"
+
+namespace Voltray::Engine
+{
+    /**
+     * @class GltfLoader
+     * @brief Native loader for glTF 2.0 files, both .gltf with external or embedded buffers and .glb
+     *
+     * The JSON is parsed once and the binary buffers are memory-mapped (or, for GLB, used in
+     * place in the mapped file). Every primitive of every mesh node becomes one MeshData, with
+     * the node hierarchy's transform baked in. Primitives whose attributes interleave in one
+     * buffer view in formats the shader reads directly, including KHR_mesh_quantization data,
+     * are copied whole and keep the file's VertexLayout. Other accessors are read straight from
+     * the buffers into the standard layout in a single pass. Primitives are converted in parallel.
+     *
+     * glTF data is already triangulated and indexed, so none of Assimp's post-processing is
+     * repeated. Missing normals are generated smooth. Files requiring extensions this loader
+     * does not decode, such as mesh compression, and sparse accessors are passed on to
+     * AssimpLoader.
+     */
+    class GltfLoader : public IFormatLoader
+    {
+    public:
+        bool CanLoad(const std::string &extension) const override;
+        std::vector<MeshData> LoadMeshData(const std::string &filepath) override;
+        std::string GetLoaderName() const override { return "glTF Loader"; }
+    };
+}
@@ -1,10 +1,17 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <memory>
 #include "Mesh.h"
 
+struct aiScene;
+namespace Assimp
+{
+    class Importer;
+}
+
 namespace Voltray::Engine
 {
     /**
@@ -13,10 +20,11 @@ namespace Voltray::Engine
      */
     struct MeshData
     {
-        std::vector<float> vertices; // Position(3) + Normal(3) + TexCoord(2) per vertex
+        std::vector<float> vertices; // Interleaved vertices as described by layout
         std::vector<unsigned int> indices;
         std::string name;
         std::string materialName; // Optional material reference
+        VertexLayout layout = VertexLayout::Standard();
     };
 
     /**
@@ -45,6 +53,12 @@ namespace Voltray::Engine
                                                                                       * @return Loader name for debugging
                                                                                       */
         virtual std::string GetLoaderName() const = 0;
+
+        /**
+         * @brief Identify the import settings, so cooked copies are rebuilt when they change
+         * @return Key of the settings and loader version, 0 if imports should not be cooked
+         */
+        virtual std::uint64_t GetImportSettingsKey() const { return 0; }
     };
 
     /**
@@ -58,6 +72,23 @@ namespace Voltray::Engine
         bool CanLoad(const std::string &extension) const override;
         std::vector<MeshData> LoadMeshData(const std::string &filepath) override;
         std::string GetLoaderName() const override { return "Assimp Loader"; }
+        std::uint64_t GetImportSettingsKey() const override;
+
+        /**
+         * @brief Parse and post-process a file with the loader's import settings
+         * @param importer Importer owning the returned scene
+         * @param filepath Path to the mesh file
+         * @return Imported scene, valid while the importer lives
+         * @throws std::runtime_error if Assimp cannot import the file
+         */
+        static const aiScene *ImportScene(Assimp::Importer &importer, const std::string &filepath);
+
+        /**
+         * @brief Convert the meshes of an imported scene in parallel
+         * @param scene Scene returned by ImportScene
+         * @return Named MeshData of every triangle mesh, in scene order; points and lines are dropped
+         */
+        std::vector<MeshData> ConvertScene(const aiScene *scene);
 
     private:
         /**
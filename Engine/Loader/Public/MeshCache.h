@@ -0,0 +1,168 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Mesh.h"
+#include "IFormatLoader.h"
+
+namespace Voltray::Engine
+{
+    /**
+     * @class MeshCache
+     * @brief Cache of imported meshes keyed by file identity
+     *
+     * Files are identified by their canonical path, modification time and size, so editing a
+     * file on disk invalidates its entry. While any mesh of a file is alive, lookups return the
+     * same shared instances. Once the last one is destroyed, the file's MeshData moves to an LRU
+     * list bounded by a memory budget, so reloading a recently dropped asset only re-uploads it
+     * to the GPU instead of re-running the importer.
+     *
+     * Imports with and without vertex compression are separate entries, so changing the setting
+     * never hands out meshes in the other encoding.
+     *
+     * Meshes are created and destroyed on the thread owning the GL context; the counters may be
+     * read from any thread.
+     */
+    class MeshCache
+    {
+    public:
+        /**
+         * @struct Stats
+         * @brief Snapshot of the cache counters
+         */
+        struct Stats
+        {
+            std::uint64_t hits = 0;         ///< Lookups served from live meshes or cached data
+            std::uint64_t misses = 0;       ///< Lookups that needed a full import
+            std::size_t residentBytes = 0;  ///< Bytes of MeshData held in the LRU list
+            std::size_t budgetBytes = 0;    ///< Maximum bytes of MeshData kept in the LRU list
+            std::size_t liveFiles = 0;      ///< Files with at least one mesh alive
+            std::size_t cachedFiles = 0;    ///< Files whose data is held in the LRU list
+        };
+
+        /**
+         * @brief Get the cache shared by all mesh loads
+         * @return Reference to the cache instance
+         */
+        static MeshCache &GetInstance();
+
+        /**
+         * @brief Look up the meshes of a file
+         * @param filepath Path to the mesh file
+         * @param compressedVertices Whether the import compresses vertices
+         * @return All meshes of the file, or an empty vector if the file has to be imported
+         */
+        std::vector<std::shared_ptr<Mesh>> Find(const std::string &filepath, bool compressedVertices);
+
+        /**
+         * @brief Create meshes from freshly imported data and register them under the file
+         * @param filepath Path the data was imported from
+         * @param compressedVertices Whether the import compressed vertices
+         * @param meshData Imported data; entries without vertices or indices are skipped
+         * @return The created meshes
+         */
+        std::vector<std::shared_ptr<Mesh>> Insert(const std::string &filepath, bool compressedVertices, std::vector<MeshData> meshData);
+
+        /**
+         * @brief Set the memory budget of the LRU list, evicting data above it
+         * @param bytes Maximum number of bytes of MeshData to keep
+         */
+        void SetMemoryBudget(std::size_t bytes);
+
+        /**
+         * @brief Drop all cached data; live meshes stay valid but are no longer shared
+         */
+        void Clear();
+
+        /**
+         * @brief Get the hit, miss and memory counters
+         * @return Counter snapshot
+         */
+        Stats GetStats() const;
+
+    private:
+        /**
+         * @brief Identity of a file on disk
+         */
+        struct FileKey
+        {
+            std::string path;               ///< Canonical path
+            std::int64_t modifiedTime = 0;  ///< Last write time in filesystem clock ticks
+            std::uintmax_t size = 0;
+            std::string name;               ///< Path plus import variant, the key of the entry maps
+
+            bool IsSameVersion(const FileKey &other) const { return modifiedTime == other.modifiedTime && size == other.size; }
+        };
+
+        /**
+         * @brief Meshes of a file with at least one of them alive
+         *
+         * Each slot either holds a live mesh or, once that mesh was destroyed, its data.
+         */
+        struct LiveEntry
+        {
+            FileKey key;
+            std::uint64_t id = 0; ///< Distinguishes re-imports of the same path
+            std::vector<std::weak_ptr<Mesh>> meshes;
+            std::vector<MeshData> released;
+            std::vector<std::uint8_t> isReleased;
+            std::size_t releasedCount = 0;
+        };
+
+        /**
+         * @brief Data of a file whose meshes were all destroyed
+         */
+        struct CachedEntry
+        {
+            FileKey key;
+            std::vector<MeshData> meshData;
+            std::size_t bytes = 0;
+        };
+
+        MeshCache() = default;
+
+        /**
+         * @brief Build the identity of a file and import variant
+         * @return False if the file cannot be accessed
+         */
+        static bool GetFileKey(const std::string &filepath, bool compressedVertices, FileKey &key);
+
+        /**
+         * @brief Create meshes for a file and track them as its live entry; the mutex must be held
+         */
+        std::vector<std::shared_ptr<Mesh>> Register(const FileKey &key, std::vector<MeshData> meshData);
+
+        /**
+         * @brief Create a mesh whose destruction hands its data back to the cache
+         */
+        std::shared_ptr<Mesh> CreateMesh(const LiveEntry &entry, std::size_t slot, const MeshData &data);
+
+        /**
+         * @brief Called when a cached mesh is destroyed
+         */
+        void OnMeshReleased(const std::string &name, std::uint64_t id, std::size_t slot, MeshData data);
+
+        /**
+         * @brief Evict least recently used data until the list fits the budget
+         */
+        void TrimToBudget();
+
+        using LruList = std::list<CachedEntry>;
+
+        std::unordered_map<std::string, LiveEntry> m_Live;
+        LruList m_Lru; ///< Most recently released first
+        std::unordered_map<std::string, LruList::iterator> m_LruIndex;
+        std::size_t m_ResidentBytes = 0;
+        std::size_t m_BudgetBytes = 256ull * 1024 * 1024;
+        std::uint64_t m_Hits = 0;
+        std::uint64_t m_Misses = 0;
+        std::uint64_t m_NextId = 1;
+        mutable std::mutex m_Mutex;
+    };
+}
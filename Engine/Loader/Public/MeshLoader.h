@@ -33,13 +33,61 @@ namespace Voltray::Engine
          */
         static std::vector<std::shared_ptr<Mesh>> LoadMeshes(const std::string &filepath);
 
+        /**
+         * @brief Load the first mesh of several files, parsing the files concurrently
+         *
+         * Every distinct path is imported once, on the shared thread pool. Meshes are created
+         * on the calling thread, which must own the GL context, as soon as each file is parsed.
+         *
+         * @param filepaths Paths to load, duplicates allowed
+         * @return One mesh per input path in input order, nullptr where loading failed;
+         *         duplicate paths share the same mesh
+         */
+        static std::vector<std::shared_ptr<Mesh>> LoadMeshBatch(const std::vector<std::string> &filepaths);
+
         /**
          * @brief Load raw mesh data for custom processing
+         *
+         * Compresses vertices if EngineSettings::CompressVertices is set, so call it on the
+         * thread that owns the settings; workers use the overload taking the flag.
+         *
          * @param filepath Path to the mesh file
          * @return Vector of MeshData structures
          */
         static std::vector<MeshData> LoadMeshData(const std::string &filepath);
 
+        /**
+         * @brief Load raw mesh data with an explicit vertex compression choice
+         * @param filepath Path to the mesh file
+         * @param compressVertices Whether to compress the imported vertices
+         * @return Vector of MeshData structures
+         */
+        static std::vector<MeshData> LoadMeshData(const std::string &filepath, bool compressVertices);
+
+        /**
+         * @brief Load raw mesh data, reporting failures as exceptions instead of logging them
+         *
+         * Touches no GL state and reads no settings, so it can run on worker threads.
+         *
+         * @param filepath Path to the mesh file
+         * @param compressVertices Whether to compress the imported vertices, read from
+         *                         EngineSettings by the caller when the load is requested
+         * @return Vector of MeshData structures
+         * @throws std::runtime_error if the file is missing, unsupported or fails to import
+         */
+        static std::vector<MeshData> ImportMeshData(const std::string &filepath, bool compressVertices);
+
+        /**
+         * @brief Replace the normals of indexed mesh data with area-weighted smooth normals
+         *
+         * Used by loaders for formats that store no normals. Vertices not used by any triangle
+         * get an up normal.
+         *
+         * @param meshData Mesh data whose layout has float positions first and a float normal;
+         *                 other layouts are left unchanged
+         */
+        static void GenerateSmoothNormals(MeshData &meshData);
+
         /**
          * @brief Check if file format is supported
          * @param filepath Path to check
@@ -78,5 +126,11 @@ namespace Voltray::Engine
          * @return Vector of all available loaders
          */
         static std::vector<std::shared_ptr<IFormatLoader>> GetAllLoaders();
+
+        /**
+         * @brief Compress freshly imported meshes in parallel and log a size and accuracy report per mesh
+         * @param meshData Meshes to compress in place
+         */
+        static void CompressVertices(std::vector<MeshData> &meshData);
     };
 }
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "IFormatLoader.h"
+
+namespace Voltray::Engine
+{
+    /**
+     * @class ObjLoader
+     * @brief Native loader for Wavefront OBJ files
+     *
+     * The file is memory-mapped and split at line boundaries into chunks that are parsed in
+     * parallel on the shared thread pool with a hand-written number parser. The chunks are then
+     * stitched together: relative indices are resolved, faces are fan-triangulated and identical
+     * position/texcoord/normal triplets are merged through a flat hash map.
+     *
+     * The output matches what AssimpLoader produces for OBJ files: one mesh per material,
+     * flipped texture coordinates and smooth normals where the file has none.
+     */
+    class ObjLoader : public IFormatLoader
+    {
+    public:
+        bool CanLoad(const std::string &extension) const override;
+        std::vector<MeshData> LoadMeshData(const std::string &filepath) override;
+        std::string GetLoaderName() const override { return "OBJ Loader"; }
+    };
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "IFormatLoader.h"
+
+namespace Voltray::Engine
+{
+    /**
+     * @class PlyLoader
+     * @brief Native loader for binary PLY files
+     *
+     * The file is memory-mapped and the vertex and face elements are decoded in parallel,
+     * straight into vertex and index buffers sized from the header and a quick scan of the face
+     * list lengths. PLY meshes are already indexed, so no welding is needed.
+     *
+     * Positions, normals and texture coordinates are read from the usual property names; other
+     * properties and elements are skipped. Missing normals are generated smooth. ASCII files
+     * and vertex elements with list properties are passed on to AssimpLoader.
+     */
+    class PlyLoader : public IFormatLoader
+    {
+    public:
+        bool CanLoad(const std::string &extension) const override;
+        std::vector<MeshData> LoadMeshData(const std::string &filepath) override;
+        std::string GetLoaderName() const override { return "PLY Loader"; }
+    };
+}
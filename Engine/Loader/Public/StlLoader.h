@@ -0,0 +1,27 @@
+#pragma once
+
+#include "IFormatLoader.h"
+
+namespace Voltray::Engine
+{
+    /**
+     * @class StlLoader
+     * @brief Native loader for binary STL files
+     *
+     * The file is memory-mapped and its triangles are read in place. Corners with identical
+     * positions are welded in parallel: first within blocks of neighbouring triangles, then
+     * across blocks by partitioning the remaining positions into buckets by a spatial hash and
+     * deduplicating every bucket on its own. The index buffer is sized once and holds the
+     * intermediate numbering, so peak memory stays close to the final mesh.
+     *
+     * Welded vertices get smooth normals; the facet normals stored in the file are ignored.
+     * ASCII STL files are passed on to AssimpLoader.
+     */
+    class StlLoader : public IFormatLoader
+    {
+    public:
+        bool CanLoad(const std::string &extension) const override;
+        std::vector<MeshData> LoadMeshData(const std::string &filepath) override;
+        std::string GetLoaderName() const override { return "STL Loader"; }
+    };
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "IFormatLoader.h"
+#include <cstddef>
+#include <string>
+
+namespace Voltray::Engine
+{
+    /**
+     * @struct VertexCompressionReport
+     * @brief Size and accuracy of one compressed mesh
+     */
+    struct VertexCompressionReport
+    {
+        std::string name;
+        std::size_t vertexCount = 0;
+        unsigned int originalStride = 0;   ///< Bytes per vertex before compression
+        unsigned int compressedStride = 0; ///< Bytes per vertex after compression
+        float maxPositionError = 0.0f;     ///< Largest distance between an original and a decoded position
+        float boundsDiagonal = 0.0f;       ///< Diagonal of the mesh bounds, for relating the position error
+        float maxNormalError = 0.0f;       ///< Largest angle between an original and a decoded normal, in degrees
+        float maxTexCoordError = 0.0f;     ///< Largest difference of a decoded texture coordinate component
+
+        /**
+         * @brief Formats the report as a single log line.
+         * @return Human readable summary.
+         */
+        std::string ToString() const;
+    };
+
+    /**
+     * @class VertexCompressor
+     * @brief Re-encodes imported vertices into compact formats the vertex shader decodes
+     *
+     * Float positions become 16-bit values relative to the mesh bounds (UNorm16x4 plus the
+     * layout's position decode), float normals become octahedral 2x16-bit values and float
+     * texture coordinates become UNorm16x2, or Half2 when they leave [0, 1]. Other attributes
+     * are copied unchanged. The standard 32-byte vertex shrinks to 16 bytes.
+     */
+    class VertexCompressor
+    {
+    public:
+        /**
+         * @brief Compresses the vertices of a mesh in place.
+         *
+         * Every vertex is decoded again after encoding to measure the error the GPU will see.
+         * Large meshes are processed in parallel on the shared ThreadPool.
+         * @param meshData Mesh to compress; its layout is replaced.
+         * @return Sizes and maximum errors, with equal strides if nothing could be compressed.
+         */
+        static VertexCompressionReport Compress(MeshData &meshData);
+    };
+}
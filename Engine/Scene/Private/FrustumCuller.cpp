@@ -0,0 +1,66 @@
+#include "FrustumCuller.h"
+
+namespace Voltray::Engine
+{
+
+    void FrustumCuller::Cull(const std::vector<std::shared_ptr<SceneObject>> &objects, const Mat4 &viewProjection,
+                             std::vector<SceneObject *> &visible)
+    {
+        visible.clear();
+        m_Candidates.clear();
+
+        for (const auto &object : objects)
+        {
+            if (object && object->IsVisible() && object->GetMesh())
+                m_Candidates.push_back(object.get());
+        }
+
+        const std::size_t count = m_Candidates.size();
+        m_Stats.tested = count;
+
+        if (!m_Enabled)
+        {
+            visible.assign(m_Candidates.begin(), m_Candidates.end());
+            m_Stats.culled = 0;
+            m_Stats.drawn = count;
+            return;
+        }
+
+        m_MinX.resize(count);
+        m_MinY.resize(count);
+        m_MinZ.resize(count);
+        m_MaxX.resize(count);
+        m_MaxY.resize(count);
+        m_MaxZ.resize(count);
+        m_Visible.resize(count);
+
+        // Gather world bounds (cached per object) into contiguous arrays for the batch test
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            Vec3 minBounds, maxBounds;
+            m_Candidates[i]->GetWorldBounds(minBounds, maxBounds);
+            m_MinX[i] = minBounds.x;
+            m_MinY[i] = minBounds.y;
+            m_MinZ[i] = minBounds.z;
+            m_MaxX[i] = maxBounds.x;
+            m_MaxY[i] = maxBounds.y;
+            m_MaxZ[i] = maxBounds.z;
+        }
+
+        Frustum frustum(viewProjection);
+        frustum.IntersectsAABBs(m_MinX.data(), m_MinY.data(), m_MinZ.data(),
+                                m_MaxX.data(), m_MaxY.data(), m_MaxZ.data(),
+                                count, m_Visible.data());
+
+        visible.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (m_Visible[i])
+                visible.push_back(m_Candidates[i]);
+        }
+
+        m_Stats.drawn = visible.size();
+        m_Stats.culled = count - m_Stats.drawn;
+    }
+
+}
@@ -1,11 +1,16 @@
 #include "Scene.h"
 #include "SceneObjectFactory.h"
+#include "MeshLoader.h"
 #include "Console.h"
+#include "MappedFile.h"
+#include "ThreadPool.h"
 #include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <filesystem>
 #include <limits>
 #include <nlohmann/json.hpp>
+#include <stdexcept>
 
 using json = nlohmann::json;
 using Voltray::Editor::Components::Console;
@@ -13,6 +18,139 @@ using Voltray::Editor::Components::Console;
 namespace Voltray::Engine
 {
 
+    namespace
+    {
+        /**
+         * @brief Appends strings to a scene file string table, storing repeated strings once.
+         */
+        class StringTable
+        {
+        public:
+            explicit StringTable(std::string &table) : m_Table(table) {}
+
+            /// The string must stay alive while the table is in use; it is used as the lookup key
+            SceneFormat::StringRef Add(std::string_view text)
+            {
+                auto it = m_Offsets.find(text);
+                if (it != m_Offsets.end())
+                    return it->second;
+
+                const SceneFormat::StringRef ref{static_cast<std::uint32_t>(m_Table.size()), static_cast<std::uint32_t>(text.size())};
+                m_Table.append(text);
+                m_Offsets.emplace(text, ref);
+                return ref;
+            }
+
+        private:
+            std::string &m_Table;
+            std::unordered_map<std::string_view, SceneFormat::StringRef> m_Offsets;
+        };
+
+        std::string_view GetString(std::string_view strings, SceneFormat::StringRef ref)
+        {
+            if (ref.offset > strings.size() || ref.length > strings.size() - ref.offset)
+                throw std::runtime_error("string reference outside the string table");
+            return strings.substr(ref.offset, ref.length);
+        }
+
+        void StoreVec3(float (&destination)[3], const Vec3 &value)
+        {
+            destination[0] = value.x;
+            destination[1] = value.y;
+            destination[2] = value.z;
+        }
+
+        Vec3 LoadVec3(const float (&source)[3])
+        {
+            return Vec3(source[0], source[1], source[2]);
+        }
+
+        /**
+         * @brief Builds the JSON export of a set of file records.
+         */
+        json ExportJson(const std::vector<SceneFormat::Object> &objects, std::string_view strings)
+        {
+            json root;
+            root["version"] = "1.0";
+            root["objects"] = json::array();
+
+            for (const SceneFormat::Object &record : objects)
+            {
+                json objJson;
+                objJson["name"] = GetString(strings, record.name);
+                objJson["visible"] = (record.flags & SceneFormat::OBJECT_VISIBLE) != 0;
+                objJson["selected"] = (record.flags & SceneFormat::OBJECT_SELECTED) != 0;
+
+                json transformJson;
+                transformJson["position"] = {{"x", record.position[0]}, {"y", record.position[1]}, {"z", record.position[2]}};
+                transformJson["rotation"] = {{"x", record.rotation[0]}, {"y", record.rotation[1]}, {"z", record.rotation[2]}};
+                transformJson["scale"] = {{"x", record.scale[0]}, {"y", record.scale[1]}, {"z", record.scale[2]}};
+                objJson["transform"] = transformJson;
+
+                objJson["materialColor"] = {{"r", record.materialColor[0]}, {"g", record.materialColor[1]}, {"b", record.materialColor[2]}};
+                objJson["meshFilePath"] = GetString(strings, record.meshFilePath);
+                objJson["parent"] = record.parent;
+
+                root["objects"].push_back(std::move(objJson));
+            }
+            return root;
+        }
+
+        /**
+         * @brief Converts a JSON scene into file records. Missing fields get their defaults.
+         */
+        void ImportJson(const json &root, std::vector<SceneFormat::Object> &objects, std::string &strings)
+        {
+            if (!root.contains("objects") || !root["objects"].is_array())
+                return;
+
+            // Keys point into the JSON document, which outlives the table
+            StringTable table(strings);
+            const auto readVec3 = [](const json &parent, const char *key, const char *x, const char *y, const char *z, float (&destination)[3])
+            {
+                if (parent.contains(key))
+                {
+                    const auto &value = parent[key];
+                    destination[0] = value[x].get<float>();
+                    destination[1] = value[y].get<float>();
+                    destination[2] = value[z].get<float>();
+                }
+            };
+
+            objects.reserve(root["objects"].size());
+            for (const auto &objJson : root["objects"])
+            {
+                SceneFormat::Object record{};
+                record.parent = -1;
+                record.flags = SceneFormat::OBJECT_VISIBLE;
+                StoreVec3(record.scale, Vec3(1.0f, 1.0f, 1.0f));
+                StoreVec3(record.materialColor, Vec3(1.0f, 1.0f, 1.0f));
+
+                if (objJson.contains("name"))
+                    record.name = table.Add(objJson["name"].get_ref<const std::string &>());
+                if (objJson.contains("meshFilePath"))
+                    record.meshFilePath = table.Add(objJson["meshFilePath"].get_ref<const std::string &>());
+                if (objJson.contains("parent"))
+                    record.parent = objJson["parent"].get<std::int32_t>();
+                if (objJson.contains("visible") && !objJson["visible"].get<bool>())
+                    record.flags &= ~SceneFormat::OBJECT_VISIBLE;
+                if (objJson.contains("selected") && objJson["selected"].get<bool>())
+                    record.flags |= SceneFormat::OBJECT_SELECTED;
+
+                if (objJson.contains("transform"))
+                {
+                    const auto &transformJson = objJson["transform"];
+                    readVec3(transformJson, "position", "x", "y", "z", record.position);
+                    readVec3(transformJson, "rotation", "x", "y", "z", record.rotation);
+                    readVec3(transformJson, "scale", "x", "y", "z", record.scale);
+                }
+                readVec3(objJson, "materialColor", "r", "g", "b", record.materialColor);
+
+                objects.push_back(record);
+            }
+        }
+    }
+
     Scene::Scene()
     {
     }
@@ -24,58 +162,114 @@ namespace Voltray::Engine
 
     SceneObject &Scene::AddObject(std::shared_ptr<SceneObject> object)
     {
-        m_Objects.push_back(object);
+        RegisterObject(object);
         return *object;
     }
 
     SceneObject &Scene::AddObject(std::shared_ptr<Mesh> mesh, const std::string &name)
     {
         auto object = std::make_shared<SceneObject>(mesh, name);
-        m_Objects.push_back(object);
+        RegisterObject(object);
         return *object;
     }
 
     bool Scene::RemoveObject(const std::string &name)
     {
-        auto it = std::find_if(m_Objects.begin(), m_Objects.end(),
-                               [&name](const std::shared_ptr<SceneObject> &obj)
-                               {
-                                   return obj->GetName() == name;
-                               });
+        return RemoveObject(FindObject(name));
+    }
 
-        if (it != m_Objects.end())
-        {
-            m_Objects.erase(it);
-            return true;
-        }
-        return false;
+    bool Scene::RemoveObject(SceneObjectHandle handle)
+    {
+        return RemoveObject(FindObject(handle));
     }
 
     bool Scene::RemoveObject(std::shared_ptr<SceneObject> object)
     {
-        auto it = std::find(m_Objects.begin(), m_Objects.end(), object);
-        if (it != m_Objects.end())
+        if (!object || !m_Records.count(object.get()))
+            return false;
+
+        // Children stay in the scene where they are, attached to the removed object's parent
+        std::vector<SceneObject *> children = object->GetChildren();
+        for (SceneObject *child : children)
         {
-            m_Objects.erase(it);
-            return true;
+            child->SetParent(object->GetParent());
         }
-        return false;
+        object->SetParent(nullptr);
+
+        UnregisterObject(object.get());
+        return true;
     }
 
     std::shared_ptr<SceneObject> Scene::FindObject(const std::string &name) const
     {
-        auto it = std::find_if(m_Objects.begin(), m_Objects.end(),
-                               [&name](const std::shared_ptr<SceneObject> &obj)
-                               {
-                                   return obj->GetName() == name;
-                               });
+        auto it = m_NameIndex.find(name);
+        if (it == m_NameIndex.end())
+            return nullptr;
 
-        return (it != m_Objects.end()) ? *it : nullptr;
+        return m_Objects[m_Slots[it->second.front()].objectIndex];
+    }
+
+    std::shared_ptr<SceneObject> Scene::FindObject(SceneObjectHandle handle) const
+    {
+        if (handle.index >= m_Slots.size())
+            return nullptr;
+
+        const Slot &slot = m_Slots[handle.index];
+        if (slot.generation != handle.generation || slot.objectIndex == SceneObjectHandle::INVALID_INDEX)
+            return nullptr;
+
+        return m_Objects[slot.objectIndex];
+    }
+
+    SceneObjectHandle Scene::GetHandle(const SceneObject *object) const
+    {
+        auto it = m_Records.find(const_cast<SceneObject *>(object));
+        if (it == m_Records.end())
+            return SceneObjectHandle();
+
+        return SceneObjectHandle{it->second.slot, m_Slots[it->second.slot].generation};
     }
 
     void Scene::Clear()
     {
+        for (auto &entry : m_Records)
+        {
+            entry.first->GetTransform().SetChangedCallback(nullptr);
+            entry.first->SetRenamedCallback(nullptr);
+        }
+        m_Records.clear();
+        m_DirtyObjects.clear();
+        m_SpatialIndex.Clear();
+        m_NameIndex.clear();
+
+        // Keep the slots so handles from before the clear stay stale instead of being reused
+        for (std::uint32_t slot : m_ObjectSlots)
+        {
+            m_Slots[slot].objectIndex = SceneObjectHandle::INVALID_INDEX;
+            ++m_Slots[slot].generation;
+            m_FreeSlots.push_back(slot);
+        }
+        m_ObjectSlots.clear();
         m_Objects.clear();
+
+        if (!m_Selection.empty())
+        {
+            for (auto &selected : m_Selection)
+            {
+                selected->SetSelected(false);
+            }
+            m_Selection.clear();
+            NotifySelectionChanged();
+        }
+    }
+
+    void Scene::Reserve(std::size_t objectCount)
+    {
+        m_Objects.reserve(objectCount);
+        m_ObjectSlots.reserve(objectCount);
+        m_Slots.reserve(objectCount);
+        m_NameIndex.reserve(objectCount);
+        m_Records.reserve(objectCount);
     }
 
     void Scene::Update(float deltaTime)
@@ -87,120 +281,155 @@ namespace Voltray::Engine
                 object->Update(deltaTime);
             }
         }
+
+        // Rebuild every matrix touched by this frame's updates in one batched pass
+        auto &pool = Utils::ThreadPool::GetInstance();
+        TransformStore::GetInstance().UpdateMatrices([&pool](std::size_t count, const std::function<void(std::size_t)> &body)
+                                                     { pool.ParallelFor(count, body); });
     }
 
-    void Scene::Render(Renderer &renderer, const BaseCamera &camera, Shader &shader)
+    void Scene::SelectObject(std::shared_ptr<SceneObject> object)
     {
-        // Set the camera view-projection matrix for all objects
-        shader.Bind();
-        shader.SetUniformMat4("u_ViewProjection", camera.GetViewProjectionMatrix().data);
-
-        for (auto &object : m_Objects)
+        if (!object || !m_Records.count(object.get()))
         {
-            if (object && object->IsVisible() && object->GetMesh())
-            {
-                // Call the object's pre-render hook
-                object->OnRender();
-
-                // Get the model matrix and render the object
-                Mat4 modelMatrix = object->GetModelMatrix();
-                shader.SetUniformMat4("u_Model", modelMatrix.data);
+            ClearSelection();
+            return;
+        }
+        if (m_Selection.size() == 1 && m_Selection.front() == object)
+            return;
 
-                renderer.Draw(*object->GetMesh(), shader, modelMatrix);
-            }
+        for (auto &selected : m_Selection)
+        {
+            selected->SetSelected(false);
         }
+        m_Selection.assign(1, object);
+        object->SetSelected(true);
+        NotifySelectionChanged();
     }
 
-    void Scene::SelectObject(std::shared_ptr<SceneObject> object)
+    void Scene::AddToSelection(std::shared_ptr<SceneObject> object)
     {
-        // Clear all selections first
-        ClearSelection();
+        if (!object || !m_Records.count(object.get()))
+            return;
 
-        // Select the specified object if it exists in the scene
-        if (object && std::find(m_Objects.begin(), m_Objects.end(), object) != m_Objects.end())
+        if (object->IsSelected())
         {
-            object->SetSelected(true);
+            if (m_Selection.back() == object)
+                return;
+            m_Selection.erase(std::find(m_Selection.begin(), m_Selection.end(), object));
         }
+        m_Selection.push_back(object);
+        object->SetSelected(true);
+        NotifySelectionChanged();
+    }
+
+    void Scene::RemoveFromSelection(const SceneObject *object)
+    {
+        if (!IsSelected(object))
+            return;
+
+        m_Selection.erase(std::find_if(m_Selection.begin(), m_Selection.end(),
+                                       [object](const std::shared_ptr<SceneObject> &selected)
+                                       {
+                                           return selected.get() == object;
+                                       }));
+        const_cast<SceneObject *>(object)->SetSelected(false);
+        NotifySelectionChanged();
     }
 
     void Scene::ClearSelection()
     {
-        for (auto &obj : m_Objects)
+        if (m_Selection.empty())
+            return;
+
+        for (auto &selected : m_Selection)
         {
-            if (obj)
-            {
-                obj->SetSelected(false);
-            }
+            selected->SetSelected(false);
         }
+        m_Selection.clear();
+        NotifySelectionChanged();
+    }
+
+    bool Scene::IsSelected(const SceneObject *object) const
+    {
+        return object && object->IsSelected() && m_Records.count(const_cast<SceneObject *>(object));
     }
+
     std::shared_ptr<SceneObject> Scene::GetSelectedObject() const
     {
-        for (auto &obj : m_Objects)
+        return m_Selection.empty() ? nullptr : m_Selection.back();
+    }
+
+    Scene::ListenerId Scene::AddSelectionListener(SelectionListener listener)
+    {
+        const ListenerId id = m_NextListenerId++;
+        m_SelectionListeners.emplace_back(id, std::move(listener));
+        return id;
+    }
+
+    void Scene::RemoveSelectionListener(ListenerId id)
+    {
+        m_SelectionListeners.erase(std::remove_if(m_SelectionListeners.begin(), m_SelectionListeners.end(),
+                                                  [id](const std::pair<ListenerId, SelectionListener> &entry)
+                                                  {
+                                                      return entry.first == id;
+                                                  }),
+                                   m_SelectionListeners.end());
+    }
+
+    void Scene::NotifySelectionChanged()
+    {
+        // Iterate a copy so listeners can unregister themselves
+        const auto listeners = m_SelectionListeners;
+        for (const auto &entry : listeners)
         {
-            if (obj && obj->IsSelected())
-            {
-                return obj;
-            }
+            entry.second(*this);
         }
-        return nullptr;
     }
+
     bool Scene::SaveToFile(const std::string &filepath) const
     {
         try
         {
-            json root;
-            root["version"] = "1.0";
-            root["objects"] = json::array();
-
-            // Serialize each object
-            for (const auto &obj : m_Objects)
-            {
-                if (!obj)
-                    continue;
-
-                json objJson;
-                objJson["name"] = obj->GetName();
-                objJson["visible"] = obj->IsVisible();
-                objJson["selected"] = obj->IsSelected(); // Transform data
-                const auto &transform = obj->GetTransform();
-                json transformJson;
-
-                const auto &pos = transform.GetPosition();
-                transformJson["position"]["x"] = pos.x;
-                transformJson["position"]["y"] = pos.y;
-                transformJson["position"]["z"] = pos.z;
-                const auto &rot = transform.GetRotation();
-                transformJson["rotation"]["x"] = rot.x;
-                transformJson["rotation"]["y"] = rot.y;
-                transformJson["rotation"]["z"] = rot.z;
-
-                const auto &scale = transform.GetScale();
-                transformJson["scale"]["x"] = scale.x;
-                transformJson["scale"]["y"] = scale.y;
-                transformJson["scale"]["z"] = scale.z;
-
-                objJson["transform"] = transformJson; // Material color
-                const auto &color = obj->GetMaterialColor();
-                objJson["materialColor"]["r"] = color.x;
-                objJson["materialColor"]["g"] = color.y;
-                objJson["materialColor"]["b"] = color.z; // Store mesh file path if it was loaded from a file
-                objJson["meshFilePath"] = obj->GetMeshFilePath();
-
-                root["objects"].push_back(objJson);
-            }
+            std::vector<SceneFormat::Object> objects;
+            std::string strings;
+            WriteRecords(objects, strings);
 
             // Create directory if it doesn't exist
             std::filesystem::path scenePath(filepath);
             std::filesystem::create_directories(scenePath.parent_path()); // Write to file
-            std::ofstream file(filepath);
+            std::ofstream file(filepath, std::ios::binary);
             if (!file.is_open())
             {
                 Console::PrintError("Failed to open scene file for writing: " + filepath);
                 return false;
             }
 
-            file << root.dump(2); // Pretty print with 2 space indentation
+            if (scenePath.extension() == ".json")
+            {
+                file << ExportJson(objects, strings).dump(2); // Pretty print with 2 space indentation
+            }
+            else
+            {
+                SceneFormat::Header header{};
+                header.magic = SceneFormat::MAGIC;
+                header.version = SceneFormat::VERSION;
+                header.objectCount = static_cast<std::uint32_t>(objects.size());
+                header.objectSize = sizeof(SceneFormat::Object);
+                header.objectOffset = sizeof(SceneFormat::Header);
+                header.stringTableOffset = header.objectOffset + objects.size() * sizeof(SceneFormat::Object);
+                header.stringTableSize = strings.size();
+
+                file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+                file.write(reinterpret_cast<const char *>(objects.data()), static_cast<std::streamsize>(objects.size() * sizeof(SceneFormat::Object)));
+                file.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+            }
             file.close();
+            if (!file)
+            {
+                Console::PrintError("Failed to write scene file: " + filepath);
+                return false;
+            }
 
             Console::Print("Scene saved to: " + filepath);
             return true;
@@ -221,123 +450,63 @@ namespace Voltray::Engine
                 Console::PrintError("Scene file not found: " + filepath);
                 return false;
             }
-            std::ifstream file(filepath);
-            if (!file.is_open())
+            Utils::MappedFile file;
+            if (!file.Open(filepath))
             {
                 Console::PrintError("Failed to open scene file for reading: " + filepath);
                 return false;
             }
 
-            json root;
-            try
-            {
-                file >> root;
-            }
-            catch (const json::parse_error &e)
-            {
-                Console::PrintError("Failed to parse scene file: " + std::string(e.what()));
-                return false;
-            }
+            const unsigned char *data = file.GetData();
+            const std::size_t size = file.GetSize();
 
-            // Clear current scene
-            Clear();
+            std::uint32_t magic = 0;
+            if (size >= sizeof(magic))
+                std::memcpy(&magic, data, sizeof(magic));
 
-            // Load objects
-            if (root.contains("objects") && root["objects"].is_array())
+            if (magic == SceneFormat::MAGIC)
             {
-                for (const auto &objJson : root["objects"])
+                // Validate everything the records are read through; they are used in place
+                SceneFormat::Header header;
+                if (size < sizeof(header))
+                {
+                    Console::PrintError("Scene file is truncated: " + filepath);
+                    return false;
+                }
+                std::memcpy(&header, data, sizeof(header));
+                if (header.version > SceneFormat::VERSION || header.objectSize != sizeof(SceneFormat::Object))
                 {
-                    if (!objJson.contains("name"))
-                        continue;
-
-                    std::string objName = objJson["name"].get<std::string>();
-                    std::shared_ptr<SceneObject> sceneObject;
-
-                    // Try to load from original mesh file if available
-                    if (objJson.contains("meshFilePath") && !objJson["meshFilePath"].get<std::string>().empty())
-                    {
-                        std::string meshFilePath = objJson["meshFilePath"].get<std::string>();
-
-                        // Check if the mesh file still exists
-                        if (std::filesystem::exists(meshFilePath))
-                        {
-                            Console::Print("Loading mesh from file: " + meshFilePath);
-                            sceneObject = SceneObjectFactory::LoadFromFile(meshFilePath, objName);
-                        }
-                        else
-                        {
-                            Console::PrintWarning("Mesh file not found: " + meshFilePath + ", creating placeholder cube");
-                            sceneObject = SceneObjectFactory::CreateCube(objName, 1.0f);
-                        }
-                    }
-                    else
-                    {
-                        // No mesh file path, create a basic cube
-                        Console::Print("No mesh file path found for object: " + objName + ", creating cube");
-                        sceneObject = SceneObjectFactory::CreateCube(objName, 1.0f);
-                    }
-
-                    if (sceneObject)
-                    {
-                        // Apply transform
-                        if (objJson.contains("transform"))
-                        {
-                            const auto &transformJson = objJson["transform"];
-                            auto &transform = sceneObject->GetTransform();
-
-                            if (transformJson.contains("position"))
-                            {
-                                const auto &pos = transformJson["position"];
-                                transform.SetPosition(Vec3(
-                                    pos["x"].get<float>(),
-                                    pos["y"].get<float>(),
-                                    pos["z"].get<float>()));
-                            }
-                            if (transformJson.contains("rotation"))
-                            {
-                                const auto &rot = transformJson["rotation"];
-                                transform.SetRotation(Vec3(
-                                    rot["x"].get<float>(),
-                                    rot["y"].get<float>(),
-                                    rot["z"].get<float>()));
-                            }
-
-                            if (transformJson.contains("scale"))
-                            {
-                                const auto &scale = transformJson["scale"];
-                                transform.SetScale(Vec3(
-                                    scale["x"].get<float>(),
-                                    scale["y"].get<float>(),
-                                    scale["z"].get<float>()));
-                            }
-                        }
-
-                        // Apply material color
-                        if (objJson.contains("materialColor"))
-                        {
-                            const auto &color = objJson["materialColor"];
-                            sceneObject->SetMaterialColor(Vec3(
-                                color["r"].get<float>(),
-                                color["g"].get<float>(),
-                                color["b"].get<float>()));
-                        }
-
-                        // Apply visibility
-                        if (objJson.contains("visible"))
-                        {
-                            sceneObject->SetVisible(objJson["visible"].get<bool>());
-                        }
-
-                        // Add to scene
-                        AddObject(sceneObject);
-
-                        // Apply selection
-                        if (objJson.contains("selected") && objJson["selected"].get<bool>())
-                        {
-                            SelectObject(sceneObject);
-                        }
-                    }
+                    Console::PrintError("Unsupported scene file version " + std::to_string(header.version) + ": " + filepath);
+                    return false;
                 }
+                if (header.objectOffset % alignof(SceneFormat::Object) != 0 || header.objectOffset > size ||
+                    header.objectCount > (size - header.objectOffset) / sizeof(SceneFormat::Object) ||
+                    header.stringTableOffset > size || header.stringTableSize > size - header.stringTableOffset)
+                {
+                    Console::PrintError("Scene file is corrupt: " + filepath);
+                    return false;
+                }
+
+                ReadRecords(reinterpret_cast<const SceneFormat::Object *>(data + header.objectOffset), header.objectCount,
+                            std::string_view(reinterpret_cast<const char *>(data + header.stringTableOffset), header.stringTableSize));
+            }
+            else
+            {
+                json root;
+                try
+                {
+                    root = json::parse(data, data + size);
+                }
+                catch (const json::parse_error &e)
+                {
+                    Console::PrintError("Failed to parse scene file: " + std::string(e.what()));
+                    return false;
+                }
+
+                std::vector<SceneFormat::Object> objects;
+                std::string strings;
+                ImportJson(root, objects, strings);
+                ReadRecords(objects.data(), objects.size(), strings);
             }
 
             Console::Print("Scene loaded from: " + filepath);
@@ -350,56 +519,328 @@ namespace Voltray::Engine
         }
     }
 
-    std::shared_ptr<SceneObject> Scene::RaycastToObject(const Ray &ray) const
+    void Scene::WriteRecords(std::vector<SceneFormat::Object> &objects, std::string &strings) const
     {
-        std::shared_ptr<SceneObject> closestObject = nullptr;
-        float closestDistance = std::numeric_limits<float>::max();
+        // Parents are stored as indices into the saved object array
+        std::unordered_map<const SceneObject *, std::int32_t> savedIndices;
+        for (const auto &obj : m_Objects)
+        {
+            savedIndices.emplace(obj.get(), static_cast<std::int32_t>(savedIndices.size()));
+        }
 
-        // Iterate through all objects in the scene
-        for (const auto& obj : m_Objects)
+        StringTable table(strings);
+        objects.reserve(m_Objects.size());
+        for (const auto &obj : m_Objects)
         {
-            if (!obj)
+            SceneFormat::Object record{};
+            record.name = table.Add(obj->GetName());
+            record.meshFilePath = table.Add(obj->GetMeshFilePath());
+
+            auto parentIt = savedIndices.find(obj->GetParent());
+            record.parent = parentIt != savedIndices.end() ? parentIt->second : -1;
+            record.flags = (obj->IsVisible() ? SceneFormat::OBJECT_VISIBLE : 0u) | (obj->IsSelected() ? SceneFormat::OBJECT_SELECTED : 0u);
+
+            const auto &transform = obj->GetTransform();
+            StoreVec3(record.position, transform.GetPosition());
+            StoreVec3(record.rotation, transform.GetRotation());
+            StoreVec3(record.scale, transform.GetScale());
+            StoreVec3(record.materialColor, obj->GetMaterialColor());
+
+            objects.push_back(record);
+        }
+    }
+
+    void Scene::ReadRecords(const SceneFormat::Object *objects, std::size_t count, std::string_view strings)
+    {
+        // Clear current scene
+        Clear();
+        Reserve(count);
+
+        // Import every distinct mesh file once, all in one parallel batch
+        std::unordered_map<std::string_view, std::shared_ptr<Mesh>> meshes; // nullptr for missing or failed files
+        std::unordered_set<std::string_view> missingFiles;
+        std::vector<std::string> meshPaths;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const std::string_view meshFilePath = GetString(strings, objects[i].meshFilePath);
+            if (meshFilePath.empty() || !meshes.emplace(meshFilePath, nullptr).second)
                 continue;
 
-            // First, perform AABB intersection test for early rejection
-            Vec3 minBounds, maxBounds;
-            obj->GetWorldBounds(minBounds, maxBounds);
+            // Check if the mesh file still exists
+            if (std::filesystem::exists(meshFilePath))
+            {
+                Console::Print("Loading mesh from file: " + std::string(meshFilePath));
+                meshPaths.emplace_back(meshFilePath);
+            }
+            else
+            {
+                Console::PrintWarning("Mesh file not found: " + std::string(meshFilePath) + ", creating placeholder cubes");
+                missingFiles.insert(meshFilePath);
+            }
+        }
+
+        const std::vector<std::shared_ptr<Mesh>> batch = MeshLoader::LoadMeshBatch(meshPaths);
+        for (std::size_t i = 0; i < meshPaths.size(); ++i)
+        {
+            meshes[meshPaths[i]] = batch[i];
+        }
+
+        // Objects without a usable mesh file share one placeholder cube
+        std::shared_ptr<Mesh> placeholderCube;
+        std::size_t placeholderCount = 0;
 
-            float aabbDistance;
-            if (!ray.IntersectAABB(minBounds, maxBounds, aabbDistance))
+        // Indexed like the file's records so parent indices can be resolved afterwards
+        std::vector<std::shared_ptr<SceneObject>> loadedObjects(count);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const SceneFormat::Object &record = objects[i];
+            const std::string_view meshFilePath = GetString(strings, record.meshFilePath);
+            std::shared_ptr<SceneObject> sceneObject;
+
+            if (meshFilePath.empty() || missingFiles.count(meshFilePath))
             {
-                // Ray doesn't intersect the AABB, skip expensive mesh intersection
-                continue;
+                if (!placeholderCube)
+                    placeholderCube = PrimitiveGenerator::CreateCube(1.0f);
+                sceneObject = SceneObjectFactory::CreateFromMesh(placeholderCube, std::string(GetString(strings, record.name)));
+                ++placeholderCount;
             }
+            else if (const auto &mesh = meshes[meshFilePath])
+            {
+                sceneObject = SceneObjectFactory::CreateFromMesh(mesh, std::string(GetString(strings, record.name)));
+                if (sceneObject)
+                    sceneObject->SetMeshFilePath(std::string(meshFilePath));
+            }
+
+            // Objects whose mesh file failed to import are skipped
+            if (!sceneObject)
+                continue;
+
+            auto &transform = sceneObject->GetTransform();
+            transform.SetPosition(LoadVec3(record.position));
+            transform.SetRotation(LoadVec3(record.rotation));
+            transform.SetScale(LoadVec3(record.scale));
+            sceneObject->SetMaterialColor(LoadVec3(record.materialColor));
+            sceneObject->SetVisible((record.flags & SceneFormat::OBJECT_VISIBLE) != 0);
 
-            // AABB test passed, now do detailed mesh intersection
-            float intersectionDistance = 0.0f;
-            auto mesh = obj->GetMesh();
-            if (mesh)
+            // Add to scene
+            AddObject(sceneObject);
+            loadedObjects[i] = sceneObject;
+
+            if (record.flags & SceneFormat::OBJECT_SELECTED)
             {
-                // Get the object's model matrix (local to world transformation)
-                Mat4 modelMatrix = obj->GetModelMatrix();
-                if (ray.IntersectMesh(mesh->GetVertices(), mesh->GetIndices(), modelMatrix, intersectionDistance))
-                {
-                    // Check if this is the closest intersection so far
-                    if (intersectionDistance < closestDistance)
-                    {
-                        closestDistance = intersectionDistance;
-                        closestObject = obj;
-                    }
-                }
+                AddToSelection(sceneObject);
             }
-            else
+        }
+
+        if (placeholderCount > 0)
+        {
+            Console::Print("Created " + std::to_string(placeholderCount) + " placeholder cubes for objects without a mesh file");
+        }
+
+        // Saved transforms are already relative to the parent
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const std::int32_t parentIndex = objects[i].parent;
+            if (loadedObjects[i] && parentIndex >= 0 && static_cast<std::size_t>(parentIndex) < count && loadedObjects[parentIndex])
             {
-                // No mesh available, fall back to AABB intersection distance
-                if (aabbDistance < closestDistance)
-                {
-                    closestDistance = aabbDistance;
-                    closestObject = obj;
-                }
+                loadedObjects[i]->SetParent(loadedObjects[parentIndex].get(), false);
             }
         }
+    }
+
+    std::shared_ptr<SceneObject> Scene::RaycastToObject(const Ray &ray) const
+    {
+        UpdateSpatialIndex();
+
+        std::shared_ptr<SceneObject> closestObject = nullptr;
+
+        // The tree visits nearer branches first and skips everything beyond the closest hit so far
+        m_SpatialIndex.QueryRay(ray, std::numeric_limits<float>::max(),
+                                [&](int proxyId, float closestDistance)
+                                {
+                                    const auto &record = *static_cast<const ObjectRecord *>(m_SpatialIndex.GetUserData(proxyId));
+
+                                    // Exact AABB test against the tight bounds for early rejection
+                                    float aabbDistance;
+                                    if (!ray.IntersectAABB(record.minBounds, record.maxBounds, aabbDistance))
+                                        return closestDistance;
+
+                                    // AABB test passed, now do detailed mesh intersection
+                                    auto mesh = record.object->GetMesh();
+                                    if (mesh)
+                                    {
+                                        float intersectionDistance = 0.0f;
+                                        Mat4 modelMatrix = record.object->GetModelMatrix();
+                                        if (ray.IntersectMesh(mesh->GetPositions(), mesh->GetIndices(), mesh->GetPositionStride(), modelMatrix,
+                                                              intersectionDistance, &mesh->GetBVH()) &&
+                                            intersectionDistance < closestDistance)
+                                        {
+                                            closestObject = record.object;
+                                            return intersectionDistance;
+                                        }
+                                    }
+                                    else if (aabbDistance < closestDistance)
+                                    {
+                                        // No mesh available, fall back to AABB intersection distance
+                                        closestObject = record.object;
+                                        return aabbDistance;
+                                    }
+                                    return closestDistance;
+                                });
 
         return closestObject;
     }
+
+    void Scene::QueryBox(const Vec3 &minBounds, const Vec3 &maxBounds, std::vector<std::shared_ptr<SceneObject>> &results) const
+    {
+        UpdateSpatialIndex();
+
+        m_SpatialIndex.QueryAABB(minBounds, maxBounds,
+                                 [&](int proxyId)
+                                 {
+                                     const auto &record = *static_cast<const ObjectRecord *>(m_SpatialIndex.GetUserData(proxyId));
+                                     if (record.minBounds.x <= maxBounds.x && record.maxBounds.x >= minBounds.x &&
+                                         record.minBounds.y <= maxBounds.y && record.maxBounds.y >= minBounds.y &&
+                                         record.minBounds.z <= maxBounds.z && record.maxBounds.z >= minBounds.z)
+                                     {
+                                         results.push_back(record.object);
+                                     }
+                                     return true;
+                                 });
+    }
+
+    void Scene::QueryFrustum(const Frustum &frustum, std::vector<std::shared_ptr<SceneObject>> &results) const
+    {
+        UpdateSpatialIndex();
+
+        m_SpatialIndex.QueryFrustum(frustum,
+                                    [&](int proxyId)
+                                    {
+                                        const auto &record = *static_cast<const ObjectRecord *>(m_SpatialIndex.GetUserData(proxyId));
+                                        if (frustum.IntersectsAABB(record.minBounds, record.maxBounds))
+                                        {
+                                            results.push_back(record.object);
+                                        }
+                                    });
+    }
+
+    void Scene::RegisterObject(const std::shared_ptr<SceneObject> &object)
+    {
+        if (!object || m_Records.count(object.get()))
+            return;
+
+        std::uint32_t slot;
+        if (!m_FreeSlots.empty())
+        {
+            slot = m_FreeSlots.back();
+            m_FreeSlots.pop_back();
+        }
+        else
+        {
+            slot = static_cast<std::uint32_t>(m_Slots.size());
+            m_Slots.emplace_back();
+        }
+        m_Slots[slot].objectIndex = static_cast<std::uint32_t>(m_Objects.size());
+        m_Objects.push_back(object);
+        m_ObjectSlots.push_back(slot);
+        AddToNameIndex(slot, object->GetName());
+
+        // Map nodes are stable, so the tree can point straight at the entry
+        ObjectRecord &record = m_Records[object.get()];
+        record.object = object;
+        record.slot = slot;
+        object->GetWorldBounds(record.minBounds, record.maxBounds);
+        record.proxyId = m_SpatialIndex.CreateProxy(record.minBounds, record.maxBounds, &record);
+
+        SceneObject *rawObject = object.get();
+        object->GetTransform().SetChangedCallback([this, rawObject]()
+                                                  { m_DirtyObjects.insert(rawObject); });
+        object->SetRenamedCallback([this, rawObject, slot](const std::string &previousName)
+                                   {
+                                       RemoveFromNameIndex(slot, previousName);
+                                       AddToNameIndex(slot, rawObject->GetName()); });
+    }
+
+    void Scene::UnregisterObject(SceneObject *object)
+    {
+        auto it = m_Records.find(object);
+        if (it == m_Records.end())
+            return;
+
+        object->GetTransform().SetChangedCallback(nullptr);
+        object->SetRenamedCallback(nullptr);
+        m_SpatialIndex.DestroyProxy(it->second.proxyId);
+        m_DirtyObjects.erase(object);
+
+        const std::uint32_t slot = it->second.slot;
+        RemoveFromNameIndex(slot, object->GetName());
+
+        // Swap and pop; the last object takes over the freed position
+        const std::uint32_t objectIndex = m_Slots[slot].objectIndex;
+        m_Objects[objectIndex] = std::move(m_Objects.back());
+        m_ObjectSlots[objectIndex] = m_ObjectSlots.back();
+        m_Slots[m_ObjectSlots[objectIndex]].objectIndex = objectIndex;
+        m_Objects.pop_back();
+        m_ObjectSlots.pop_back();
+
+        m_Slots[slot].objectIndex = SceneObjectHandle::INVALID_INDEX;
+        ++m_Slots[slot].generation;
+        m_FreeSlots.push_back(slot);
+
+        // Deselect before erasing the record, which may hold the last reference
+        const bool wasSelected = object->IsSelected();
+        if (wasSelected)
+        {
+            m_Selection.erase(std::find(m_Selection.begin(), m_Selection.end(), it->second.object));
+            object->SetSelected(false);
+        }
+        m_Records.erase(it);
+
+        if (wasSelected)
+            NotifySelectionChanged();
+    }
+
+    void Scene::AddToNameIndex(std::uint32_t slot, const std::string &name)
+    {
+        std::vector<std::uint32_t> &bucket = m_NameIndex[name];
+        m_Slots[slot].namePosition = static_cast<std::uint32_t>(bucket.size());
+        bucket.push_back(slot);
+    }
+
+    void Scene::RemoveFromNameIndex(std::uint32_t slot, const std::string &name)
+    {
+        auto it = m_NameIndex.find(name);
+        if (it == m_NameIndex.end())
+            return;
+
+        std::vector<std::uint32_t> &bucket = it->second;
+        const std::uint32_t position = m_Slots[slot].namePosition;
+        bucket[position] = bucket.back();
+        m_Slots[bucket[position]].namePosition = position;
+        bucket.pop_back();
+        if (bucket.empty())
+            m_NameIndex.erase(it);
+    }
+
+    void Scene::UpdateSpatialIndex() const
+    {
+        // Moving an object moves its whole subtree, but only the object itself reports the change
+        std::vector<SceneObject *> pending(m_DirtyObjects.begin(), m_DirtyObjects.end());
+        while (!pending.empty())
+        {
+            SceneObject *object = pending.back();
+            pending.pop_back();
+            pending.insert(pending.end(), object->GetChildren().begin(), object->GetChildren().end());
+
+            auto it = m_Records.find(object);
+            if (it == m_Records.end())
+                continue;
+
+            ObjectRecord &record = it->second;
+            object->GetWorldBounds(record.minBounds, record.maxBounds);
+            m_SpatialIndex.MoveProxy(record.proxyId, record.minBounds, record.maxBounds);
+        }
+        m_DirtyObjects.clear();
+    }
 }
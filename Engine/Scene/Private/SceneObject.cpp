@@ -1,8 +1,6 @@
-#include <limits>
-#include <algorithm>
-
 #include "SceneObject.h"
 #include "Vec3.h"
+#include <algorithm>
 
 namespace Voltray::Engine
 {
@@ -18,12 +16,70 @@ namespace Voltray::Engine
         UpdatePivotFromMesh();
     }
 
+    SceneObject::~SceneObject()
+    {
+        // The transform store turns the children into roots when our transform is released
+        for (SceneObject *child : m_Children)
+            child->m_Parent = nullptr;
+        if (m_Parent)
+            m_Parent->m_Children.erase(std::find(m_Parent->m_Children.begin(), m_Parent->m_Children.end(), this));
+    }
+
+    void SceneObject::SetName(const std::string &name)
+    {
+        if (name == m_Name)
+            return;
+
+        std::string previousName = std::move(m_Name);
+        m_Name = name;
+        if (m_OnRenamed)
+            m_OnRenamed(previousName);
+    }
+
+    bool SceneObject::SetParent(SceneObject *parent, bool keepWorldTransform)
+    {
+        if (parent == m_Parent)
+            return true;
+
+        const Mat4 worldMatrix = GetModelMatrix();
+        if (!m_Transform.SetParent(parent ? &parent->m_Transform : nullptr))
+            return false;
+
+        if (m_Parent)
+            m_Parent->m_Children.erase(std::find(m_Parent->m_Children.begin(), m_Parent->m_Children.end(), this));
+        m_Parent = parent;
+        if (m_Parent)
+            m_Parent->m_Children.push_back(this);
+
+        if (keepWorldTransform)
+            m_Transform.SetWorldMatrix(worldMatrix);
+        return true;
+    }
+
     void SceneObject::GetWorldBounds(Vec3 &minBounds, Vec3 &maxBounds) const
+    {
+        if (m_WorldBoundsValid && m_WorldBoundsVersion == m_Transform.GetVersion() && m_WorldBoundsMesh == m_Mesh.get())
+        {
+            minBounds = m_WorldMinBounds;
+            maxBounds = m_WorldMaxBounds;
+            return;
+        }
+
+        ComputeWorldBounds(m_WorldMinBounds, m_WorldMaxBounds);
+        m_WorldBoundsVersion = m_Transform.GetVersion();
+        m_WorldBoundsMesh = m_Mesh.get();
+        m_WorldBoundsValid = true;
+
+        minBounds = m_WorldMinBounds;
+        maxBounds = m_WorldMaxBounds;
+    }
+
+    void SceneObject::ComputeWorldBounds(Vec3 &minBounds, Vec3 &maxBounds) const
     {
         if (!m_Mesh)
         {
             // If no mesh, create a small bounding box around the object position
-            Vec3 position = m_Transform.GetPosition();
+            Vec3 position = m_Transform.GetWorldPosition();
             minBounds = position - Vec3(0.1f, 0.1f, 0.1f);
             maxBounds = position + Vec3(0.1f, 0.1f, 0.1f);
             return;
@@ -33,51 +89,15 @@ namespace Voltray::Engine
         Vec3 meshMin, meshMax;
         m_Mesh->GetBounds(meshMin, meshMax);
 
-        // Transform the bounding box corners to world space
-        Mat4 modelMatrix = GetModelMatrix();
-
-        // Transform all 8 corners of the bounding box
-        Vec3 corners[8] = {
-            Vec3(meshMin.x, meshMin.y, meshMin.z),
-            Vec3(meshMax.x, meshMin.y, meshMin.z),
-            Vec3(meshMin.x, meshMax.y, meshMin.z),
-            Vec3(meshMax.x, meshMax.y, meshMin.z),
-            Vec3(meshMin.x, meshMin.y, meshMax.z),
-            Vec3(meshMax.x, meshMin.y, meshMax.z),
-            Vec3(meshMin.x, meshMax.y, meshMax.z),
-            Vec3(meshMax.x, meshMax.y, meshMax.z)};
-
-        // Transform corners and find min/max
-        minBounds = Vec3(
-            std::numeric_limits<float>::max(),
-            std::numeric_limits<float>::max(),
-            std::numeric_limits<float>::max());
-        maxBounds = Vec3(
-            std::numeric_limits<float>::lowest(),
-            std::numeric_limits<float>::lowest(),
-            std::numeric_limits<float>::lowest());
-
-        for (int i = 0; i < 8; ++i)
-        {
-            Vec3 transformedCorner = modelMatrix.MultiplyVec3(corners[i]);
-
-            minBounds.x = std::min(minBounds.x, transformedCorner.x);
-            minBounds.y = std::min(minBounds.y, transformedCorner.y);
-            minBounds.z = std::min(minBounds.z, transformedCorner.z);
-
-            maxBounds.x = std::max(maxBounds.x, transformedCorner.x);
-            maxBounds.y = std::max(maxBounds.y, transformedCorner.y);
-            maxBounds.z = std::max(maxBounds.z, transformedCorner.z);
-        }
+        // Transform the bounding box to world space
+        GetModelMatrix().TransformBounds(meshMin, meshMax, minBounds, maxBounds);
     }
 
     void SceneObject::UpdatePivotFromMesh()
     {
-        if (m_Mesh)
-        {
-            Vec3 meshCenter = m_Mesh->GetCenter();
-            m_Transform.SetRelativePivot(meshCenter, m_RelativePivot);
-        }
+        // Always goes through the transform so that owners tracking its changes see mesh swaps too
+        Vec3 meshCenter = m_Mesh ? m_Mesh->GetCenter() : Vec3(0.0f, 0.0f, 0.0f);
+        m_Transform.SetRelativePivot(meshCenter, m_RelativePivot);
     }
 
     void SceneObject::SetRelativePivot(const Vec3 &relativePivot)
@@ -1,5 +1,6 @@
 #include "SceneObjectFactory.h"
 #include "MeshLoader.h"
+#include "AsyncMeshLoader.h"
 #include <filesystem>
 #include <iostream>
 
@@ -65,6 +66,41 @@ namespace Voltray::Engine
 
         return sceneObject;
     }
+
+    std::shared_ptr<SceneObject> SceneObjectFactory::LoadFromFileAsync(const std::string &filepath, const std::string &name,
+                                                                       LoadedCallback onLoaded)
+    {
+        // Placeholders share one cube for as long as any of them is waiting
+        static std::weak_ptr<Mesh> sharedPlaceholder;
+        std::shared_ptr<Mesh> placeholder = sharedPlaceholder.lock();
+        if (!placeholder)
+        {
+            placeholder = PrimitiveGenerator::CreateCube(1.0f);
+            sharedPlaceholder = placeholder;
+        }
+
+        std::string objectName = name.empty() ? std::filesystem::path(filepath).stem().string() : name;
+        auto sceneObject = CreateFromMesh(placeholder, objectName);
+
+        // Set the mesh file path for persistence, so saving before the load finishes keeps the reference
+        sceneObject->SetMeshFilePath(filepath);
+
+        std::weak_ptr<SceneObject> weakObject = sceneObject;
+        Engine::AsyncMeshLoader::GetInstance().LoadAsync(filepath, [weakObject, onLoaded = std::move(onLoaded)](const AsyncMeshLoader::Result &result)
+                                                         {
+            auto object = weakObject.lock();
+            if (!object)
+                return;
+
+            if (result.IsSuccess())
+                object->SetMesh(result.meshes[0]);
+
+            if (onLoaded)
+                onLoaded(object, result.cancelled ? "Import cancelled" : result.error); });
+
+        return sceneObject;
+    }
+
     std::vector<std::shared_ptr<SceneObject>> SceneObjectFactory::LoadAllFromFile(const std::string &filepath)
     {
         std::vector<std::shared_ptr<SceneObject>> objects;
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "SceneObject.h"
+#include "Frustum.h"
+#include "Mat4.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Voltray::Engine
+{
+    /**
+     * @class FrustumCuller
+     * @brief CPU culling stage that reduces a list of scene objects to the ones the camera can see.
+     *
+     * World bounds of all drawable objects are gathered into structure-of-arrays buffers and
+     * tested against the six frustum planes in batches, producing a compact visible list
+     * before any GL call is made. Buffers are reused between frames.
+     */
+    class FrustumCuller
+    {
+    public:
+        /**
+         * @brief Counters from the most recent Cull call.
+         */
+        struct Stats
+        {
+            std::size_t tested = 0; ///< Drawable objects (visible flag set and mesh present)
+            std::size_t culled = 0; ///< Objects rejected by the frustum test
+            std::size_t drawn = 0;  ///< Objects written to the visible list
+        };
+
+        /**
+         * @brief Builds the list of drawable objects inside the view frustum.
+         * @param objects Objects to consider; hidden objects and objects without a mesh are skipped.
+         * @param viewProjection Camera view-projection matrix used to extract the frustum.
+         * @param visible Receives the objects to draw (cleared first), in their original order.
+         */
+        void Cull(const std::vector<std::shared_ptr<SceneObject>> &objects, const Mat4 &viewProjection,
+                  std::vector<SceneObject *> &visible);
+
+        /**
+         * @brief Enables or disables the frustum test. When disabled every drawable object is kept.
+         * @param enabled True to cull.
+         */
+        void SetEnabled(bool enabled) { m_Enabled = enabled; }
+        bool IsEnabled() const { return m_Enabled; }
+
+        /**
+         * @brief Gets the counters from the most recent Cull call.
+         * @return Reference to the statistics.
+         */
+        const Stats &GetStats() const { return m_Stats; }
+
+    private:
+        bool m_Enabled = true;
+        Stats m_Stats;
+
+        std::vector<SceneObject *> m_Candidates;
+        std::vector<float> m_MinX, m_MinY, m_MinZ;
+        std::vector<float> m_MaxX, m_MaxY, m_MaxZ;
+        std::vector<std::uint8_t> m_Visible;
+    };
+}
@@ -1,25 +1,51 @@
 #pragma once
 
 #include "SceneObject.h"
+#include "SceneObjectHandle.h"
 #include "Renderer.h"
 #include "BaseCamera.h"
+#include "DynamicAABBTree.h"
+#include "Frustum.h"
+#include "SceneFormat.h"
+#include <cstdint>
+#include <functional>
 #include <vector>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace Voltray::Engine
 {
     /**
      * @class Scene
-     * @brief Manages a collection of scene objects and provides rendering functionality.
+     * @brief Manages a collection of scene objects.
      *
      * The Scene class is responsible for managing all objects in the 3D scene,
-     * providing methods to add, remove, and update objects. It also handles
-     * rendering all visible objects in the scene.
+     * providing methods to add, remove, and update objects. Drawing them is left to the
+     * viewport renderer, which feeds the shaders' frame and object buffers.
+     *
+     * World bounds of all objects are kept in a dynamic AABB tree. Objects report transform
+     * changes through a callback and are refitted lazily before the next spatial query, so
+     * raycasts and box/frustum queries scale with the size of the result, not the scene.
+     *
+     * Objects can be parented to each other. Removing an object hands its children to its own
+     * parent, and scene files store each parent as an index into the saved object list.
+     *
+     * Every object gets a generational handle when added, and a hash index maps names to
+     * objects, so lookups by handle or name and removals take constant time. Removal moves
+     * the last object into the freed place, so GetObjects does not keep insertion order.
+     *
+     * The selection is a separate set in selection order. Listeners are notified once per
+     * change, so consumers can cache what they derive from it instead of polling.
      */
     class Scene
     {
     public:
+        using SelectionListener = std::function<void(const Scene &)>;
+        using ListenerId = std::uint32_t;
+
         /**
          * @brief Constructor.
          */
@@ -30,8 +56,11 @@ namespace Voltray::Engine
          */
         ~Scene();
 
+        Scene(const Scene &) = delete;
+        Scene &operator=(const Scene &) = delete;
+
         /**
-         * @brief Adds a scene object to the scene.
+         * @brief Adds a scene object to the scene. Adding an object twice has no effect.
          * @param object Shared pointer to the scene object.
          * @return Reference to the added object.
          */
@@ -46,7 +75,7 @@ namespace Voltray::Engine
         SceneObject &AddObject(std::shared_ptr<Mesh> mesh, const std::string &name = "Object");
 
         /**
-         * @brief Removes a scene object by name.
+         * @brief Removes a scene object by name. If several objects share the name, one of them is removed.
          * @param name Name of the object to remove.
          * @return True if object was found and removed, false otherwise.
          */
@@ -60,12 +89,33 @@ namespace Voltray::Engine
         bool RemoveObject(std::shared_ptr<SceneObject> object);
 
         /**
-         * @brief Finds a scene object by name.
+         * @brief Removes a scene object by handle.
+         * @param handle Handle of the object to remove.
+         * @return True if the handle referred to an object in the scene, false otherwise.
+         */
+        bool RemoveObject(SceneObjectHandle handle);
+
+        /**
+         * @brief Finds a scene object by name. If several objects share the name, one of them is returned.
          * @param name Name of the object to find.
          * @return Shared pointer to the object, or nullptr if not found.
          */
         std::shared_ptr<SceneObject> FindObject(const std::string &name) const;
 
+        /**
+         * @brief Resolves a handle to its object.
+         * @param handle Handle returned by GetHandle.
+         * @return Shared pointer to the object, or nullptr if it was removed.
+         */
+        std::shared_ptr<SceneObject> FindObject(SceneObjectHandle handle) const;
+
+        /**
+         * @brief Gets the handle of an object in the scene.
+         * @param object The object to look up.
+         * @return The object's handle, or an invalid handle if it is not in the scene.
+         */
+        SceneObjectHandle GetHandle(const SceneObject *object) const;
+
         /**
          * @brief Gets all scene objects.
          * @return Vector of shared pointers to all objects.
@@ -78,21 +128,21 @@ namespace Voltray::Engine
         void Clear();
 
         /**
-         * @brief Updates all objects in the scene.
+         * @brief Preallocates the object list and indices, e.g. before adding objects in bulk.
+         * @param objectCount Total number of objects the scene is expected to hold.
+         */
+        void Reserve(std::size_t objectCount);
+
+        /**
+         * @brief Updates all objects in the scene, then rebuilds all modified transform matrices.
          * @param deltaTime Time since last update in seconds.
          */
         void Update(float deltaTime);
 
         /**
-         * @brief Renders all visible objects in the scene.
-         * @param renderer Reference to the renderer.
-         * @param camera Reference to the camera.
-         * @param shader Reference to the shader.
+         * @brief Gets the number of objects in the scene.
+         * @return Number of objects.
          */
-        void Render(Renderer &renderer, const BaseCamera &camera, Shader &shader); /**
-                                                                                    * @brief Gets the number of objects in the scene.
-                                                                                    * @return Number of objects.
-                                                                                    */
         size_t GetObjectCount() const { return m_Objects.size(); }
 
         /**
@@ -102,15 +152,61 @@ namespace Voltray::Engine
         void SelectObject(std::shared_ptr<SceneObject> object);
 
         /**
-         * @brief Clears all object selections.    */
-        void ClearSelection(); /**
-                                * @brief Gets the currently selected object.
-                                * @return Shared pointer to selected object, or nullptr if none.
-                                */
+         * @brief Adds an object to the selection and makes it the primary selected object.
+         * @param object Shared pointer to the object, ignored if it is not in the scene.
+         */
+        void AddToSelection(std::shared_ptr<SceneObject> object);
+
+        /**
+         * @brief Removes an object from the selection.
+         * @param object The object to deselect.
+         */
+        void RemoveFromSelection(const SceneObject *object);
+
+        /**
+         * @brief Clears all object selections.
+         */
+        void ClearSelection();
+
+        /**
+         * @brief Checks whether an object is selected.
+         * @param object The object to test.
+         * @return True if the object is in this scene's selection.
+         */
+        bool IsSelected(const SceneObject *object) const;
+
+        /**
+         * @brief Gets the primary selected object, i.e. the one selected last.
+         * @return Shared pointer to selected object, or nullptr if none.
+         */
         std::shared_ptr<SceneObject> GetSelectedObject() const;
 
+        /**
+         * @brief Gets all selected objects in the order they were selected.
+         * @return The selected objects.
+         */
+        const std::vector<std::shared_ptr<SceneObject>> &GetSelection() const { return m_Selection; }
+
+        /**
+         * @brief Registers a function called after every change to the selection, including
+         * selected objects being removed from the scene.
+         * @param listener Function to call.
+         * @return Id for RemoveSelectionListener.
+         */
+        ListenerId AddSelectionListener(SelectionListener listener);
+
+        /**
+         * @brief Unregisters a selection listener.
+         * @param id Id returned by AddSelectionListener.
+         */
+        void RemoveSelectionListener(ListenerId id);
+
         /**
          * @brief Save the scene to a file
+         *
+         * Files ending in .json are exported as JSON; anything else is written in the binary
+         * format described in SceneFormat.h.
+         *
          * @param filepath Path to save the scene file
          * @return True if successful, false otherwise
          */
@@ -118,6 +214,10 @@ namespace Voltray::Engine
 
         /**
          * @brief Load the scene from a file
+         *
+         * The file is memory-mapped. Binary scene files are recognised by their header and
+         * read in place; anything else is parsed as JSON.
+         *
          * @param filepath Path to the scene file
          * @return True if successful, false otherwise
          */
@@ -130,7 +230,92 @@ namespace Voltray::Engine
          */
         std::shared_ptr<SceneObject> RaycastToObject(const Ray &ray) const;
 
+        /**
+         * @brief Finds all objects whose world bounds overlap a box.
+         * @param minBounds Minimum corner of the box in world space.
+         * @param maxBounds Maximum corner of the box in world space.
+         * @param results Receives the overlapping objects (appended, not cleared).
+         */
+        void QueryBox(const Vec3 &minBounds, const Vec3 &maxBounds, std::vector<std::shared_ptr<SceneObject>> &results) const;
+
+        /**
+         * @brief Finds all objects whose world bounds are at least partially inside a frustum.
+         * @param frustum The frustum to test against, e.g. built from the camera view-projection.
+         * @param results Receives the objects that are not culled (appended, not cleared).
+         */
+        void QueryFrustum(const Frustum &frustum, std::vector<std::shared_ptr<SceneObject>> &results) const;
+
     private:
+        /**
+         * @brief Bookkeeping for an object in the scene, including its entry in the spatial index.
+         */
+        struct ObjectRecord
+        {
+            std::shared_ptr<SceneObject> object;
+            std::uint32_t slot = SceneObjectHandle::INVALID_INDEX;
+            int proxyId = DynamicAABBTree::NULL_NODE;
+            Vec3 minBounds; ///< Tight world bounds at the last refit
+            Vec3 maxBounds;
+        };
+
+        /**
+         * @brief Handle slot; generation is bumped every time the slot is freed.
+         */
+        struct Slot
+        {
+            std::uint32_t generation = 0;
+            std::uint32_t objectIndex = SceneObjectHandle::INVALID_INDEX; ///< Position in m_Objects
+            std::uint32_t namePosition = 0;                                ///< Position in the name index bucket
+        };
+
+        /**
+         * @brief Assigns a handle, indexes the name and bounds, and starts tracking the object.
+         */
+        void RegisterObject(const std::shared_ptr<SceneObject> &object);
+
+        /**
+         * @brief Removes an object from all indices and the object list, and frees its handle.
+         */
+        void UnregisterObject(SceneObject *object);
+
+        /**
+         * @brief Converts all objects to file records, in GetObjects order.
+         * @param objects Receives one record per object.
+         * @param strings Receives the string table the records refer to.
+         */
+        void WriteRecords(std::vector<SceneFormat::Object> &objects, std::string &strings) const;
+
+        /**
+         * @brief Replaces the scene contents with objects created from file records.
+         * @throws std::runtime_error if a record refers outside the string table.
+         */
+        void ReadRecords(const SceneFormat::Object *objects, std::size_t count, std::string_view strings);
+
+        /**
+         * @brief Calls all selection listeners.
+         */
+        void NotifySelectionChanged();
+
+        void AddToNameIndex(std::uint32_t slot, const std::string &name);
+        void RemoveFromNameIndex(std::uint32_t slot, const std::string &name);
+
+        /**
+         * @brief Refits the proxies of all objects whose transform changed since the last query.
+         */
+        void UpdateSpatialIndex() const;
+
         std::vector<std::shared_ptr<SceneObject>> m_Objects;
+        std::vector<std::uint32_t> m_ObjectSlots; ///< Handle slot of each entry in m_Objects
+        std::vector<Slot> m_Slots;
+        std::vector<std::uint32_t> m_FreeSlots;
+        std::unordered_map<std::string, std::vector<std::uint32_t>> m_NameIndex; ///< Slots by object name
+
+        std::vector<std::shared_ptr<SceneObject>> m_Selection;
+        std::vector<std::pair<ListenerId, SelectionListener>> m_SelectionListeners;
+        ListenerId m_NextListenerId = 0;
+
+        mutable DynamicAABBTree m_SpatialIndex;
+        mutable std::unordered_map<SceneObject *, ObjectRecord> m_Records;
+        mutable std::unordered_set<SceneObject *> m_DirtyObjects;
     };
 }
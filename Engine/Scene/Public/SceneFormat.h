@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+namespace Voltray::Engine::SceneFormat
+{
+    /**
+     * On-disk layout of binary scene files (.vscene).
+     *
+     * A file is a Header, followed by objectCount fixed-size Object records, followed by a
+     * string table. Strings are referenced by offset and length into the table and are not
+     * null-terminated; identical strings (e.g. shared mesh paths) are stored once. All values
+     * are little-endian, so the records can be read in place from a memory-mapped file.
+     *
+     * The version is bumped whenever the layout changes; loaders reject newer versions.
+     */
+
+    constexpr std::uint32_t MAGIC = 0x4E435356; ///< "VSCN" read as a little-endian integer
+    constexpr std::uint32_t VERSION = 1;
+
+    struct Header
+    {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint32_t objectCount;
+        std::uint32_t objectSize; ///< sizeof(Object) of the writer, checked on load
+        std::uint64_t objectOffset;
+        std::uint64_t stringTableOffset;
+        std::uint64_t stringTableSize;
+    };
+
+    struct StringRef
+    {
+        std::uint32_t offset;
+        std::uint32_t length;
+    };
+
+    enum ObjectFlags : std::uint32_t
+    {
+        OBJECT_VISIBLE = 1u << 0,
+        OBJECT_SELECTED = 1u << 1,
+    };
+
+    struct Object
+    {
+        StringRef name;
+        StringRef meshFilePath;   ///< Empty for objects without a mesh file
+        std::int32_t parent;      ///< Index of the parent record, -1 for roots
+        std::uint32_t flags;      ///< ObjectFlags
+        float position[3];
+        float rotation[3];        ///< Euler angles in degrees
+        float scale[3];
+        float materialColor[3];
+    };
+
+    static_assert(sizeof(Header) == 40 && std::is_trivially_copyable_v<Header>, "Header layout is part of the file format");
+    static_assert(sizeof(Object) == 72 && std::is_trivially_copyable_v<Object>, "Object layout is part of the file format");
+}
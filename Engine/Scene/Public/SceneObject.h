@@ -4,8 +4,11 @@
 #include "Vec3.h"
 #include "Mesh.h"
 #include "Shader.h"
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 using namespace Voltray::Math;
 
@@ -18,6 +21,9 @@ namespace Voltray::Engine
      * SceneObject represents any object that can be placed in the 3D scene.
      * It contains a transform for positioning, rotation, and scaling, as well as
      * a mesh for rendering. This serves as the base class for all scene objects.
+     *
+     * Objects can be parented to each other; the transform of a child is relative to its
+     * parent, and GetModelMatrix returns the combined local-to-world matrix.
      */
     class SceneObject
     {
@@ -36,12 +42,43 @@ namespace Voltray::Engine
         SceneObject(std::shared_ptr<Mesh> mesh, const std::string &name = "SceneObject");
 
         /**
-         * @brief Virtual destructor.
+         * @brief Virtual destructor. Detaches the object from its parent and children.
+         */
+        virtual ~SceneObject();
+
+        SceneObject(const SceneObject &) = delete;
+        SceneObject &operator=(const SceneObject &) = delete;
+
+        /**
+         * @brief Parents this object to another one.
+         * @param parent New parent, or nullptr to make this a root object.
+         * @param keepWorldTransform Adjusts the local transform so the object stays in place.
+         * @return False if the parent is this object or one of its descendants.
+         */
+        bool SetParent(SceneObject *parent, bool keepWorldTransform = true);
+
+        /**
+         * @brief Gets the parent object.
+         * @return The parent, or nullptr for root objects.
+         */
+        SceneObject *GetParent() const { return m_Parent; }
+
+        /**
+         * @brief Gets the direct children in the order they were attached.
+         * @return The child objects.
          */
-        virtual ~SceneObject() = default; // Transform operations
+        const std::vector<SceneObject *> &GetChildren() const { return m_Children; }
+
+        // Transform operations
         Transform &GetTransform() { return m_Transform; }
         const Transform &GetTransform() const { return m_Transform; }
 
+        /**
+         * @brief Gets the slot of this object's transform in the TransformStore.
+         * @return The store index, valid for the lifetime of the object.
+         */
+        TransformStore::Index GetTransformIndex() const { return m_Transform.GetIndex(); }
+
         /**
          * @brief Sets the relative pivot point where (0,0,0) represents the mesh center.
          * @param relativePivot The pivot offset from mesh center.
@@ -72,11 +109,27 @@ namespace Voltray::Engine
 
         // Properties
         const std::string &GetName() const { return m_Name; }
-        void SetName(const std::string &name) { m_Name = name; }
+        void SetName(const std::string &name);
+
+        /**
+         * @brief Sets a callback invoked after the name changes, used by the scene to keep its
+         * name index current.
+         * @param callback Function receiving the previous name, or an empty function to remove it.
+         */
+        void SetRenamedCallback(std::function<void(const std::string &)> callback) { m_OnRenamed = std::move(callback); }
         bool IsVisible() const { return m_Visible; }
         void SetVisible(bool visible) { m_Visible = visible; }
+
+        /**
+         * @brief Checks whether the object is selected in its scene.
+         *
+         * Mirrors the scene's selection set for quick per-object checks; change the selection
+         * through Scene::SelectObject and related methods, which call SetSelected.
+         */
         bool IsSelected() const { return m_Selected; }
-        void SetSelected(bool selected) { m_Selected = selected; } // Material properties
+        void SetSelected(bool selected) { m_Selected = selected; }
+
+        // Material properties
         const Vec3 &GetMaterialColor() const { return m_MaterialColor; }
         void SetMaterialColor(const Vec3 &color) { m_MaterialColor = color; }
 
@@ -86,12 +139,15 @@ namespace Voltray::Engine
 
         /**
          * @brief Gets the model matrix for rendering.
-         * @return The transformation matrix.
+         * @return The local-to-world transformation matrix, including all parents.
          */
         Mat4 GetModelMatrix() const { return m_Transform.GetMatrix(); }
 
         /**
          * @brief Gets the axis-aligned bounding box in world space.
+         *
+         * The result is cached until the transform or mesh changes.
+         *
          * @param minBounds Output minimum bounds of the bounding box.
          * @param maxBounds Output maximum bounds of the bounding box.
          */
@@ -114,6 +170,11 @@ namespace Voltray::Engine
          */
         void UpdatePivotFromMesh();
 
+        /**
+         * @brief Computes the world-space bounding box without using the cache.
+         */
+        void ComputeWorldBounds(Vec3 &minBounds, Vec3 &maxBounds) const;
+
     protected:
         std::string m_Name;
         Transform m_Transform;
@@ -125,6 +186,19 @@ namespace Voltray::Engine
 
         // Store the file path of the loaded mesh (empty for procedural meshes)
         std::string m_MeshFilePath;
+
+        std::function<void(const std::string &)> m_OnRenamed;
+
+        // Hierarchy links; the owning scene keeps the objects alive
+        SceneObject *m_Parent = nullptr;
+        std::vector<SceneObject *> m_Children;
+
+        // Cached world bounds, valid while the transform version and mesh match
+        mutable Vec3 m_WorldMinBounds;
+        mutable Vec3 m_WorldMaxBounds;
+        mutable std::uint64_t m_WorldBoundsVersion = 0;
+        mutable const Mesh *m_WorldBoundsMesh = nullptr;
+        mutable bool m_WorldBoundsValid = false;
     };
 
 }
@@ -2,6 +2,7 @@
 
 #include "SceneObject.h"
 #include "PrimitiveGenerator.h"
+#include <functional>
 #include <memory>
 #include <string>
 
@@ -78,6 +79,27 @@ namespace Voltray::Engine
          */
         static std::shared_ptr<SceneObject> LoadFromFile(const std::string &filepath, const std::string &name = "");
 
+        /**
+         * @brief Called when a background load finishes.
+         * @param object The object the mesh was loaded for.
+         * @param error Empty on success, otherwise why the mesh could not be loaded.
+         */
+        using LoadedCallback = std::function<void(const std::shared_ptr<SceneObject> &object, const std::string &error)>;
+
+        /**
+         * @brief Create a placeholder scene object right away and load its mesh in the background.
+         *
+         * The object shows a unit cube until AsyncMeshLoader::ProcessUploads swaps in the first
+         * mesh of the file. If the object is destroyed first, the callback is not invoked.
+         *
+         * @param filepath Path to the mesh file.
+         * @param name Name of the object (defaults to filename if empty).
+         * @param onLoaded Optional callback run once the load succeeded, failed or was cancelled.
+         * @return Shared pointer to the placeholder object.
+         */
+        static std::shared_ptr<SceneObject> LoadFromFileAsync(const std::string &filepath, const std::string &name = "",
+                                                              LoadedCallback onLoaded = nullptr);
+
         /**
          * @brief Load all meshes from a file as separate scene objects.
          * @param filepath Path to the mesh file.
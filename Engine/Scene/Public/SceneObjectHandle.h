@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Voltray::Engine
+{
+    /**
+     * @struct SceneObjectHandle
+     * @brief Stable reference to an object in a Scene.
+     *
+     * A handle is a slot index plus the generation of the slot when the object was added.
+     * Slots are reused after removal with a new generation, so a handle to a removed object
+     * never resolves to whatever object took its place.
+     */
+    struct SceneObjectHandle
+    {
+        static constexpr std::uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+
+        std::uint32_t index = INVALID_INDEX;
+        std::uint32_t generation = 0;
+
+        /**
+         * @brief Checks whether the handle was ever assigned. Does not check if the object still exists.
+         */
+        bool IsValid() const { return index != INVALID_INDEX; }
+
+        bool operator==(const SceneObjectHandle &other) const { return index == other.index && generation == other.generation; }
+        bool operator!=(const SceneObjectHandle &other) const { return !(*this == other); }
+    };
+}
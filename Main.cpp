@@ -49,6 +49,13 @@ int main()
 
         GLFWwindow *window = glfwCreateWindow(1280, 720, "Voltray Editor", nullptr, nullptr);
         if (!window)
+        {
+            // Shaders only need GL 4.5, which is what software rasterizers such as
+            // Mesa llvmpipe (LIBGL_ALWAYS_SOFTWARE=1) provide
+            glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 5);
+            window = glfwCreateWindow(1280, 720, "Voltray Editor", nullptr, nullptr);
+        }
+        if (!window)
         {
             glfwTerminate();
             return -1;
@@ -0,0 +1,218 @@
+#include "BVH.h"
+#include <algorithm>
+#include <limits>
+
+namespace Voltray::Math
+{
+
+    namespace
+    {
+        constexpr int BIN_COUNT = 16;
+        constexpr std::uint32_t MAX_LEAF_TRIANGLES = 4;
+
+        // Plain float storage keeps the build loops free of out-of-line Vec3 calls
+        struct Bounds
+        {
+            float min[3] = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
+            float max[3] = {std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()};
+
+            void Grow(const float *point)
+            {
+                for (int axis = 0; axis < 3; ++axis)
+                {
+                    min[axis] = std::min(min[axis], point[axis]);
+                    max[axis] = std::max(max[axis], point[axis]);
+                }
+            }
+
+            void Grow(const Bounds &other)
+            {
+                for (int axis = 0; axis < 3; ++axis)
+                {
+                    min[axis] = std::min(min[axis], other.min[axis]);
+                    max[axis] = std::max(max[axis], other.max[axis]);
+                }
+            }
+
+            // Half the surface area is enough for SAH comparisons
+            float HalfArea() const
+            {
+                if (min[0] > max[0])
+                    return 0.0f;
+                float dx = max[0] - min[0], dy = max[1] - min[1], dz = max[2] - min[2];
+                return dx * dy + dy * dz + dz * dx;
+            }
+
+            Vec3 Min() const { return Vec3(min[0], min[1], min[2]); }
+            Vec3 Max() const { return Vec3(max[0], max[1], max[2]); }
+        };
+
+        // Build-time record per triangle, partitioned in place so every pass reads memory linearly
+        struct Primitive
+        {
+            Bounds bounds;
+            float centroid[3];
+            std::uint32_t triangle;
+        };
+
+        struct Bin
+        {
+            Bounds bounds;
+            std::uint32_t count = 0;
+        };
+
+    }
+
+    BVH::BVH(const std::vector<float> &vertices, const std::vector<unsigned int> &indices, unsigned int stride)
+    {
+        Build(vertices, indices, stride);
+    }
+
+    void BVH::Build(const std::vector<float> &vertices, const std::vector<unsigned int> &indices, unsigned int stride)
+    {
+        m_Nodes.clear();
+        m_Triangles.clear();
+        m_Stride = stride;
+
+        const std::size_t triangleCount = indices.size() / 3;
+        if (triangleCount == 0 || stride < 3)
+            return;
+
+        std::vector<Primitive> primitives(triangleCount);
+        Bounds rootBounds;
+        for (std::size_t tri = 0; tri < triangleCount; ++tri)
+        {
+            Primitive &primitive = primitives[tri];
+            for (int corner = 0; corner < 3; ++corner)
+            {
+                primitive.bounds.Grow(&vertices[static_cast<std::size_t>(indices[tri * 3 + corner]) * stride]);
+            }
+            for (int axis = 0; axis < 3; ++axis)
+                primitive.centroid[axis] = (primitive.bounds.min[axis] + primitive.bounds.max[axis]) * 0.5f;
+            primitive.triangle = static_cast<std::uint32_t>(tri);
+            rootBounds.Grow(primitive.bounds);
+        }
+
+        // Leaves usually hold several triangles, so 2n / MAX_LEAF_TRIANGLES is a close first estimate
+        m_Nodes.reserve(triangleCount * 2 / MAX_LEAF_TRIANGLES + 1);
+        m_Nodes.push_back({rootBounds.Min(), 0, rootBounds.Max(), static_cast<std::uint32_t>(triangleCount)});
+
+        std::vector<std::uint32_t> stack;
+        stack.push_back(0);
+
+        while (!stack.empty())
+        {
+            const std::uint32_t nodeIndex = stack.back();
+            stack.pop_back();
+
+            const std::uint32_t first = m_Nodes[nodeIndex].leftFirst;
+            const std::uint32_t count = m_Nodes[nodeIndex].triangleCount;
+            if (count <= MAX_LEAF_TRIANGLES)
+                continue;
+
+            Primitive *begin = primitives.data() + first;
+            Primitive *end = begin + count;
+
+            Bounds centroidBounds;
+            for (const Primitive *primitive = begin; primitive != end; ++primitive)
+                centroidBounds.Grow(primitive->centroid);
+
+            const Vec3 nodeExtent = m_Nodes[nodeIndex].maxBounds - m_Nodes[nodeIndex].minBounds;
+            float bestCost = static_cast<float>(count) *
+                             (nodeExtent.x * nodeExtent.y + nodeExtent.y * nodeExtent.z + nodeExtent.z * nodeExtent.x);
+            int bestAxis = -1;
+            int bestSplit = 0;
+            Bounds bestLeft, bestRight;
+
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                const float axisMin = centroidBounds.min[axis];
+                const float extent = centroidBounds.max[axis] - axisMin;
+                if (extent <= 0.0f)
+                    continue;
+
+                Bin bins[BIN_COUNT];
+                const float scale = BIN_COUNT / extent;
+                for (const Primitive *primitive = begin; primitive != end; ++primitive)
+                {
+                    int bin = std::min(BIN_COUNT - 1, static_cast<int>((primitive->centroid[axis] - axisMin) * scale));
+                    bins[bin].count++;
+                    bins[bin].bounds.Grow(primitive->bounds);
+                }
+
+                // Sweep from both sides to evaluate every split plane between bins
+                Bounds leftBounds[BIN_COUNT - 1], rightBounds[BIN_COUNT - 1];
+                std::uint32_t leftCount[BIN_COUNT - 1], rightCount[BIN_COUNT - 1];
+                Bounds leftAccum, rightAccum;
+                std::uint32_t leftSum = 0, rightSum = 0;
+                for (int i = 0; i < BIN_COUNT - 1; ++i)
+                {
+                    leftSum += bins[i].count;
+                    leftAccum.Grow(bins[i].bounds);
+                    leftCount[i] = leftSum;
+                    leftBounds[i] = leftAccum;
+
+                    rightSum += bins[BIN_COUNT - 1 - i].count;
+                    rightAccum.Grow(bins[BIN_COUNT - 1 - i].bounds);
+                    rightCount[BIN_COUNT - 2 - i] = rightSum;
+                    rightBounds[BIN_COUNT - 2 - i] = rightAccum;
+                }
+
+                for (int i = 0; i < BIN_COUNT - 1; ++i)
+                {
+                    if (leftCount[i] == 0 || rightCount[i] == 0)
+                        continue;
+
+                    float cost = leftCount[i] * leftBounds[i].HalfArea() + rightCount[i] * rightBounds[i].HalfArea();
+                    if (cost < bestCost)
+                    {
+                        bestCost = cost;
+                        bestAxis = axis;
+                        bestSplit = i;
+                        bestLeft = leftBounds[i];
+                        bestRight = rightBounds[i];
+                    }
+                }
+            }
+
+            // Splitting is not cheaper than testing every triangle in this node
+            if (bestAxis < 0)
+                continue;
+
+            const float axisMin = centroidBounds.min[bestAxis];
+            const float scale = BIN_COUNT / (centroidBounds.max[bestAxis] - axisMin);
+            Primitive *middle = std::partition(begin, end,
+                                               [&](const Primitive &primitive)
+                                               {
+                                                   int bin = std::min(BIN_COUNT - 1, static_cast<int>((primitive.centroid[bestAxis] - axisMin) * scale));
+                                                   return bin <= bestSplit;
+                                               });
+
+            const std::uint32_t leftTriangles = static_cast<std::uint32_t>(middle - begin);
+            if (leftTriangles == 0 || leftTriangles == count)
+                continue;
+
+            const std::uint32_t leftIndex = static_cast<std::uint32_t>(m_Nodes.size());
+            m_Nodes.push_back({bestLeft.Min(), first, bestLeft.Max(), leftTriangles});
+            m_Nodes.push_back({bestRight.Min(), first + leftTriangles, bestRight.Max(), count - leftTriangles});
+
+            m_Nodes[nodeIndex].leftFirst = leftIndex;
+            m_Nodes[nodeIndex].triangleCount = 0;
+
+            stack.push_back(leftIndex + 1);
+            stack.push_back(leftIndex);
+        }
+
+        m_Triangles.resize(triangleCount);
+        for (std::size_t i = 0; i < triangleCount; ++i)
+            m_Triangles[i] = primitives[i].triangle;
+
+        m_Nodes.shrink_to_fit();
+    }
+
+    std::size_t BVH::GetMemoryUsage() const
+    {
+        return m_Nodes.capacity() * sizeof(Node) + m_Triangles.capacity() * sizeof(std::uint32_t);
+    }
+
+}
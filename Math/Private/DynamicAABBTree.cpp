@@ -0,0 +1,318 @@
+#include "DynamicAABBTree.h"
+#include <cassert>
+
+namespace Voltray::Math
+{
+
+    namespace
+    {
+        constexpr float MIN_PADDING = 0.01f;
+
+        // Moving proxies keep their fat box until it is this many paddings larger than needed
+        constexpr float HUGE_PADDING_FACTOR = 4.0f;
+
+        void Union(const Vec3 &minA, const Vec3 &maxA, const Vec3 &minB, const Vec3 &maxB, Vec3 &outMin, Vec3 &outMax)
+        {
+            outMin = Vec3(std::min(minA.x, minB.x), std::min(minA.y, minB.y), std::min(minA.z, minB.z));
+            outMax = Vec3(std::max(maxA.x, maxB.x), std::max(maxA.y, maxB.y), std::max(maxA.z, maxB.z));
+        }
+
+        float SurfaceArea(const Vec3 &minBounds, const Vec3 &maxBounds)
+        {
+            float dx = maxBounds.x - minBounds.x, dy = maxBounds.y - minBounds.y, dz = maxBounds.z - minBounds.z;
+            return 2.0f * (dx * dy + dy * dz + dz * dx);
+        }
+
+        float UnionArea(const Vec3 &minA, const Vec3 &maxA, const Vec3 &minB, const Vec3 &maxB)
+        {
+            Vec3 unionMin, unionMax;
+            Union(minA, maxA, minB, maxB, unionMin, unionMax);
+            return SurfaceArea(unionMin, unionMax);
+        }
+
+        bool Contains(const Vec3 &outerMin, const Vec3 &outerMax, const Vec3 &innerMin, const Vec3 &innerMax)
+        {
+            return outerMin.x <= innerMin.x && outerMin.y <= innerMin.y && outerMin.z <= innerMin.z &&
+                   innerMax.x <= outerMax.x && innerMax.y <= outerMax.y && innerMax.z <= outerMax.z;
+        }
+    }
+
+    DynamicAABBTree::DynamicAABBTree(float margin)
+        : m_Margin(margin)
+    {
+    }
+
+    int DynamicAABBTree::CreateProxy(const Vec3 &minBounds, const Vec3 &maxBounds, void *userData)
+    {
+        const int proxyId = AllocateNode();
+        const float padding = GetPadding(minBounds, maxBounds);
+
+        Node &node = m_Nodes[proxyId];
+        node.minBounds = minBounds - Vec3(padding, padding, padding);
+        node.maxBounds = maxBounds + Vec3(padding, padding, padding);
+        node.userData = userData;
+        node.height = 0;
+
+        InsertLeaf(proxyId);
+        ++m_ProxyCount;
+        return proxyId;
+    }
+
+    void DynamicAABBTree::DestroyProxy(int proxyId)
+    {
+        assert(proxyId >= 0 && proxyId < static_cast<int>(m_Nodes.size()) && m_Nodes[proxyId].IsLeaf());
+
+        RemoveLeaf(proxyId);
+        FreeNode(proxyId);
+        --m_ProxyCount;
+    }
+
+    bool DynamicAABBTree::MoveProxy(int proxyId, const Vec3 &minBounds, const Vec3 &maxBounds)
+    {
+        assert(proxyId >= 0 && proxyId < static_cast<int>(m_Nodes.size()) && m_Nodes[proxyId].IsLeaf());
+
+        const float padding = GetPadding(minBounds, maxBounds);
+        Node &node = m_Nodes[proxyId];
+
+        // Still inside the fat box, and the fat box has not become much larger than the object
+        const float hugePadding = padding * HUGE_PADDING_FACTOR;
+        if (Contains(node.minBounds, node.maxBounds, minBounds, maxBounds) &&
+            Contains(minBounds - Vec3(hugePadding, hugePadding, hugePadding), maxBounds + Vec3(hugePadding, hugePadding, hugePadding),
+                     node.minBounds, node.maxBounds))
+        {
+            return false;
+        }
+
+        RemoveLeaf(proxyId);
+        node.minBounds = minBounds - Vec3(padding, padding, padding);
+        node.maxBounds = maxBounds + Vec3(padding, padding, padding);
+        InsertLeaf(proxyId);
+        return true;
+    }
+
+    void DynamicAABBTree::Clear()
+    {
+        m_Nodes.clear();
+        m_Root = NULL_NODE;
+        m_FreeList = NULL_NODE;
+        m_ProxyCount = 0;
+    }
+
+    int DynamicAABBTree::AllocateNode()
+    {
+        if (m_FreeList == NULL_NODE)
+        {
+            m_Nodes.emplace_back();
+            return static_cast<int>(m_Nodes.size()) - 1;
+        }
+
+        const int nodeId = m_FreeList;
+        m_FreeList = m_Nodes[nodeId].parent;
+        m_Nodes[nodeId] = Node();
+        return nodeId;
+    }
+
+    void DynamicAABBTree::FreeNode(int nodeId)
+    {
+        Node &node = m_Nodes[nodeId];
+        node.parent = m_FreeList;
+        node.child1 = NULL_NODE;
+        node.child2 = NULL_NODE;
+        node.userData = nullptr;
+        node.height = -1;
+        m_FreeList = nodeId;
+    }
+
+    float DynamicAABBTree::GetPadding(const Vec3 &minBounds, const Vec3 &maxBounds) const
+    {
+        const Vec3 extent = maxBounds - minBounds;
+        return std::max(m_Margin * std::max(extent.x, std::max(extent.y, extent.z)), MIN_PADDING);
+    }
+
+    void DynamicAABBTree::InsertLeaf(int leaf)
+    {
+        if (m_Root == NULL_NODE)
+        {
+            m_Root = leaf;
+            m_Nodes[leaf].parent = NULL_NODE;
+            return;
+        }
+
+        // Descend towards the sibling that minimizes the surface area added to the tree
+        const Vec3 leafMin = m_Nodes[leaf].minBounds;
+        const Vec3 leafMax = m_Nodes[leaf].maxBounds;
+        int index = m_Root;
+        while (!m_Nodes[index].IsLeaf())
+        {
+            const Node &node = m_Nodes[index];
+            const float area = SurfaceArea(node.minBounds, node.maxBounds);
+            const float combinedArea = UnionArea(node.minBounds, node.maxBounds, leafMin, leafMax);
+
+            // Cost of making a new parent for this node and the leaf
+            const float cost = 2.0f * combinedArea;
+
+            // Minimum cost of pushing the leaf further down the tree
+            const float inheritanceCost = 2.0f * (combinedArea - area);
+
+            auto descendCost = [&](int childId)
+            {
+                const Node &child = m_Nodes[childId];
+                const float unionArea = UnionArea(child.minBounds, child.maxBounds, leafMin, leafMax);
+                if (child.IsLeaf())
+                    return unionArea + inheritanceCost;
+                return unionArea - SurfaceArea(child.minBounds, child.maxBounds) + inheritanceCost;
+            };
+
+            const float cost1 = descendCost(node.child1);
+            const float cost2 = descendCost(node.child2);
+            if (cost < cost1 && cost < cost2)
+                break;
+
+            index = cost1 < cost2 ? node.child1 : node.child2;
+        }
+
+        const int sibling = index;
+        const int oldParent = m_Nodes[sibling].parent;
+        const int newParent = AllocateNode();
+
+        Node &parentNode = m_Nodes[newParent];
+        parentNode.parent = oldParent;
+        parentNode.userData = nullptr;
+        Union(leafMin, leafMax, m_Nodes[sibling].minBounds, m_Nodes[sibling].maxBounds, parentNode.minBounds, parentNode.maxBounds);
+        parentNode.height = m_Nodes[sibling].height + 1;
+        parentNode.child1 = sibling;
+        parentNode.child2 = leaf;
+
+        if (oldParent != NULL_NODE)
+        {
+            if (m_Nodes[oldParent].child1 == sibling)
+                m_Nodes[oldParent].child1 = newParent;
+            else
+                m_Nodes[oldParent].child2 = newParent;
+        }
+        else
+        {
+            m_Root = newParent;
+        }
+
+        m_Nodes[sibling].parent = newParent;
+        m_Nodes[leaf].parent = newParent;
+
+        Refit(m_Nodes[leaf].parent);
+    }
+
+    void DynamicAABBTree::RemoveLeaf(int leaf)
+    {
+        if (leaf == m_Root)
+        {
+            m_Root = NULL_NODE;
+            return;
+        }
+
+        const int parent = m_Nodes[leaf].parent;
+        const int grandParent = m_Nodes[parent].parent;
+        const int sibling = m_Nodes[parent].child1 == leaf ? m_Nodes[parent].child2 : m_Nodes[parent].child1;
+
+        if (grandParent != NULL_NODE)
+        {
+            // Replace the parent with the sibling and refit the ancestors
+            if (m_Nodes[grandParent].child1 == parent)
+                m_Nodes[grandParent].child1 = sibling;
+            else
+                m_Nodes[grandParent].child2 = sibling;
+            m_Nodes[sibling].parent = grandParent;
+            FreeNode(parent);
+
+            Refit(grandParent);
+        }
+        else
+        {
+            m_Root = sibling;
+            m_Nodes[sibling].parent = NULL_NODE;
+            FreeNode(parent);
+        }
+        m_Nodes[leaf].parent = NULL_NODE;
+    }
+
+    void DynamicAABBTree::Refit(int nodeId)
+    {
+        while (nodeId != NULL_NODE)
+        {
+            nodeId = Balance(nodeId);
+
+            Node &node = m_Nodes[nodeId];
+            const Node &child1 = m_Nodes[node.child1];
+            const Node &child2 = m_Nodes[node.child2];
+            node.height = 1 + std::max(child1.height, child2.height);
+            Union(child1.minBounds, child1.maxBounds, child2.minBounds, child2.maxBounds, node.minBounds, node.maxBounds);
+
+            nodeId = node.parent;
+        }
+    }
+
+    int DynamicAABBTree::Balance(int iA)
+    {
+        Node &a = m_Nodes[iA];
+        if (a.IsLeaf() || a.height < 2)
+            return iA;
+
+        const int iB = a.child1;
+        const int iC = a.child2;
+        Node &b = m_Nodes[iB];
+        Node &c = m_Nodes[iC];
+        const int balance = c.height - b.height;
+
+        // Rotate the taller child up, moving its shorter grandchild under A
+        auto rotateUp = [&](int iUp, Node &up, Node &other, int &aSlot)
+        {
+            const int iF = up.child1;
+            const int iG = up.child2;
+            Node &f = m_Nodes[iF];
+            Node &g = m_Nodes[iG];
+
+            up.child1 = iA;
+            up.parent = a.parent;
+            a.parent = iUp;
+
+            if (up.parent != NULL_NODE)
+            {
+                if (m_Nodes[up.parent].child1 == iA)
+                    m_Nodes[up.parent].child1 = iUp;
+                else
+                    m_Nodes[up.parent].child2 = iUp;
+            }
+            else
+            {
+                m_Root = iUp;
+            }
+
+            const bool keepF = f.height > g.height;
+            const int iKeep = keepF ? iF : iG;
+            const int iMove = keepF ? iG : iF;
+            Node &keep = m_Nodes[iKeep];
+            Node &move = m_Nodes[iMove];
+
+            up.child2 = iKeep;
+            aSlot = iMove;
+            move.parent = iA;
+
+            Union(other.minBounds, other.maxBounds, move.minBounds, move.maxBounds, a.minBounds, a.maxBounds);
+            Union(a.minBounds, a.maxBounds, keep.minBounds, keep.maxBounds, up.minBounds, up.maxBounds);
+            a.height = 1 + std::max(other.height, move.height);
+            up.height = 1 + std::max(a.height, keep.height);
+        };
+
+        if (balance > 1)
+        {
+            rotateUp(iC, c, b, a.child2);
+            return iC;
+        }
+        if (balance < -1)
+        {
+            rotateUp(iB, b, c, a.child1);
+            return iB;
+        }
+        return iA;
+    }
+
+}
@@ -0,0 +1,97 @@
+#include "Frustum.h"
+#include <cmath>
+
+namespace Voltray::Math
+{
+
+    Frustum::Frustum()
+    {
+        for (Vec4 &plane : m_Planes)
+            plane = Vec4(0.0f, 0.0f, 0.0f, 1.0f);
+    }
+
+    Frustum::Frustum(const Mat4 &viewProjection)
+    {
+        Extract(viewProjection);
+    }
+
+    void Frustum::Extract(const Mat4 &viewProjection)
+    {
+        // Clip coordinates are computed as clip[i] = sum_k v[k] * data[k * 4 + i] (see Mat4::MultiplyVec4),
+        // so row i of the matrix is (data[i], data[4 + i], data[8 + i], data[12 + i])
+        const float *m = viewProjection.data;
+        auto row = [m](int i)
+        { return Vec4(m[i], m[4 + i], m[8 + i], m[12 + i]); };
+
+        const Vec4 row0 = row(0), row1 = row(1), row2 = row(2), row3 = row(3);
+        m_Planes[Left] = row3 + row0;
+        m_Planes[Right] = row3 - row0;
+        m_Planes[Bottom] = row3 + row1;
+        m_Planes[Top] = row3 - row1;
+        m_Planes[Near] = row3 + row2;
+        m_Planes[Far] = row3 - row2;
+
+        for (Vec4 &plane : m_Planes)
+        {
+            float length = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+            if (length > 0.0f)
+                plane = plane / length;
+        }
+    }
+
+    Frustum::Containment Frustum::ClassifyAABB(const Vec3 &minBounds, const Vec3 &maxBounds) const
+    {
+        Containment result = Containment::Inside;
+        for (const Vec4 &plane : m_Planes)
+        {
+            // Corner furthest along the plane normal decides whether the box is outside,
+            // the opposite corner decides whether it is completely inside
+            const float px = plane.x >= 0.0f ? maxBounds.x : minBounds.x;
+            const float py = plane.y >= 0.0f ? maxBounds.y : minBounds.y;
+            const float pz = plane.z >= 0.0f ? maxBounds.z : minBounds.z;
+            if (plane.x * px + plane.y * py + plane.z * pz + plane.w < 0.0f)
+                return Containment::Outside;
+
+            const float nx = plane.x >= 0.0f ? minBounds.x : maxBounds.x;
+            const float ny = plane.y >= 0.0f ? minBounds.y : maxBounds.y;
+            const float nz = plane.z >= 0.0f ? minBounds.z : maxBounds.z;
+            if (plane.x * nx + plane.y * ny + plane.z * nz + plane.w < 0.0f)
+                result = Containment::Intersecting;
+        }
+        return result;
+    }
+
+    bool Frustum::IntersectsAABB(const Vec3 &minBounds, const Vec3 &maxBounds) const
+    {
+        for (const Vec4 &plane : m_Planes)
+        {
+            const float px = plane.x >= 0.0f ? maxBounds.x : minBounds.x;
+            const float py = plane.y >= 0.0f ? maxBounds.y : minBounds.y;
+            const float pz = plane.z >= 0.0f ? maxBounds.z : minBounds.z;
+            if (plane.x * px + plane.y * py + plane.z * pz + plane.w < 0.0f)
+                return false;
+        }
+        return true;
+    }
+
+    void Frustum::IntersectsAABBs(const float *minX, const float *minY, const float *minZ,
+                                  const float *maxX, const float *maxY, const float *maxZ,
+                                  std::size_t count, std::uint8_t *visible) const
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            visible[i] = 1;
+
+        for (const Vec4 &plane : m_Planes)
+        {
+            // The corner furthest along the normal is chosen once per plane, not per box
+            const float *px = plane.x >= 0.0f ? maxX : minX;
+            const float *py = plane.y >= 0.0f ? maxY : minY;
+            const float *pz = plane.z >= 0.0f ? maxZ : minZ;
+            const float a = plane.x, b = plane.y, c = plane.z, d = plane.w;
+
+            for (std::size_t i = 0; i < count; ++i)
+                visible[i] &= static_cast<std::uint8_t>(a * px[i] + b * py[i] + c * pz[i] + d >= 0.0f);
+        }
+    }
+
+}
@@ -1,4 +1,6 @@
 #include "Mat4.h"
+#include "SIMD.h"
+#include "Vec3A.h"
 #include <cmath>
 #include <iostream>
 #include <cstring>
@@ -6,6 +8,8 @@
 namespace Voltray::Math
 {
 
+    using namespace SIMD;
+
     Mat4::Mat4()
     {
         std::memset(data, 0, sizeof(data));
@@ -22,36 +26,68 @@ namespace Voltray::Math
 
     Mat4 Mat4::operator*(const Mat4 &other) const
     {
+        // Column i of the result combines the columns of other, weighted by column i of this
+        const Float4 c0 = Load(other.data);
+        const Float4 c1 = Load(other.data + 4);
+        const Float4 c2 = Load(other.data + 8);
+        const Float4 c3 = Load(other.data + 12);
+
         Mat4 result;
-        for (int row = 0; row < 4; row++)
+        for (int col = 0; col < 4; col++)
         {
-            for (int col = 0; col < 4; col++)
-            {
-                result.data[col + row * 4] =
-                    data[0 + row * 4] * other.data[col + 0 * 4] +
-                    data[1 + row * 4] * other.data[col + 1 * 4] +
-                    data[2 + row * 4] * other.data[col + 2 * 4] +
-                    data[3 + row * 4] * other.data[col + 3 * 4];
-            }
+            const Float4 weights = Load(data + col * 4);
+            Float4 sum = Mul(SplatLane<0>(weights), c0);
+            sum = MulAdd(SplatLane<1>(weights), c1, sum);
+            sum = MulAdd(SplatLane<2>(weights), c2, sum);
+            sum = MulAdd(SplatLane<3>(weights), c3, sum);
+            Store(result.data + col * 4, sum);
         }
         return result;
     }
 
     Vec3 Mat4::MultiplyVec3(const Vec3 &v) const
     {
-        float x = v.x * data[0] + v.y * data[4] + v.z * data[8] + data[12];
-        float y = v.x * data[1] + v.y * data[5] + v.z * data[9] + data[13];
-        float z = v.x * data[2] + v.y * data[6] + v.z * data[10] + data[14];
-        return Vec3(x, y, z);
+        Float4 sum = MulAdd(Splat(v.x), Load(data), Load(data + 12));
+        sum = MulAdd(Splat(v.y), Load(data + 4), sum);
+        sum = MulAdd(Splat(v.z), Load(data + 8), sum);
+
+        float out[4];
+        Store(out, sum);
+        return Vec3(out[0], out[1], out[2]);
     }
 
     Vec4 Mat4::MultiplyVec4(const Vec4 &v) const
     {
-        float x = v.x * data[0] + v.y * data[4] + v.z * data[8] + v.w * data[12];
-        float y = v.x * data[1] + v.y * data[5] + v.z * data[9] + v.w * data[13];
-        float z = v.x * data[2] + v.y * data[6] + v.z * data[10] + v.w * data[14];
-        float w = v.x * data[3] + v.y * data[7] + v.z * data[11] + v.w * data[15];
-        return Vec4(x, y, z, w);
+        Float4 sum = Mul(Splat(v.x), Load(data));
+        sum = MulAdd(Splat(v.y), Load(data + 4), sum);
+        sum = MulAdd(Splat(v.z), Load(data + 8), sum);
+        sum = MulAdd(Splat(v.w), Load(data + 12), sum);
+
+        float out[4];
+        Store(out, sum);
+        return Vec4(out[0], out[1], out[2], out[3]);
+    }
+
+    void Mat4::TransformBounds(const Vec3 &minBounds, const Vec3 &maxBounds, Vec3 &outMin, Vec3 &outMax) const
+    {
+        const Vec3A center((minBounds + maxBounds) * 0.5f);
+        const Vec3A extent((maxBounds - minBounds) * 0.5f);
+        const Float4 c0 = Load(data);
+        const Float4 c1 = Load(data + 4);
+        const Float4 c2 = Load(data + 8);
+
+        const Float4 centerValue = center.Load();
+        Float4 worldCenter = MulAdd(SplatLane<0>(centerValue), c0, Load(data + 12));
+        worldCenter = MulAdd(SplatLane<1>(centerValue), c1, worldCenter);
+        worldCenter = MulAdd(SplatLane<2>(centerValue), c2, worldCenter);
+
+        const Float4 extentValue = extent.Load();
+        Float4 worldExtent = Mul(SplatLane<0>(extentValue), Abs(c0));
+        worldExtent = MulAdd(SplatLane<1>(extentValue), Abs(c1), worldExtent);
+        worldExtent = MulAdd(SplatLane<2>(extentValue), Abs(c2), worldExtent);
+
+        outMin = Vec3A::FromSIMD(Sub(worldCenter, worldExtent)).ToVec3();
+        outMax = Vec3A::FromSIMD(Add(worldCenter, worldExtent)).ToVec3();
     }
 
     Mat4 Mat4::Translate(const Vec3 &t)
@@ -175,132 +211,119 @@ namespace Voltray::Math
         return result;
     }
 
-    // TODO: Optimize this inverse function for performance
+    namespace
+    {
+        // 2x2 matrices packed as (m00, m01, m10, m11); see Mat4::Inverse
+
+        // A * B
+        inline Float4 Mat2Mul(Float4 a, Float4 b)
+        {
+            return Add(Mul(a, Swizzle<0, 3, 0, 3>(b)), Mul(Swizzle<1, 0, 3, 2>(a), Swizzle<2, 1, 2, 1>(b)));
+        }
+
+        // adj(A) * B
+        inline Float4 Mat2AdjMul(Float4 a, Float4 b)
+        {
+            return Sub(Mul(Swizzle<3, 3, 0, 0>(a), b), Mul(Swizzle<1, 1, 2, 2>(a), Swizzle<2, 3, 0, 1>(b)));
+        }
+
+        // A * adj(B)
+        inline Float4 Mat2MulAdj(Float4 a, Float4 b)
+        {
+            return Sub(Mul(a, Swizzle<3, 0, 3, 0>(b)), Mul(Swizzle<1, 0, 3, 2>(a), Swizzle<2, 1, 2, 1>(b)));
+        }
+    }
+
     Mat4 Mat4::Inverse() const
     {
-        // This is a generic 4x4 matrix inverse implementation (not optimized)
-        const float *m = data;
+        // Blockwise inversion on 2x2 sub-matrices. The matrix is read as rows of its transpose,
+        // which is fine because inverse(transpose(M)) == transpose(inverse(M)).
+        const Float4 r0 = Load(data);
+        const Float4 r1 = Load(data + 4);
+        const Float4 r2 = Load(data + 8);
+        const Float4 r3 = Load(data + 12);
+
+        const Float4 a = Shuffle<0, 1, 0, 1>(r0, r1);
+        const Float4 b = Shuffle<2, 3, 2, 3>(r0, r1);
+        const Float4 c = Shuffle<0, 1, 0, 1>(r2, r3);
+        const Float4 d = Shuffle<2, 3, 2, 3>(r2, r3);
+
+        // Determinants of the four blocks: (|A|, |B|, |C|, |D|)
+        const Float4 blockDet = Sub(Mul(Shuffle<0, 2, 0, 2>(r0, r2), Shuffle<1, 3, 1, 3>(r1, r3)),
+                                    Mul(Shuffle<1, 3, 1, 3>(r0, r2), Shuffle<0, 2, 0, 2>(r1, r3)));
+        const Float4 detA = SplatLane<0>(blockDet);
+        const Float4 detB = SplatLane<1>(blockDet);
+        const Float4 detC = SplatLane<2>(blockDet);
+        const Float4 detD = SplatLane<3>(blockDet);
+
+        const Float4 adjDC = Mat2AdjMul(d, c);
+        const Float4 adjAB = Mat2AdjMul(a, b);
+
+        // Adjugates of the result blocks
+        Float4 x = Sub(Mul(detD, a), Mat2Mul(b, adjDC));
+        Float4 w = Sub(Mul(detA, d), Mat2Mul(c, adjAB));
+        Float4 y = Sub(Mul(detB, c), Mat2MulAdj(d, adjAB));
+        Float4 z = Sub(Mul(detC, b), Mat2MulAdj(a, adjDC));
+
+        // |M| = |A||D| + |B||C| - tr(adj(A)B adj(D)C)
+        Float4 trace = Mul(adjAB, Swizzle<0, 2, 1, 3>(adjDC));
+        trace = Add(trace, Swizzle<2, 3, 0, 1>(trace));
+        trace = Add(trace, Swizzle<1, 0, 3, 2>(trace));
+        const Float4 det = Sub(Add(Mul(detA, detD), Mul(detB, detC)), trace);
+
+        if (GetX(det) == 0.0f)
+            return Mat4::Identity();
+
+        const Float4 scale = Div(Set(1.0f, -1.0f, -1.0f, 1.0f), det);
+        x = Mul(x, scale);
+        y = Mul(y, scale);
+        z = Mul(z, scale);
+        w = Mul(w, scale);
+
+        // Undo the adjugate packing while assembling the columns
         Mat4 inv;
-        float *invOut = inv.data;
-
-        invOut[0] = m[5] * m[10] * m[15] -
-                    m[5] * m[11] * m[14] -
-                    m[9] * m[6] * m[15] +
-                    m[9] * m[7] * m[14] +
-                    m[13] * m[6] * m[11] -
-                    m[13] * m[7] * m[10];
-
-        invOut[4] = -m[4] * m[10] * m[15] +
-                    m[4] * m[11] * m[14] +
-                    m[8] * m[6] * m[15] -
-                    m[8] * m[7] * m[14] -
-                    m[12] * m[6] * m[11] +
-                    m[12] * m[7] * m[10];
-
-        invOut[8] = m[4] * m[9] * m[15] -
-                    m[4] * m[11] * m[13] -
-                    m[8] * m[5] * m[15] +
-                    m[8] * m[7] * m[13] +
-                    m[12] * m[5] * m[11] -
-                    m[12] * m[7] * m[9];
-
-        invOut[12] = -m[4] * m[9] * m[14] +
-                     m[4] * m[10] * m[13] +
-                     m[8] * m[5] * m[14] -
-                     m[8] * m[6] * m[13] -
-                     m[12] * m[5] * m[10] +
-                     m[12] * m[6] * m[9];
-
-        invOut[1] = -m[1] * m[10] * m[15] +
-                    m[1] * m[11] * m[14] +
-                    m[9] * m[2] * m[15] -
-                    m[9] * m[3] * m[14] -
-                    m[13] * m[2] * m[11] +
-                    m[13] * m[3] * m[10];
-
-        invOut[5] = m[0] * m[10] * m[15] -
-                    m[0] * m[11] * m[14] -
-                    m[8] * m[2] * m[15] +
-                    m[8] * m[3] * m[14] +
-                    m[12] * m[2] * m[11] -
-                    m[12] * m[3] * m[10];
-
-        invOut[9] = -m[0] * m[9] * m[15] +
-                    m[0] * m[11] * m[13] +
-                    m[8] * m[1] * m[15] -
-                    m[8] * m[3] * m[13] -
-                    m[12] * m[1] * m[11] +
-                    m[12] * m[3] * m[9];
-
-        invOut[13] = m[0] * m[9] * m[14] -
-                     m[0] * m[10] * m[13] -
-                     m[8] * m[1] * m[14] +
-                     m[8] * m[2] * m[13] +
-                     m[12] * m[1] * m[10] -
-                     m[12] * m[2] * m[9];
-
-        invOut[2] = m[1] * m[6] * m[15] -
-                    m[1] * m[7] * m[14] -
-                    m[5] * m[2] * m[15] +
-                    m[5] * m[3] * m[14] +
-                    m[13] * m[2] * m[7] -
-                    m[13] * m[3] * m[6];
-
-        invOut[6] = -m[0] * m[6] * m[15] +
-                    m[0] * m[7] * m[14] +
-                    m[4] * m[2] * m[15] -
-                    m[4] * m[3] * m[14] -
-                    m[12] * m[2] * m[7] +
-                    m[12] * m[3] * m[6];
-
-        invOut[10] = m[0] * m[5] * m[15] -
-                     m[0] * m[7] * m[13] -
-                     m[4] * m[1] * m[15] +
-                     m[4] * m[3] * m[13] +
-                     m[12] * m[1] * m[7] -
-                     m[12] * m[3] * m[5];
-
-        invOut[14] = -m[0] * m[5] * m[14] +
-                     m[0] * m[6] * m[13] +
-                     m[4] * m[1] * m[14] -
-                     m[4] * m[2] * m[13] -
-                     m[12] * m[1] * m[6] +
-                     m[12] * m[2] * m[5];
-
-        invOut[3] = -m[1] * m[6] * m[11] +
-                    m[1] * m[7] * m[10] +
-                    m[5] * m[2] * m[11] -
-                    m[5] * m[3] * m[10] -
-                    m[9] * m[2] * m[7] +
-                    m[9] * m[3] * m[6];
-
-        invOut[7] = m[0] * m[6] * m[11] -
-                    m[0] * m[7] * m[10] -
-                    m[4] * m[2] * m[11] +
-                    m[4] * m[3] * m[10] +
-                    m[8] * m[2] * m[7] -
-                    m[8] * m[3] * m[6];
-
-        invOut[11] = -m[0] * m[5] * m[11] +
-                     m[0] * m[7] * m[9] +
-                     m[4] * m[1] * m[11] -
-                     m[4] * m[3] * m[9] -
-                     m[8] * m[1] * m[7] +
-                     m[8] * m[3] * m[5];
-
-        invOut[15] = m[0] * m[5] * m[10] -
-                     m[0] * m[6] * m[9] -
-                     m[4] * m[1] * m[10] +
-                     m[4] * m[2] * m[9] +
-                     m[8] * m[1] * m[6] -
-                     m[8] * m[2] * m[5];
-
-        float det = m[0] * invOut[0] + m[1] * invOut[4] + m[2] * invOut[8] + m[3] * invOut[12];
-        if (det == 0.0f)
+        Store(inv.data, Shuffle<3, 1, 3, 1>(x, y));
+        Store(inv.data + 4, Shuffle<2, 0, 2, 0>(x, y));
+        Store(inv.data + 8, Shuffle<3, 1, 3, 1>(z, w));
+        Store(inv.data + 12, Shuffle<2, 0, 2, 0>(z, w));
+        return inv;
+    }
+
+    Mat4 Mat4::InverseAffine() const
+    {
+        const Float4 c0 = Load(data);
+        const Float4 c1 = Load(data + 4);
+        const Float4 c2 = Load(data + 8);
+        const Float4 translation = Load(data + 12);
+
+        // Rows of the inverse 3x3 part are cross products of its columns divided by the determinant
+        Float4 r0 = Cross3(c1, c2);
+        Float4 r1 = Cross3(c2, c0);
+        Float4 r2 = Cross3(c0, c1);
+        const Float4 det = Dot3(c0, r0);
+
+        if (GetX(det) == 0.0f)
             return Mat4::Identity();
-        det = 1.0f / det;
-        for (int i = 0; i < 16; i++)
-            invOut[i] *= det;
+
+        const Float4 invDet = Div(Splat(1.0f), det);
+        r0 = Mul(r0, invDet);
+        r1 = Mul(r1, invDet);
+        r2 = Mul(r2, invDet);
+
+        Float4 r3 = Zero();
+        Transpose(r0, r1, r2, r3);
+
+        // Translation becomes -inverse(L) * t; w of the last column is 1
+        Float4 t = Mul(SplatLane<0>(translation), r0);
+        t = MulAdd(SplatLane<1>(translation), r1, t);
+        t = MulAdd(SplatLane<2>(translation), r2, t);
+        t = Sub(Set(0.0f, 0.0f, 0.0f, 1.0f), t);
+
+        Mat4 inv;
+        Store(inv.data, r0);
+        Store(inv.data + 4, r1);
+        Store(inv.data + 8, r2);
+        Store(inv.data + 12, t);
         return inv;
-    }  
-} 
+    }
+}
@@ -1,6 +1,8 @@
 #include "Ray.h"
+#include "BVH.h"
 #include <cmath>
 #include <algorithm>
+#include <cstdint>
 #include <limits>
 #include <vector>
 #include <iostream>
@@ -90,6 +92,8 @@ namespace Voltray::Math
 
         if (tzmin > t1)
             t1 = tzmin;
+        if (tzmax < t2)
+            t2 = tzmax;
         t = (t1 > 0) ? t1 : t2;
         return t > 0;
     }
@@ -126,18 +130,146 @@ namespace Voltray::Math
         return t > EPSILON; // Ensure intersection is in front of ray origin
     }
 
-    bool Ray::IntersectMesh(const std::vector<float> &vertices, const std::vector<unsigned int> &indices, float &t) const
+    namespace
     {
-        bool hit = false;
-        float closestT = std::numeric_limits<float>::max();
+        // Slab test against a BVH node, returns the entry distance or infinity on a miss
+        inline float IntersectNode(const BVH::Node &node, const Vec3 &origin, const Vec3 &invDir, float maxT)
+        {
+            float tx1 = (node.minBounds.x - origin.x) * invDir.x;
+            float tx2 = (node.maxBounds.x - origin.x) * invDir.x;
+            float tMin = std::min(tx1, tx2);
+            float tMax = std::max(tx1, tx2);
+
+            float ty1 = (node.minBounds.y - origin.y) * invDir.y;
+            float ty2 = (node.maxBounds.y - origin.y) * invDir.y;
+            tMin = std::max(tMin, std::min(ty1, ty2));
+            tMax = std::min(tMax, std::max(ty1, ty2));
+
+            float tz1 = (node.minBounds.z - origin.z) * invDir.z;
+            float tz2 = (node.maxBounds.z - origin.z) * invDir.z;
+            tMin = std::max(tMin, std::min(tz1, tz2));
+            tMax = std::min(tMax, std::max(tz1, tz2));
+
+            if (tMax >= tMin && tMin < maxT && tMax > 0.0f)
+                return tMin;
+            return std::numeric_limits<float>::infinity();
+        }
+
+        // Node stack for traversal: inline for typical tree heights, spilling to the heap for
+        // deeper trees, which binned SAH can build from skewed triangle distributions
+        class TraversalStack
+        {
+        public:
+            bool IsEmpty() const { return m_Size == 0; }
+
+            void Push(std::uint32_t nodeIndex)
+            {
+                if (m_Size < INLINE_CAPACITY)
+                    m_Inline[m_Size] = nodeIndex;
+                else
+                    m_Overflow.push_back(nodeIndex);
+                ++m_Size;
+            }
 
-        // Determine vertex stride - check if we have 8 floats per vertex (pos + normal + texcoord)
-        // or just 3 floats per vertex (position only)
-        int stride = 8; // Default to full vertex layout
-        if (vertices.size() % 8 != 0 && vertices.size() % 3 == 0)
+            std::uint32_t Pop()
+            {
+                --m_Size;
+                if (m_Size < INLINE_CAPACITY)
+                    return m_Inline[m_Size];
+                const std::uint32_t nodeIndex = m_Overflow.back();
+                m_Overflow.pop_back();
+                return nodeIndex;
+            }
+
+        private:
+            static constexpr std::size_t INLINE_CAPACITY = 64;
+            std::uint32_t m_Inline[INLINE_CAPACITY];
+            std::vector<std::uint32_t> m_Overflow;
+            std::size_t m_Size = 0;
+        };
+
+        bool IntersectMeshBVH(const Ray &ray, const std::vector<float> &vertices, const std::vector<unsigned int> &indices,
+                              std::size_t stride, const BVH &bvh, float &t)
         {
-            stride = 3; // Simple position-only vertices
+            const std::vector<BVH::Node> &nodes = bvh.GetNodes();
+            const std::vector<std::uint32_t> &triangles = bvh.GetTriangles();
+            const Vec3 invDir(1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z);
+
+            float closestT = std::numeric_limits<float>::max();
+            bool hit = false;
+
+            if (IntersectNode(nodes[0], ray.origin, invDir, closestT) == std::numeric_limits<float>::infinity())
+                return false;
+
+            TraversalStack stack;
+            std::uint32_t nodeIndex = 0;
+
+            while (true)
+            {
+                const BVH::Node &node = nodes[nodeIndex];
+                if (node.IsLeaf())
+                {
+                    for (std::uint32_t i = node.leftFirst; i < node.leftFirst + node.triangleCount; ++i)
+                    {
+                        const std::size_t base = static_cast<std::size_t>(triangles[i]) * 3;
+                        const float *p0 = &vertices[indices[base] * stride];
+                        const float *p1 = &vertices[indices[base + 1] * stride];
+                        const float *p2 = &vertices[indices[base + 2] * stride];
+
+                        float intersectionT;
+                        if (ray.IntersectTriangle(Vec3(p0[0], p0[1], p0[2]), Vec3(p1[0], p1[1], p1[2]),
+                                                  Vec3(p2[0], p2[1], p2[2]), intersectionT) &&
+                            intersectionT < closestT)
+                        {
+                            closestT = intersectionT;
+                            hit = true;
+                        }
+                    }
+
+                    if (stack.IsEmpty())
+                        break;
+                    nodeIndex = stack.Pop();
+                    continue;
+                }
+
+                // Visit the nearer child first so closer hits prune the farther subtree
+                std::uint32_t nearIndex = node.leftFirst;
+                std::uint32_t farIndex = node.leftFirst + 1;
+                float nearT = IntersectNode(nodes[nearIndex], ray.origin, invDir, closestT);
+                float farT = IntersectNode(nodes[farIndex], ray.origin, invDir, closestT);
+                if (farT < nearT)
+                {
+                    std::swap(nearIndex, farIndex);
+                    std::swap(nearT, farT);
+                }
+
+                if (nearT == std::numeric_limits<float>::infinity())
+                {
+                    if (stack.IsEmpty())
+                        break;
+                    nodeIndex = stack.Pop();
+                    continue;
+                }
+
+                nodeIndex = nearIndex;
+                if (farT != std::numeric_limits<float>::infinity())
+                    stack.Push(farIndex);
+            }
+
+            if (hit)
+                t = closestT;
+            return hit;
         }
+    }
+
+    bool Ray::IntersectMesh(const std::vector<float> &vertices, const std::vector<unsigned int> &indices, unsigned int stride, float &t,
+                            const BVH *bvh) const
+    {
+        if (bvh && !bvh->IsEmpty())
+            return IntersectMeshBVH(*this, vertices, indices, stride, *bvh, t);
+
+        bool hit = false;
+        float closestT = std::numeric_limits<float>::max();
 
         for (size_t i = 0; i < indices.size(); i += 3)
         {
@@ -162,10 +294,11 @@ namespace Voltray::Math
         return hit;
     }
 
-    bool Ray::IntersectMesh(const std::vector<float> &vertices, const std::vector<unsigned int> &indices, const Mat4 &transform, float &t) const
+    bool Ray::IntersectMesh(const std::vector<float> &vertices, const std::vector<unsigned int> &indices, unsigned int stride,
+                            const Mat4 &transform, float &t, const BVH *bvh) const
     {
-        // Transform ray from world space to object local space
-        Mat4 inverseTransform = transform.Inverse();
+        // Transform ray from world space to object local space (object transforms are affine)
+        Mat4 inverseTransform = transform.InverseAffine();
 
         // Transform ray origin to local space (applies full transformation)
         Vec3 localOrigin = inverseTransform.MultiplyVec3(origin);
@@ -186,7 +319,7 @@ namespace Voltray::Math
 
         // Perform intersection in local space
         float localT;
-        bool hit = localRay.IntersectMesh(vertices, indices, localT);
+        bool hit = localRay.IntersectMesh(vertices, indices, stride, localT, bvh);
 
         if (hit)
         {
@@ -1,107 +1,129 @@
 #include "Transform.h"
-#include "MathUtil.h"
-#include <cmath>
 
 namespace Voltray::Math
 {
 
     Transform::Transform()
-        : m_Position(0.0f, 0.0f, 0.0f), m_Rotation(0.0f, 0.0f, 0.0f), m_Scale(1.0f, 1.0f, 1.0f), m_Pivot(0.0f, 0.0f, 0.0f), m_MeshCenter(0.0f, 0.0f, 0.0f)
+        : m_Index(TransformStore::GetInstance().Allocate())
     {
     }
 
     Transform::Transform(const Vec3 &position)
-        : m_Position(position), m_Rotation(0.0f, 0.0f, 0.0f), m_Scale(1.0f, 1.0f, 1.0f), m_Pivot(0.0f, 0.0f, 0.0f), m_MeshCenter(0.0f, 0.0f, 0.0f)
+        : m_Index(TransformStore::GetInstance().Allocate())
     {
+        TransformStore::GetInstance().SetPosition(m_Index, position);
     }
 
     Transform::Transform(const Vec3 &position, const Vec3 &rotation, const Vec3 &scale)
-        : m_Position(position), m_Rotation(rotation), m_Scale(scale), m_Pivot(0.0f, 0.0f, 0.0f), m_MeshCenter(0.0f, 0.0f, 0.0f)
+        : m_Index(TransformStore::GetInstance().Allocate())
     {
+        TransformStore &store = TransformStore::GetInstance();
+        store.SetPosition(m_Index, position);
+        store.SetRotation(m_Index, rotation);
+        store.SetScale(m_Index, scale);
+    }
+
+    Transform::Transform(const Transform &other)
+        : m_Index(TransformStore::GetInstance().Allocate()), m_MeshCenter(other.m_MeshCenter)
+    {
+        TransformStore::GetInstance().Copy(m_Index, other.m_Index);
+    }
+
+    Transform::~Transform()
+    {
+        TransformStore::GetInstance().Release(m_Index);
+    }
+
+    Transform &Transform::operator=(const Transform &other)
+    {
+        if (this != &other)
+        {
+            TransformStore::GetInstance().Copy(m_Index, other.m_Index);
+            m_MeshCenter = other.m_MeshCenter;
+            NotifyChanged();
+        }
+        return *this;
     }
 
     void Transform::SetPosition(const Vec3 &position)
     {
-        m_Position = position;
-        InvalidateMatrix();
+        TransformStore::GetInstance().SetPosition(m_Index, position);
+        NotifyChanged();
     }
 
     void Transform::SetRotation(const Vec3 &rotation)
     {
-        m_Rotation = rotation;
-        InvalidateMatrix();
+        TransformStore::GetInstance().SetRotation(m_Index, rotation);
+        NotifyChanged();
     }
 
     void Transform::SetScale(const Vec3 &scale)
     {
-        m_Scale = scale;
-        InvalidateMatrix();
+        TransformStore::GetInstance().SetScale(m_Index, scale);
+        NotifyChanged();
     }
 
     void Transform::SetScale(float uniformScale)
     {
-        m_Scale = Vec3(uniformScale, uniformScale, uniformScale);
-        InvalidateMatrix();
+        SetScale(Vec3(uniformScale, uniformScale, uniformScale));
     }
 
     void Transform::SetPivot(const Vec3 &pivot)
     {
-        m_Pivot = pivot;
-        InvalidateMatrix();
+        TransformStore::GetInstance().SetPivot(m_Index, pivot);
+        NotifyChanged();
     }
 
     void Transform::SetMeshCenter(const Vec3 &meshCenter)
     {
         m_MeshCenter = meshCenter;
-        InvalidateMatrix();
+        NotifyChanged();
     }
 
     void Transform::SetRelativePivot(const Vec3 &meshCenter, const Vec3 &relativePivot)
     {
         m_MeshCenter = meshCenter;
-        m_Pivot = relativePivot;
-        InvalidateMatrix();
+        TransformStore::GetInstance().SetPivot(m_Index, relativePivot);
+        NotifyChanged();
     }
 
     void Transform::Translate(const Vec3 &translation)
     {
-        m_Position = m_Position + translation;
-        InvalidateMatrix();
+        SetPosition(GetPosition() + translation);
     }
 
     void Transform::Rotate(const Vec3 &rotation)
     {
-        m_Rotation = m_Rotation + rotation;
-        InvalidateMatrix();
+        SetRotation(GetRotation() + rotation);
     }
 
     void Transform::Scale(const Vec3 &scale)
     {
-        m_Scale.x *= scale.x;
-        m_Scale.y *= scale.y;
-        m_Scale.z *= scale.z;
-        InvalidateMatrix();
+        Vec3 current = GetScale();
+        SetScale(Vec3(current.x * scale.x, current.y * scale.y, current.z * scale.z));
     }
 
     void Transform::Scale(float uniformScale)
     {
-        m_Scale.x *= uniformScale;
-        m_Scale.y *= uniformScale;
-        m_Scale.z *= uniformScale;
-        InvalidateMatrix();
+        SetScale(GetScale() * uniformScale);
+    }
+
+    void Transform::SetOrientation(const Quat &orientation)
+    {
+        TransformStore::GetInstance().SetOrientation(m_Index, orientation);
+        NotifyChanged();
+    }
+
+    void Transform::Rotate(const Quat &rotation)
+    {
+        SetOrientation(rotation * GetOrientation());
     }
 
     // Local space transformation methods
     void Transform::TranslateLocal(const Vec3 &localTranslation)
     {
-        // Create rotation matrix to transform from local to world space
-        Mat4 rotationX = Mat4::RotateX(m_Rotation.x * DEG2RAD);
-        Mat4 rotationY = Mat4::RotateY(m_Rotation.y * DEG2RAD);
-        Mat4 rotationZ = Mat4::RotateZ(m_Rotation.z * DEG2RAD);
-        Mat4 rotation = rotationZ * rotationY * rotationX;
-
-        // Transform the local translation vector to world space
-        Vec3 worldTranslation = rotation.MultiplyVec3(localTranslation);
+        // Rotate the local translation vector to world space
+        Vec3 worldTranslation = GetOrientation().Rotate(localTranslation);
 
         // Apply the world space translation
         Translate(worldTranslation);
@@ -124,89 +146,82 @@ namespace Voltray::Math
 
     Vec3 Transform::GetLocalRight() const
     {
-        // Local X axis is (1, 0, 0) in local space
-        Mat4 rotationX = Mat4::RotateX(m_Rotation.x * DEG2RAD);
-        Mat4 rotationY = Mat4::RotateY(m_Rotation.y * DEG2RAD);
-        Mat4 rotationZ = Mat4::RotateZ(m_Rotation.z * DEG2RAD);
-        Mat4 rotation = rotationZ * rotationY * rotationX;
-
-        return rotation.MultiplyVec3(Vec3(1.0f, 0.0f, 0.0f)).Normalize();
+        return GetOrientation().GetRight();
     }
 
     Vec3 Transform::GetLocalUp() const
     {
-        // Local Y axis is (0, 1, 0) in local space
-        Mat4 rotationX = Mat4::RotateX(m_Rotation.x * DEG2RAD);
-        Mat4 rotationY = Mat4::RotateY(m_Rotation.y * DEG2RAD);
-        Mat4 rotationZ = Mat4::RotateZ(m_Rotation.z * DEG2RAD);
-        Mat4 rotation = rotationZ * rotationY * rotationX;
-
-        return rotation.MultiplyVec3(Vec3(0.0f, 1.0f, 0.0f)).Normalize();
+        return GetOrientation().GetUp();
     }
 
     Vec3 Transform::GetLocalForward() const
     {
-        // Local Z axis is (0, 0, 1) in local space
-        Mat4 rotationX = Mat4::RotateX(m_Rotation.x * DEG2RAD);
-        Mat4 rotationY = Mat4::RotateY(m_Rotation.y * DEG2RAD);
-        Mat4 rotationZ = Mat4::RotateZ(m_Rotation.z * DEG2RAD);
-        Mat4 rotation = rotationZ * rotationY * rotationX;
-
-        return rotation.MultiplyVec3(Vec3(0.0f, 0.0f, 1.0f)).Normalize();
+        return GetOrientation().GetForward();
     }
 
     Mat4 Transform::GetMatrix() const
     {
-        if (m_MatrixDirty)
-        {
-            UpdateMatrix();
-            m_MatrixDirty = false;
-        }
-        return m_CachedMatrix;
+        return TransformStore::GetInstance().GetMatrix(m_Index);
     }
 
-    Mat4 Transform::GetInverseMatrix() const
+    Mat4 Transform::GetLocalMatrix() const
     {
-        // Create inverse transformation matrices (reverse order of UpdateMatrix)
-        Mat4 invTranslation = Mat4::Translate(-m_Position);
-        Mat4 invTranslateFromPivot = Mat4::Translate(-m_Pivot);
-
-        Mat4 invRotationX = Mat4::RotateX(-m_Rotation.x * DEG2RAD);
-        Mat4 invRotationY = Mat4::RotateY(-m_Rotation.y * DEG2RAD);
-        Mat4 invRotationZ = Mat4::RotateZ(-m_Rotation.z * DEG2RAD);
-        Mat4 invRotation = invRotationX * invRotationY * invRotationZ;
+        return TransformStore::GetInstance().GetLocalMatrix(m_Index);
+    }
 
-        Mat4 invScale = Mat4::Scale(Vec3(1.0f / m_Scale.x, 1.0f / m_Scale.y, 1.0f / m_Scale.z));
-        Mat4 invTranslateToPivot = Mat4::Translate(m_Pivot);
+    Vec3 Transform::GetWorldPosition() const
+    {
+        const Mat4 world = GetMatrix();
+        return Vec3(world.data[12], world.data[13], world.data[14]);
+    }
 
-        // Inverse order: reverse of translateToPivot * scale * rotation * translateFromPivot * translation
-        return invTranslation * invTranslateFromPivot * invRotation * invScale * invTranslateToPivot;
+    bool Transform::SetParent(const Transform *parent)
+    {
+        if (!TransformStore::GetInstance().SetParent(m_Index, parent ? parent->m_Index : TransformStore::INVALID_INDEX))
+            return false;
+        NotifyChanged();
+        return true;
     }
 
-    void Transform::UpdateMatrix() const
+    void Transform::SetWorldMatrix(const Mat4 &worldMatrix)
     {
-        // Create transformation matrices
-        Mat4 translateToPivot = Mat4::Translate(-m_Pivot);
-        Mat4 scale = Mat4::Scale(m_Scale);
+        TransformStore &store = TransformStore::GetInstance();
+        const TransformStore::Index parent = store.GetParent(m_Index);
+        const Mat4 local = parent == TransformStore::INVALID_INDEX ? worldMatrix : worldMatrix * store.GetMatrix(parent).InverseAffine();
 
-        Mat4 rotationX = Mat4::RotateX(m_Rotation.x * DEG2RAD);
-        Mat4 rotationY = Mat4::RotateY(m_Rotation.y * DEG2RAD);
-        Mat4 rotationZ = Mat4::RotateZ(m_Rotation.z * DEG2RAD);
-        Mat4 rotation = rotationZ * rotationY * rotationX;
+        // Columns of the linear part are the scaled rotation axes
+        Vec3 right(local.data[0], local.data[1], local.data[2]);
+        Vec3 up(local.data[4], local.data[5], local.data[6]);
+        Vec3 forward(local.data[8], local.data[9], local.data[10]);
+        Vec3 scale(right.Length(), up.Length(), forward.Length());
+        if (right.Dot(up.Cross(forward)) < 0.0f)
+            scale.x = -scale.x; // Mirrored: fold the reflection into one axis
 
-        Mat4 translateFromPivot = Mat4::Translate(m_Pivot);
-        Mat4 translation = Mat4::Translate(m_Position);
+        const Vec3 translation(local.data[12], local.data[13], local.data[14]);
+        const Vec3 pivot = store.GetPivot(m_Index);
 
-        m_CachedMatrix = translateToPivot * scale * rotation * translateFromPivot * translation;
+        // A collapsed axis has no direction to recover, so the orientation is kept as is
+        if (scale.x != 0.0f && scale.y != 0.0f && scale.z != 0.0f)
+            store.SetOrientation(m_Index, Quat::FromBasis(right / scale.x, up / scale.y, forward / scale.z));
+        store.SetScale(m_Index, scale);
+        // Inverse of translation = position + pivot - R * S * pivot
+        store.SetPosition(m_Index, translation - pivot + right * pivot.x + up * pivot.y + forward * pivot.z);
+        NotifyChanged();
+    }
+
+    Mat4 Transform::GetInverseMatrix() const
+    {
+        return GetMatrix().InverseAffine();
     }
 
     void Transform::Reset()
     {
-        m_Position = Vec3(0.0f, 0.0f, 0.0f);
-        m_Rotation = Vec3(0.0f, 0.0f, 0.0f);
-        m_Scale = Vec3(1.0f, 1.0f, 1.0f);
-        m_Pivot = Vec3(0.0f, 0.0f, 0.0f);
+        TransformStore &store = TransformStore::GetInstance();
+        store.SetPosition(m_Index, Vec3(0.0f, 0.0f, 0.0f));
+        store.SetRotation(m_Index, Vec3(0.0f, 0.0f, 0.0f));
+        store.SetScale(m_Index, Vec3(1.0f, 1.0f, 1.0f));
+        store.SetPivot(m_Index, Vec3(0.0f, 0.0f, 0.0f));
         m_MeshCenter = Vec3(0.0f, 0.0f, 0.0f);
-        InvalidateMatrix();
+        NotifyChanged();
     }
-}
\ No newline at end of file
+}
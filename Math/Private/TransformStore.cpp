@@ -0,0 +1,452 @@
+#include "TransformStore.h"
+#include "SIMD.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Voltray::Math
+{
+
+    using namespace SIMD;
+
+    namespace
+    {
+        // Below this many matrices per task, handing work to other threads costs more than it
+        // saves. A multiple of four, so only the last task has a partial SIMD batch.
+        constexpr std::size_t MATRICES_PER_TASK = 8192;
+    }
+
+    TransformStore &TransformStore::GetInstance()
+    {
+        // Never destroyed, so transforms owned by other statics can still release their slots
+        static TransformStore *instance = new TransformStore();
+        return *instance;
+    }
+
+    TransformStore::Index TransformStore::Allocate()
+    {
+        Index index;
+        if (!m_FreeList.empty())
+        {
+            index = m_FreeList.back();
+            m_FreeList.pop_back();
+            m_Position.Set(index, Vec3(0.0f, 0.0f, 0.0f));
+            m_Orientation.Set(index, Quat::Identity());
+            m_Scale.Set(index, Vec3(1.0f, 1.0f, 1.0f));
+            m_Pivot.Set(index, Vec3(0.0f, 0.0f, 0.0f));
+            m_EulerAngles.Set(index, Vec3(0.0f, 0.0f, 0.0f));
+            m_EulerStale[index] = 0;
+            m_Alive[index] = 1;
+        }
+        else
+        {
+            index = static_cast<Index>(m_Versions.size());
+            m_Position.PushBack(Vec3(0.0f, 0.0f, 0.0f));
+            m_Orientation.PushBack(Quat::Identity());
+            m_Scale.PushBack(Vec3(1.0f, 1.0f, 1.0f));
+            m_Pivot.PushBack(Vec3(0.0f, 0.0f, 0.0f));
+            m_EulerAngles.PushBack(Vec3(0.0f, 0.0f, 0.0f));
+            m_EulerStale.push_back(0);
+            m_LocalMatrices.push_back(Mat4::Identity());
+            m_Dirty.push_back(0);
+            m_Alive.push_back(1);
+            m_Versions.push_back(0);
+            m_Parent.push_back(INVALID_INDEX);
+            m_FirstChild.push_back(INVALID_INDEX);
+            m_NextSibling.push_back(INVALID_INDEX);
+            m_OrderPosition.push_back(INVALID_INDEX);
+        }
+
+        // New slots get a place in the order and a world matrix at the next update
+        m_OrderDirty = true;
+        MarkDirty(index);
+        return index;
+    }
+
+    void TransformStore::Release(Index index)
+    {
+        Unlink(index);
+        for (Index child = m_FirstChild[index]; child != INVALID_INDEX;)
+        {
+            const Index next = m_NextSibling[child];
+            m_Parent[child] = INVALID_INDEX;
+            m_NextSibling[child] = INVALID_INDEX;
+            MarkDirty(child);
+            child = next;
+        }
+        m_FirstChild[index] = INVALID_INDEX;
+
+        // A pending dirty-list entry is skipped once the flag is cleared
+        m_Dirty[index] = 0;
+        m_Alive[index] = 0;
+        m_OrderPosition[index] = INVALID_INDEX;
+        m_OrderDirty = true;
+        m_FreeList.push_back(index);
+    }
+
+    void TransformStore::Copy(Index destination, Index source)
+    {
+        m_Position.Set(destination, m_Position.Get(source));
+        m_Orientation.Set(destination, m_Orientation.Get(source));
+        m_Scale.Set(destination, m_Scale.Get(source));
+        m_Pivot.Set(destination, m_Pivot.Get(source));
+        m_EulerAngles.Set(destination, m_EulerAngles.Get(source));
+        m_EulerStale[destination] = m_EulerStale[source];
+        MarkDirty(destination);
+    }
+
+    void TransformStore::SetPosition(Index index, const Vec3 &position)
+    {
+        m_Position.Set(index, position);
+        MarkDirty(index);
+    }
+
+    Vec3 TransformStore::GetRotation(Index index) const
+    {
+        if (m_EulerStale[index])
+        {
+            m_EulerAngles.Set(index, m_Orientation.Get(index).ToEuler());
+            m_EulerStale[index] = 0;
+        }
+        return m_EulerAngles.Get(index);
+    }
+
+    void TransformStore::SetRotation(Index index, const Vec3 &rotation)
+    {
+        m_EulerAngles.Set(index, rotation);
+        m_EulerStale[index] = 0;
+        m_Orientation.Set(index, Quat::FromEuler(rotation));
+        MarkDirty(index);
+    }
+
+    void TransformStore::SetOrientation(Index index, const Quat &orientation)
+    {
+        m_Orientation.Set(index, orientation.Normalize());
+        m_EulerStale[index] = 1;
+        MarkDirty(index);
+    }
+
+    void TransformStore::SetScale(Index index, const Vec3 &scale)
+    {
+        m_Scale.Set(index, scale);
+        MarkDirty(index);
+    }
+
+    void TransformStore::SetPivot(Index index, const Vec3 &pivot)
+    {
+        m_Pivot.Set(index, pivot);
+        MarkDirty(index);
+    }
+
+    void TransformStore::MarkDirty(Index index)
+    {
+        // Stamps come from one counter, so the newest stamp along a parent chain identifies
+        // the state of a world matrix even across reparenting
+        m_Versions[index] = ++m_VersionCounter;
+        if (!m_Dirty[index])
+        {
+            m_Dirty[index] = 1;
+            m_DirtyList.push_back(index);
+        }
+    }
+
+    bool TransformStore::SetParent(Index index, Index parent)
+    {
+        if (m_Parent[index] == parent)
+            return true;
+
+        for (Index ancestor = parent; ancestor != INVALID_INDEX; ancestor = m_Parent[ancestor])
+        {
+            if (ancestor == index)
+                return false;
+        }
+
+        Unlink(index);
+        m_Parent[index] = parent;
+        if (parent != INVALID_INDEX)
+        {
+            // Appended so children keep their creation order in the depth-first layout
+            Index *link = &m_FirstChild[parent];
+            while (*link != INVALID_INDEX)
+                link = &m_NextSibling[*link];
+            *link = index;
+        }
+
+        m_OrderDirty = true;
+        MarkDirty(index);
+        return true;
+    }
+
+    void TransformStore::Unlink(Index index)
+    {
+        const Index parent = m_Parent[index];
+        if (parent == INVALID_INDEX)
+            return;
+
+        Index *link = &m_FirstChild[parent];
+        while (*link != index)
+            link = &m_NextSibling[*link];
+        *link = m_NextSibling[index];
+        m_NextSibling[index] = INVALID_INDEX;
+        m_Parent[index] = INVALID_INDEX;
+    }
+
+    Mat4 TransformStore::GetLocalMatrix(Index index) const
+    {
+        if (!m_Dirty[index])
+            return m_LocalMatrices[index];
+
+        Mat4 local;
+        BuildMatrix(index, local);
+        return local;
+    }
+
+    Mat4 TransformStore::GetMatrix(Index index) const
+    {
+        bool stale = m_OrderPosition[index] == INVALID_INDEX;
+        for (Index ancestor = index; !stale && ancestor != INVALID_INDEX; ancestor = m_Parent[ancestor])
+            stale = m_Dirty[ancestor] != 0;
+
+        if (!stale)
+            return m_WorldMatrices[m_OrderPosition[index]];
+
+        const Index parent = m_Parent[index];
+        return parent == INVALID_INDEX ? GetLocalMatrix(index) : GetLocalMatrix(index) * GetMatrix(parent);
+    }
+
+    std::uint64_t TransformStore::GetVersion(Index index) const
+    {
+        std::uint64_t version = 0;
+        for (Index ancestor = index; ancestor != INVALID_INDEX; ancestor = m_Parent[ancestor])
+            version = std::max(version, m_Versions[ancestor]);
+        return version;
+    }
+
+    std::size_t TransformStore::UpdateMatrices(const ParallelFor &parallelFor)
+    {
+        // Drop entries released or listed twice
+        std::size_t count = 0;
+        for (Index index : m_DirtyList)
+        {
+            if (m_Dirty[index])
+            {
+                m_Dirty[index] = 0;
+                m_DirtyList[count++] = index;
+            }
+        }
+        m_DirtyList.resize(count);
+
+        const std::size_t taskCount = (count + MATRICES_PER_TASK - 1) / MATRICES_PER_TASK;
+        if (taskCount <= 1 || !parallelFor)
+        {
+            BuildMatrices(m_DirtyList.data(), count);
+        }
+        else
+        {
+            parallelFor(taskCount, [this, count](std::size_t task)
+                        {
+                const std::size_t begin = task * MATRICES_PER_TASK;
+                BuildMatrices(m_DirtyList.data() + begin, std::min(MATRICES_PER_TASK, count - begin)); });
+        }
+
+        if (m_OrderDirty)
+            RebuildOrder();
+
+        // Every modified slot invalidates its subtree; sorted positions let nested subtrees be
+        // skipped and the walk touch world matrices front to back
+        m_DirtyPositions.clear();
+        for (Index index : m_DirtyList)
+            m_DirtyPositions.push_back(m_OrderPosition[index]);
+        std::sort(m_DirtyPositions.begin(), m_DirtyPositions.end());
+
+        Index coveredEnd = 0;
+        for (Index start : m_DirtyPositions)
+        {
+            if (start < coveredEnd)
+                continue;
+
+            coveredEnd = start + m_SubtreeSize[start];
+            for (Index position = start; position < coveredEnd; ++position)
+            {
+                const Mat4 &local = m_LocalMatrices[m_Order[position]];
+                const Index parentPosition = m_OrderParent[position];
+                m_WorldMatrices[position] = parentPosition == INVALID_INDEX ? local : local * m_WorldMatrices[parentPosition];
+            }
+        }
+
+        m_DirtyList.clear();
+        return count;
+    }
+
+    void TransformStore::RebuildOrder()
+    {
+        // Keep the old world matrices so slots that did not move need no recomputation
+        std::vector<Mat4> previousWorld;
+        previousWorld.swap(m_WorldMatrices);
+        std::vector<Index> previousPosition(m_OrderPosition);
+
+        m_Order.clear();
+        m_OrderParent.clear();
+        m_SubtreeSize.clear();
+
+        // Pre-order walk: a node's first child subtree is finished before its next sibling
+        std::vector<Index> stack;
+        for (Index root = 0; root < static_cast<Index>(m_Alive.size()); ++root)
+        {
+            if (!m_Alive[root] || m_Parent[root] != INVALID_INDEX)
+                continue;
+
+            stack.push_back(root);
+            while (!stack.empty())
+            {
+                const Index node = stack.back();
+                stack.pop_back();
+
+                const Index parent = m_Parent[node];
+                m_OrderPosition[node] = static_cast<Index>(m_Order.size());
+                m_Order.push_back(node);
+                m_OrderParent.push_back(parent == INVALID_INDEX ? INVALID_INDEX : m_OrderPosition[parent]);
+                m_SubtreeSize.push_back(1);
+
+                if (m_NextSibling[node] != INVALID_INDEX)
+                    stack.push_back(m_NextSibling[node]);
+                if (m_FirstChild[node] != INVALID_INDEX)
+                    stack.push_back(m_FirstChild[node]);
+            }
+        }
+
+        // Children come after their parent, so a reverse sweep accumulates subtree sizes
+        for (std::size_t position = m_Order.size(); position-- > 0;)
+        {
+            if (m_OrderParent[position] != INVALID_INDEX)
+                m_SubtreeSize[m_OrderParent[position]] += m_SubtreeSize[position];
+        }
+
+        m_WorldMatrices.resize(m_Order.size());
+        for (std::size_t position = 0; position < m_Order.size(); ++position)
+        {
+            const Index previous = previousPosition[m_Order[position]];
+            m_WorldMatrices[position] = previous != INVALID_INDEX ? previousWorld[previous] : Mat4::Identity();
+        }
+
+        m_OrderDirty = false;
+    }
+
+    void TransformStore::BuildMatrix(Index index, Mat4 &result) const
+    {
+        // Closed form of translateToPivot * scale * rotation * translateFromPivot * translation,
+        // which maps p to position + pivot + R * S * (p - pivot)
+        const Quat q = m_Orientation.Get(index);
+        const Vec3 scale = m_Scale.Get(index);
+        const Vec3 position = m_Position.Get(index);
+        const Vec3 pivot = m_Pivot.Get(index);
+
+        // Rotation columns, each scaled by the matching axis scale
+        const Vec3 right = q.GetRight() * scale.x;
+        const Vec3 up = q.GetUp() * scale.y;
+        const Vec3 forward = q.GetForward() * scale.z;
+        const Vec3 translation = position + pivot - (right * pivot.x + up * pivot.y + forward * pivot.z);
+
+        float *m = result.data;
+        m[0] = right.x;
+        m[1] = right.y;
+        m[2] = right.z;
+        m[3] = 0.0f;
+
+        m[4] = up.x;
+        m[5] = up.y;
+        m[6] = up.z;
+        m[7] = 0.0f;
+
+        m[8] = forward.x;
+        m[9] = forward.y;
+        m[10] = forward.z;
+        m[11] = 0.0f;
+
+        m[12] = translation.x;
+        m[13] = translation.y;
+        m[14] = translation.z;
+        m[15] = 1.0f;
+    }
+
+    void TransformStore::BuildMatrices(const Index *indices, std::size_t count)
+    {
+        // Same math as BuildMatrix with one transform per lane; a partial last batch repeats
+        // its final index, which just rebuilds that matrix again
+        for (std::size_t i = 0; i < count; i += 4)
+        {
+            const Index i0 = indices[i];
+            const Index i1 = indices[std::min(i + 1, count - 1)];
+            const Index i2 = indices[std::min(i + 2, count - 1)];
+            const Index i3 = indices[std::min(i + 3, count - 1)];
+
+            // Slots modified in allocation order are adjacent and load as one vector
+            const bool contiguous = i1 == i0 + 1 && i2 == i0 + 2 && i3 == i0 + 3;
+            auto gather = [contiguous, i0, i1, i2, i3](const std::vector<float> &values)
+            {
+                return contiguous ? Load(values.data() + i0) : Set(values[i0], values[i1], values[i2], values[i3]);
+            };
+
+            const Float4 qx = gather(m_Orientation.x);
+            const Float4 qy = gather(m_Orientation.y);
+            const Float4 qz = gather(m_Orientation.z);
+            const Float4 qw = gather(m_Orientation.w);
+
+            // Doubled products shared by the three basis vectors
+            const Float4 two = Splat(2.0f);
+            const Float4 one = Splat(1.0f);
+            const Float4 x2 = Mul(qx, two), y2 = Mul(qy, two), z2 = Mul(qz, two);
+            const Float4 xx = Mul(qx, x2), yy = Mul(qy, y2), zz = Mul(qz, z2);
+            const Float4 xy = Mul(qx, y2), xz = Mul(qx, z2), yz = Mul(qy, z2);
+            const Float4 wx = Mul(qw, x2), wy = Mul(qw, y2), wz = Mul(qw, z2);
+
+            const Float4 scaleX = gather(m_Scale.x);
+            const Float4 scaleY = gather(m_Scale.y);
+            const Float4 scaleZ = gather(m_Scale.z);
+
+            Float4 c0x = Mul(Sub(one, Add(yy, zz)), scaleX);
+            Float4 c0y = Mul(Add(xy, wz), scaleX);
+            Float4 c0z = Mul(Sub(xz, wy), scaleX);
+
+            Float4 c1x = Mul(Sub(xy, wz), scaleY);
+            Float4 c1y = Mul(Sub(one, Add(xx, zz)), scaleY);
+            Float4 c1z = Mul(Add(yz, wx), scaleY);
+
+            Float4 c2x = Mul(Add(xz, wy), scaleZ);
+            Float4 c2y = Mul(Sub(yz, wx), scaleZ);
+            Float4 c2z = Mul(Sub(one, Add(xx, yy)), scaleZ);
+            const Float4 pivotX = gather(m_Pivot.x);
+            const Float4 pivotY = gather(m_Pivot.y);
+            const Float4 pivotZ = gather(m_Pivot.z);
+
+            Float4 c3x = Add(gather(m_Position.x), pivotX);
+            Float4 c3y = Add(gather(m_Position.y), pivotY);
+            Float4 c3z = Add(gather(m_Position.z), pivotZ);
+            c3x = Sub(c3x, MulAdd(c0x, pivotX, MulAdd(c1x, pivotY, Mul(c2x, pivotZ))));
+            c3y = Sub(c3y, MulAdd(c0y, pivotX, MulAdd(c1y, pivotY, Mul(c2y, pivotZ))));
+            c3z = Sub(c3z, MulAdd(c0z, pivotX, MulAdd(c1z, pivotY, Mul(c2z, pivotZ))));
+
+            // Lanes hold one transform each; transposing turns them into matrix columns
+            Float4 w0 = Zero(), w1 = Zero(), w2 = Zero(), w3 = Splat(1.0f);
+            Transpose(c0x, c0y, c0z, w0);
+            Transpose(c1x, c1y, c1z, w1);
+            Transpose(c2x, c2y, c2z, w2);
+            Transpose(c3x, c3y, c3z, w3);
+
+            const Float4 columns[4][4] = {
+                {c0x, c1x, c2x, c3x},
+                {c0y, c1y, c2y, c3y},
+                {c0z, c1z, c2z, c3z},
+                {w0, w1, w2, w3}};
+            const Index targets[4] = {i0, i1, i2, i3};
+            for (int lane = 0; lane < 4; ++lane)
+            {
+                float *m = m_LocalMatrices[targets[lane]].data;
+                Store(m, columns[lane][0]);
+                Store(m + 4, columns[lane][1]);
+                Store(m + 8, columns[lane][2]);
+                Store(m + 12, columns[lane][3]);
+            }
+        }
+    }
+
+}
@@ -1,87 +0,0 @@
-#include "Vec3.h"
-#include <iostream>
-#include <cmath>
-
-namespace Voltray::Math
-{
-
-    Vec3::Vec3() : x(0), y(0), z(0) {}
-    Vec3::Vec3(float value) : x(value), y(value), z(value) {}
-    Vec3::Vec3(float x, float y, float z) : x(x), y(y), z(z) {}
-
-    Vec3 Vec3::operator+(const Vec3 &other) const
-    {
-        return Vec3(x + other.x, y + other.y, z + other.z);
-    }
-
-    Vec3 Vec3::operator-(const Vec3 &other) const
-    {
-        return Vec3(x - other.x, y - other.y, z - other.z);
-    }
-
-    Vec3 Vec3::operator*(float scalar) const
-    {
-        return Vec3(x * scalar, y * scalar, z * scalar);
-    }
-
-    Vec3 Vec3::operator/(float scalar) const
-    {
-        return Vec3(x / scalar, y / scalar, z / scalar);
-    }
-
-    Vec3 Vec3::operator-() const
-    {
-        return Vec3(-x, -y, -z);
-    }
-
-    float Vec3::Length() const
-    {
-        return std::sqrt(x * x + y * y + z * z);
-    }
-
-    Vec3 Vec3::Normalize() const
-    {
-        float len = Length();
-        if (len == 0.0f)
-            return *this;
-        return *this / len;
-    }
-
-    float Vec3::Dot(const Vec3 &other) const
-    {
-        return x * other.x + y * other.y + z * other.z;
-    }
-
-    Vec3 Vec3::Cross(const Vec3 &other) const
-    {
-        return Vec3(
-            y * other.z - z * other.y,
-            z * other.x - x * other.z,
-            x * other.y - y * other.x);
-    }
-
-    Vec3 &Vec3::operator+=(const Vec3 &other)
-    {
-        x += other.x;
-        y += other.y;
-        z += other.z;
-        return *this;
-    }
-
-    Vec3 &Vec3::operator-=(const Vec3 &other)
-    {
-        x -= other.x;
-        y -= other.y;
-        z -= other.z;
-        return *this;
-    }
-
-    Vec3 &Vec3::operator*=(float scalar)
-    {
-        x *= scalar;
-        y *= scalar;
-        z *= scalar;
-        return *this;
-    }
-
-}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "Vec3.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Voltray::Math
+{
+
+    /**
+     * @class BVH
+     * @brief Bounding volume hierarchy over the triangles of an indexed mesh.
+     *
+     * The hierarchy is built top-down with a binned surface area heuristic (SAH). Nodes are
+     * stored in a flat array; the children of an inner node are always adjacent, so only the
+     * index of the left child is stored. Leaves reference a contiguous range of the reordered
+     * triangle list.
+     *
+     * The BVH does not own any vertex data. It must be traversed together with the same
+     * vertex and index arrays it was built from.
+     */
+    class BVH
+    {
+    public:
+        /**
+         * @brief A single node of the hierarchy (32 bytes).
+         */
+        struct Node
+        {
+            Vec3 minBounds;              ///< Minimum corner of the node bounds
+            std::uint32_t leftFirst;     ///< Left child index for inner nodes, first triangle for leaves
+            Vec3 maxBounds;              ///< Maximum corner of the node bounds
+            std::uint32_t triangleCount; ///< Number of triangles in a leaf, zero for inner nodes
+
+            bool IsLeaf() const { return triangleCount > 0; }
+        };
+
+        /**
+         * @brief Creates an empty BVH.
+         */
+        BVH() = default;
+
+        /**
+         * @brief Builds a BVH over the triangles of an indexed mesh.
+         * @param vertices Interleaved vertex data, position in the first three floats of each vertex.
+         * @param indices Triangle list indices.
+         * @param stride Number of floats per vertex.
+         */
+        BVH(const std::vector<float> &vertices, const std::vector<unsigned int> &indices, unsigned int stride);
+
+        /**
+         * @brief Rebuilds the hierarchy, discarding any previous contents.
+         * @param vertices Interleaved vertex data, position in the first three floats of each vertex.
+         * @param indices Triangle list indices.
+         * @param stride Number of floats per vertex.
+         */
+        void Build(const std::vector<float> &vertices, const std::vector<unsigned int> &indices, unsigned int stride);
+
+        /**
+         * @brief Checks whether the hierarchy contains any triangles.
+         * @return True if nothing has been built.
+         */
+        bool IsEmpty() const { return m_Nodes.empty(); }
+
+        /**
+         * @brief Gets the node array. The root is at index 0.
+         * @return Const reference to the nodes.
+         */
+        const std::vector<Node> &GetNodes() const { return m_Nodes; }
+
+        /**
+         * @brief Gets the triangle order referenced by the leaves.
+         * @return Triangle numbers (index into the index array divided by three).
+         */
+        const std::vector<std::uint32_t> &GetTriangles() const { return m_Triangles; }
+
+        /**
+         * @brief Gets the vertex stride the hierarchy was built with.
+         * @return Number of floats per vertex.
+         */
+        unsigned int GetStride() const { return m_Stride; }
+
+        /**
+         * @brief Gets the approximate heap memory used by the hierarchy.
+         * @return Size in bytes.
+         */
+        std::size_t GetMemoryUsage() const;
+
+    private:
+        std::vector<Node> m_Nodes;
+        std::vector<std::uint32_t> m_Triangles;
+        unsigned int m_Stride = 8;
+    };
+
+}
@@ -0,0 +1,288 @@
+#pragma once
+
+#include "Vec3.h"
+#include "Ray.h"
+#include "Frustum.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace Voltray::Math
+{
+
+    /**
+     * @class DynamicAABBTree
+     * @brief Incrementally updated bounding volume hierarchy over moving boxes.
+     *
+     * Each proxy is stored in a leaf with a "fat" box that is slightly larger than the box
+     * it was created with, so small movements do not touch the tree at all. When a proxy
+     * leaves its fat box it is removed and reinserted, and the ancestors are refitted and
+     * rebalanced with tree rotations. Insert, remove and move are O(log n); queries visit
+     * only the branches that overlap the query volume.
+     *
+     * Query callbacks only ever see fat boxes; callers are expected to run their exact test
+     * on the reported proxies.
+     */
+    class DynamicAABBTree
+    {
+    public:
+        static constexpr int NULL_NODE = -1;
+
+        /**
+         * @brief Creates an empty tree.
+         * @param margin Fraction of a box's largest extent added on every side of its fat box.
+         */
+        explicit DynamicAABBTree(float margin = 0.1f);
+
+        /**
+         * @brief Inserts a new proxy.
+         * @param minBounds Minimum corner of the tight box.
+         * @param maxBounds Maximum corner of the tight box.
+         * @param userData Opaque pointer returned by GetUserData.
+         * @return The proxy id, stable until the proxy is destroyed.
+         */
+        int CreateProxy(const Vec3 &minBounds, const Vec3 &maxBounds, void *userData);
+
+        /**
+         * @brief Removes a proxy from the tree.
+         * @param proxyId Id returned by CreateProxy.
+         */
+        void DestroyProxy(int proxyId);
+
+        /**
+         * @brief Updates the box of a proxy.
+         * @param proxyId Id returned by CreateProxy.
+         * @param minBounds Minimum corner of the new tight box.
+         * @param maxBounds Maximum corner of the new tight box.
+         * @return True if the proxy had to be reinserted, false if its fat box still fits.
+         */
+        bool MoveProxy(int proxyId, const Vec3 &minBounds, const Vec3 &maxBounds);
+
+        /**
+         * @brief Removes every proxy.
+         */
+        void Clear();
+
+        void *GetUserData(int proxyId) const { return m_Nodes[proxyId].userData; }
+        const Vec3 &GetFatMin(int proxyId) const { return m_Nodes[proxyId].minBounds; }
+        const Vec3 &GetFatMax(int proxyId) const { return m_Nodes[proxyId].maxBounds; }
+        std::size_t GetProxyCount() const { return m_ProxyCount; }
+
+        /**
+         * @brief Gets the height of the tree, zero for a single leaf.
+         * @return Height of the root, or -1 when empty.
+         */
+        int GetHeight() const { return m_Root == NULL_NODE ? -1 : m_Nodes[m_Root].height; }
+
+        /**
+         * @brief Reports every proxy whose fat box overlaps a box.
+         * @param callback Called as bool(int proxyId); return false to stop the query.
+         */
+        template <typename Callback>
+        void QueryAABB(const Vec3 &minBounds, const Vec3 &maxBounds, Callback &&callback) const;
+
+        /**
+         * @brief Reports proxies whose fat box is hit by a ray, nearest branches first.
+         * @param maxDistance Initial upper bound on the hit distance.
+         * @param callback Called as float(int proxyId, float maxDistance) and returns the new upper
+         *                 bound. Return maxDistance to keep going, a smaller value to clip the ray,
+         *                 or zero to stop.
+         */
+        template <typename Callback>
+        void QueryRay(const Ray &ray, float maxDistance, Callback &&callback) const;
+
+        /**
+         * @brief Reports every proxy whose fat box is not outside a frustum.
+         *
+         * Subtrees that are completely inside are reported without further plane tests.
+         *
+         * @param callback Called as void(int proxyId).
+         */
+        template <typename Callback>
+        void QueryFrustum(const Frustum &frustum, Callback &&callback) const;
+
+    private:
+        struct Node
+        {
+            Vec3 minBounds;
+            Vec3 maxBounds;
+            void *userData = nullptr;
+            int parent = NULL_NODE; ///< Parent, or next free node while on the free list
+            int child1 = NULL_NODE;
+            int child2 = NULL_NODE;
+            int height = 0; ///< Leaf = 0, free node = -1
+
+            bool IsLeaf() const { return child1 == NULL_NODE; }
+        };
+
+        int AllocateNode();
+        void FreeNode(int nodeId);
+        void InsertLeaf(int leaf);
+        void RemoveLeaf(int leaf);
+        int Balance(int nodeId);
+        void Refit(int nodeId);
+        float GetPadding(const Vec3 &minBounds, const Vec3 &maxBounds) const;
+
+        static bool Overlaps(const Node &node, const Vec3 &minBounds, const Vec3 &maxBounds)
+        {
+            return node.minBounds.x <= maxBounds.x && node.maxBounds.x >= minBounds.x &&
+                   node.minBounds.y <= maxBounds.y && node.maxBounds.y >= minBounds.y &&
+                   node.minBounds.z <= maxBounds.z && node.maxBounds.z >= minBounds.z;
+        }
+
+        // Slab test returning the entry distance clamped to zero, or infinity on a miss
+        static float RayEntry(const Node &node, const Vec3 &origin, const Vec3 &invDirection, float maxDistance)
+        {
+            float t1 = (node.minBounds.x - origin.x) * invDirection.x;
+            float t2 = (node.maxBounds.x - origin.x) * invDirection.x;
+            float tmin = t1 < t2 ? t1 : t2, tmax = t1 < t2 ? t2 : t1;
+
+            t1 = (node.minBounds.y - origin.y) * invDirection.y;
+            t2 = (node.maxBounds.y - origin.y) * invDirection.y;
+            tmin = std::max(tmin, t1 < t2 ? t1 : t2);
+            tmax = std::min(tmax, t1 < t2 ? t2 : t1);
+
+            t1 = (node.minBounds.z - origin.z) * invDirection.z;
+            t2 = (node.maxBounds.z - origin.z) * invDirection.z;
+            tmin = std::max(tmin, t1 < t2 ? t1 : t2);
+            tmax = std::min(tmax, t1 < t2 ? t2 : t1);
+
+            tmin = std::max(tmin, 0.0f);
+            return (tmin <= tmax && tmin < maxDistance) ? tmin : std::numeric_limits<float>::infinity();
+        }
+
+        std::vector<Node> m_Nodes;
+        int m_Root = NULL_NODE;
+        int m_FreeList = NULL_NODE;
+        std::size_t m_ProxyCount = 0;
+        float m_Margin;
+    };
+
+    template <typename Callback>
+    void DynamicAABBTree::QueryAABB(const Vec3 &minBounds, const Vec3 &maxBounds, Callback &&callback) const
+    {
+        if (m_Root == NULL_NODE)
+            return;
+
+        std::vector<int> stack;
+        stack.reserve(64);
+        stack.push_back(m_Root);
+        while (!stack.empty())
+        {
+            const int nodeId = stack.back();
+            stack.pop_back();
+
+            const Node &node = m_Nodes[nodeId];
+
+            if (!Overlaps(node, minBounds, maxBounds))
+                continue;
+
+            if (node.IsLeaf())
+            {
+                if (!callback(nodeId))
+                    return;
+            }
+            else
+            {
+                stack.push_back(node.child1);
+                stack.push_back(node.child2);
+            }
+        }
+    }
+
+    template <typename Callback>
+    void DynamicAABBTree::QueryRay(const Ray &ray, float maxDistance, Callback &&callback) const
+    {
+        if (m_Root == NULL_NODE)
+            return;
+
+        const Vec3 invDirection(1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z);
+        if (RayEntry(m_Nodes[m_Root], ray.origin, invDirection, maxDistance) == std::numeric_limits<float>::infinity())
+            return;
+
+        // Entries carry the node and the entry distance computed when it was pushed, so
+        // branches that became farther than the current best hit can be skipped on pop
+        struct Entry
+        {
+            int nodeId;
+            float distance;
+        };
+        std::vector<Entry> stack;
+        stack.reserve(64);
+        stack.push_back({m_Root, 0.0f});
+
+        while (!stack.empty())
+        {
+            const Entry entry = stack.back();
+            stack.pop_back();
+            if (entry.distance >= maxDistance)
+                continue;
+
+            const Node &node = m_Nodes[entry.nodeId];
+            if (node.IsLeaf())
+            {
+                maxDistance = callback(entry.nodeId, maxDistance);
+                if (maxDistance <= 0.0f)
+                    return;
+                continue;
+            }
+
+            float distance1 = RayEntry(m_Nodes[node.child1], ray.origin, invDirection, maxDistance);
+            float distance2 = RayEntry(m_Nodes[node.child2], ray.origin, invDirection, maxDistance);
+            int near = node.child1, far = node.child2;
+            if (distance2 < distance1)
+            {
+                std::swap(distance1, distance2);
+                std::swap(near, far);
+            }
+
+            if (distance2 != std::numeric_limits<float>::infinity())
+                stack.push_back({far, distance2});
+            if (distance1 != std::numeric_limits<float>::infinity())
+                stack.push_back({near, distance1});
+        }
+    }
+
+    template <typename Callback>
+    void DynamicAABBTree::QueryFrustum(const Frustum &frustum, Callback &&callback) const
+    {
+        if (m_Root == NULL_NODE)
+            return;
+
+        // Sign bit of the node id on the stack marks subtrees already known to be inside
+        std::vector<int> stack;
+        stack.reserve(64);
+        stack.push_back(m_Root);
+        while (!stack.empty())
+        {
+            int nodeId = stack.back();
+            stack.pop_back();
+
+            bool inside = nodeId < 0;
+            if (inside)
+                nodeId = ~nodeId;
+
+            const Node &node = m_Nodes[nodeId];
+            if (!inside)
+            {
+                Frustum::Containment containment = frustum.ClassifyAABB(node.minBounds, node.maxBounds);
+                if (containment == Frustum::Containment::Outside)
+                    continue;
+                inside = containment == Frustum::Containment::Inside;
+            }
+
+            if (node.IsLeaf())
+            {
+                callback(nodeId);
+            }
+            else
+            {
+                stack.push_back(inside ? ~node.child1 : node.child1);
+                stack.push_back(inside ? ~node.child2 : node.child2);
+            }
+        }
+    }
+
+}
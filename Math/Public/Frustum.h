@@ -0,0 +1,105 @@
+#pragma once
+
+#include "Vec3.h"
+#include "Vec4.h"
+#include "Mat4.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace Voltray::Math
+{
+
+    /**
+     * @class Frustum
+     * @brief View frustum described by six normalized planes.
+     *
+     * Planes are extracted from a combined view-projection matrix (Gribb/Hartmann) and
+     * point inwards, so a point is inside when its signed distance to every plane is positive.
+     */
+    class Frustum
+    {
+    public:
+        /**
+         * @brief Result of classifying a volume against the frustum.
+         */
+        enum class Containment
+        {
+            Outside,      ///< Completely outside at least one plane
+            Intersecting, ///< Straddles one or more planes
+            Inside        ///< Completely inside all planes
+        };
+
+        /**
+         * @brief Plane indices in the order they are stored.
+         */
+        enum Plane
+        {
+            Left = 0,
+            Right,
+            Bottom,
+            Top,
+            Near,
+            Far,
+            PlaneCount
+        };
+
+        /**
+         * @brief Creates a frustum that contains everything.
+         */
+        Frustum();
+
+        /**
+         * @brief Creates a frustum from a view-projection matrix.
+         * @param viewProjection The combined view-projection matrix (as returned by the camera).
+         */
+        explicit Frustum(const Mat4 &viewProjection);
+
+        /**
+         * @brief Re-extracts the planes from a view-projection matrix.
+         * @param viewProjection The combined view-projection matrix (as returned by the camera).
+         */
+        void Extract(const Mat4 &viewProjection);
+
+        /**
+         * @brief Classifies an axis-aligned bounding box against the frustum.
+         * @param minBounds Minimum corner of the box.
+         * @param maxBounds Maximum corner of the box.
+         * @return Whether the box is outside, intersecting or fully inside.
+         */
+        Containment ClassifyAABB(const Vec3 &minBounds, const Vec3 &maxBounds) const;
+
+        /**
+         * @brief Conservative visibility test for an axis-aligned bounding box.
+         * @param minBounds Minimum corner of the box.
+         * @param maxBounds Maximum corner of the box.
+         * @return False only if the box is guaranteed to be outside the frustum.
+         */
+        bool IntersectsAABB(const Vec3 &minBounds, const Vec3 &maxBounds) const;
+
+        /**
+         * @brief Conservative visibility test for many boxes stored as structure of arrays.
+         *
+         * Each plane is applied in a separate branch-free pass over contiguous arrays, which
+         * compilers turn into SIMD code. Results match IntersectsAABB for every box.
+         *
+         * @param minX,minY,minZ Minimum corners, one entry per box.
+         * @param maxX,maxY,maxZ Maximum corners, one entry per box.
+         * @param count Number of boxes.
+         * @param visible Output, set to 1 for boxes that may be visible and 0 for culled ones.
+         */
+        void IntersectsAABBs(const float *minX, const float *minY, const float *minZ,
+                             const float *maxX, const float *maxY, const float *maxZ,
+                             std::size_t count, std::uint8_t *visible) const;
+
+        /**
+         * @brief Gets a frustum plane as (normal.xyz, distance).
+         * @param plane Index of the plane.
+         * @return The normalized plane equation.
+         */
+        const Vec4 &GetPlane(Plane plane) const { return m_Planes[plane]; }
+
+    private:
+        Vec4 m_Planes[PlaneCount];
+    };
+
+}
@@ -52,6 +52,18 @@ struct Mat4
      * @return Transformed Vec4.
      */
     Vec4 MultiplyVec4(const Vec4 &v) const;
+
+    /**
+     * @brief Computes the axis-aligned bounds of a transformed box (affine matrices only).
+     *
+     * Transforms the box center and widens by the absolute 3x3 part applied to the half extent,
+     * which gives the same box as transforming all eight corners.
+     * @param minBounds Minimum corner of the input box.
+     * @param maxBounds Maximum corner of the input box.
+     * @param outMin Receives the minimum corner of the transformed box.
+     * @param outMax Receives the maximum corner of the transformed box.
+     */
+    void TransformBounds(const Vec3 &minBounds, const Vec3 &maxBounds, Vec3 &outMin, Vec3 &outMax) const;
     static Mat4 Translate(const Vec3 &translation);
     static Mat4 Scale(const Vec3 &scale);    static Mat4 RotateX(float angleRad);
     static Mat4 RotateY(float angleRad);
@@ -59,7 +71,20 @@ struct Mat4
     static Mat4 LookAt(const Vec3 &eye, const Vec3 &center, const Vec3 &up);
     static Mat4 Perspective(float fovRadians, float aspect, float near, float far);
     static Mat4 Orthographic(float left, float right, float bottom, float top, float near, float far);
+
+    /**
+     * @brief Computes the inverse of a general 4x4 matrix.
+     * @return Inverse matrix, or identity if the matrix is singular.
+     */
     Mat4 Inverse() const;
+
+    /**
+     * @brief Computes the inverse of an affine matrix (bottom row 0, 0, 0, 1).
+     *
+     * Cheaper than Inverse for model and view matrices; gives wrong results for projections.
+     * @return Inverse matrix, or identity if the 3x3 part is singular.
+     */
+    Mat4 InverseAffine() const;
 };
 
 }
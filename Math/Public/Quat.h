@@ -0,0 +1,191 @@
+#pragma once
+
+#include "Vec3.h"
+#include "Mat4.h"
+#include "MathUtil.h"
+#include <cmath>
+
+namespace Voltray::Math
+{
+
+    // Unit quaternion representing a rotation; x, y, z is the vector part and w the scalar part.
+    // Euler conversions use the engine convention shared with Transform: angles in degrees,
+    // matrix rotationZ * rotationY * rotationX in Mat4 multiplication order.
+    struct Quat
+    {
+        float x, y, z, w; ///< Vector part (x, y, z) and scalar part (w).
+
+        /// Default constructor. Initializes to the identity rotation.
+        constexpr Quat() : x(0), y(0), z(0), w(1) {}
+
+        /// Constructs a quaternion from its components.
+        constexpr Quat(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
+
+        /// Identity rotation.
+        static constexpr Quat Identity() { return Quat(); }
+
+        /// Rotation around a unit axis.
+        /// @param axis The rotation axis, must be normalized.
+        /// @param radians The rotation angle in radians.
+        static Quat FromAxisAngle(const Vec3 &axis, float radians)
+        {
+            const float s = std::sin(radians * 0.5f);
+            return Quat(axis.x * s, axis.y * s, axis.z * s, std::cos(radians * 0.5f));
+        }
+
+        /// Rotation whose local axes are the given orthonormal vectors.
+        /// @param right Rotated x axis.
+        /// @param up Rotated y axis.
+        /// @param forward Rotated z axis.
+        static Quat FromBasis(const Vec3 &right, const Vec3 &up, const Vec3 &forward)
+        {
+            // Branch on the largest diagonal term to keep the square root well away from zero
+            const float trace = right.x + up.y + forward.z;
+            if (trace > 0.0f)
+            {
+                const float s = std::sqrt(trace + 1.0f) * 2.0f;
+                return Quat((up.z - forward.y) / s, (forward.x - right.z) / s, (right.y - up.x) / s, 0.25f * s);
+            }
+            if (right.x > up.y && right.x > forward.z)
+            {
+                const float s = std::sqrt(1.0f + right.x - up.y - forward.z) * 2.0f;
+                return Quat(0.25f * s, (up.x + right.y) / s, (forward.x + right.z) / s, (up.z - forward.y) / s);
+            }
+            if (up.y > forward.z)
+            {
+                const float s = std::sqrt(1.0f + up.y - right.x - forward.z) * 2.0f;
+                return Quat((up.x + right.y) / s, 0.25f * s, (forward.y + up.z) / s, (forward.x - right.z) / s);
+            }
+            const float s = std::sqrt(1.0f + forward.z - right.x - up.y) * 2.0f;
+            return Quat((forward.x + right.z) / s, (forward.y + up.z) / s, 0.25f * s, (right.y - up.x) / s);
+        }
+
+        /// Rotation from Euler angles in degrees, matching Transform::SetRotation.
+        /// @param degrees Rotation around the x, y and z axes.
+        static Quat FromEuler(const Vec3 &degrees)
+        {
+            // The engine's Euler matrix is the transpose of Rz * Ry * Rx in column-vector form,
+            // i.e. the inverse rotation, so build that one and conjugate it
+            const float hx = degrees.x * DEG2RAD * 0.5f, hy = degrees.y * DEG2RAD * 0.5f, hz = degrees.z * DEG2RAD * 0.5f;
+            const float sx = std::sin(hx), cx = std::cos(hx);
+            const float sy = std::sin(hy), cy = std::cos(hy);
+            const float sz = std::sin(hz), cz = std::cos(hz);
+            return Quat(
+                -(sx * cy * cz - cx * sy * sz),
+                -(cx * sy * cz + sx * cy * sz),
+                -(cx * cy * sz - sx * sy * cz),
+                cx * cy * cz + sx * sy * sz);
+        }
+
+        /// Converts back to Euler angles in degrees, matching Transform::GetRotation.
+        /// At gimbal lock (y = +-90) the z angle is folded into x.
+        Vec3 ToEuler() const
+        {
+            // Entries of the rotation matrix used by the engine convention (row, column)
+            const float r00 = 1.0f - 2.0f * (y * y + z * z);
+            const float r01 = 2.0f * (x * y - w * z);
+            const float r02 = 2.0f * (x * z + w * y);
+            const float r10 = 2.0f * (x * y + w * z);
+            const float r11 = 1.0f - 2.0f * (x * x + z * z);
+            const float r12 = 2.0f * (y * z - w * x);
+            const float r22 = 1.0f - 2.0f * (x * x + y * y);
+
+            const float sinY = MathUtil::Clamp(-r02, -1.0f, 1.0f);
+            if (std::abs(sinY) > 0.99999f)
+            {
+                return Vec3(std::atan2(r10 * sinY, r11) * RAD2DEG, std::asin(sinY) * RAD2DEG, 0.0f);
+            }
+            return Vec3(std::atan2(r12, r22) * RAD2DEG, std::asin(sinY) * RAD2DEG, std::atan2(r01, r00) * RAD2DEG);
+        }
+
+        /// Combines two rotations; the result applies other first, then this.
+        constexpr Quat operator*(const Quat &other) const
+        {
+            return Quat(
+                w * other.x + x * other.w + y * other.z - z * other.y,
+                w * other.y - x * other.z + y * other.w + z * other.x,
+                w * other.z + x * other.y - y * other.x + z * other.w,
+                w * other.w - x * other.x - y * other.y - z * other.z);
+        }
+
+        /// Inverse of a unit quaternion.
+        constexpr Quat Conjugate() const { return Quat(-x, -y, -z, w); }
+
+        /// Dot product of the four components.
+        constexpr float Dot(const Quat &other) const { return x * other.x + y * other.y + z * other.z + w * other.w; }
+
+        /// Returns the quaternion scaled to unit length, or identity if it is zero.
+        Quat Normalize() const
+        {
+            const float lengthSquared = Dot(*this);
+            if (lengthSquared <= 0.0f)
+                return Identity();
+            const float inverseLength = 1.0f / std::sqrt(lengthSquared);
+            return Quat(x * inverseLength, y * inverseLength, z * inverseLength, w * inverseLength);
+        }
+
+        /// Rotates a vector.
+        constexpr Vec3 Rotate(const Vec3 &v) const
+        {
+            // v + 2w(u x v) + 2u x (u x v), with u the vector part
+            const Vec3 u(x, y, z);
+            const Vec3 t = u.Cross(v) * 2.0f;
+            return v + t * w + u.Cross(t);
+        }
+
+        /// Local axes of the rotation, i.e. the rotated unit x, y and z vectors.
+        constexpr Vec3 GetRight() const { return Vec3(1.0f - 2.0f * (y * y + z * z), 2.0f * (x * y + w * z), 2.0f * (x * z - w * y)); }
+        constexpr Vec3 GetUp() const { return Vec3(2.0f * (x * y - w * z), 1.0f - 2.0f * (x * x + z * z), 2.0f * (y * z + w * x)); }
+        constexpr Vec3 GetForward() const { return Vec3(2.0f * (x * z + w * y), 2.0f * (y * z - w * x), 1.0f - 2.0f * (x * x + y * y)); }
+
+        /// Rotation matrix of a unit quaternion.
+        Mat4 ToMat4() const
+        {
+            Mat4 result = Mat4::Identity();
+            const Vec3 right = GetRight(), up = GetUp(), forward = GetForward();
+            result.data[0] = right.x;
+            result.data[1] = right.y;
+            result.data[2] = right.z;
+            result.data[4] = up.x;
+            result.data[5] = up.y;
+            result.data[6] = up.z;
+            result.data[8] = forward.x;
+            result.data[9] = forward.y;
+            result.data[10] = forward.z;
+            return result;
+        }
+
+        /// Spherical linear interpolation along the shortest arc.
+        /// @param from Rotation at t = 0.
+        /// @param to Rotation at t = 1.
+        /// @param t Interpolation factor (0-1).
+        static Quat Slerp(const Quat &from, const Quat &to, float t)
+        {
+            float cosTheta = from.Dot(to);
+            Quat target = to;
+            if (cosTheta < 0.0f)
+            {
+                cosTheta = -cosTheta;
+                target = Quat(-to.x, -to.y, -to.z, -to.w);
+            }
+
+            float fromWeight = 1.0f - t;
+            float toWeight = t;
+            if (cosTheta < 0.9995f)
+            {
+                // Nearly parallel rotations fall back to normalized lerp to avoid dividing by ~0
+                const float theta = std::acos(cosTheta);
+                const float inverseSin = 1.0f / std::sin(theta);
+                fromWeight = std::sin(fromWeight * theta) * inverseSin;
+                toWeight = std::sin(toWeight * theta) * inverseSin;
+            }
+            return Quat(
+                       from.x * fromWeight + target.x * toWeight,
+                       from.y * fromWeight + target.y * toWeight,
+                       from.z * fromWeight + target.z * toWeight,
+                       from.w * fromWeight + target.w * toWeight)
+                .Normalize();
+        }
+    };
+
+}
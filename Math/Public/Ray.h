@@ -7,6 +7,8 @@
 namespace Voltray::Math
 {
 
+    class BVH;
+
     /**
      * @struct Ray
      * @brief Represents a ray in 3D space with an origin and direction.
@@ -67,23 +69,34 @@ namespace Voltray::Math
         bool IntersectTriangle(const Vec3 &v0, const Vec3 &v1, const Vec3 &v2, float &t) const;
 
         /**
-         * @brief Tests intersection with a mesh by testing all triangles.
-         * @param vertices Vertex data array (position, normal, texcoord per vertex).
+         * @brief Tests intersection with a mesh.
+         *
+         * When a BVH built from the same vertex and index data is supplied, only the triangles in
+         * the leaves the ray passes through are tested. Otherwise every triangle is tested.
+         *
+         * @param vertices Vertex data array, position in the first three floats of each vertex.
          * @param indices Index data array.
+         * @param stride Number of floats per vertex.
          * @param t Output parameter for closest intersection distance.
+         * @param bvh Optional acceleration structure for the mesh.
          * @return True if intersection occurs, false otherwise.
          */
-        bool IntersectMesh(const std::vector<float> &vertices, const std::vector<unsigned int> &indices, float &t) const;
+        bool IntersectMesh(const std::vector<float> &vertices, const std::vector<unsigned int> &indices, unsigned int stride, float &t,
+                           const BVH *bvh = nullptr) const;
 
         /**
-         * @brief Tests intersection with a mesh by testing all triangles, with transformation.
-         * @param vertices Vertex data array (position, normal, texcoord per vertex).
+         * @brief Tests intersection with a mesh, with transformation.
+         * @param vertices Vertex data array, position in the first three floats of each vertex.
          * @param indices Index data array.
+         * @param stride Number of floats per vertex.
          * @param transform Transformation matrix from object local space to world space.
          * @param t Output parameter for closest intersection distance.
+         * @param bvh Optional acceleration structure for the mesh.
          * @return True if intersection occurs, false otherwise.
          */
-        bool IntersectMesh(const std::vector<float> &vertices, const std::vector<unsigned int> &indices, const Mat4 &transform, float &t) const;
+        bool IntersectMesh(const std::vector<float> &vertices, const std::vector<unsigned int> &indices, unsigned int stride,
+                           const Mat4 &transform, float &t,
+                           const BVH *bvh = nullptr) const;
 
         /**
          * @brief Gets the origin of the ray.
@@ -0,0 +1,302 @@
+#pragma once
+
+// Instruction set selection happens at compile time:
+//   - SSE2 on x86-64 (always available) and 32-bit x86 built with SSE2
+//   - NEON on ARM
+//   - plain floats everywhere else, or when VOLTRAY_SIMD_SCALAR is defined
+// Fused multiply-add is used when the compiler targets FMA (e.g. VOLTRAY_MATH_AVX2 in CMake).
+#if !defined(VOLTRAY_SIMD_SCALAR) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define VOLTRAY_SIMD_SSE 1
+#include <immintrin.h>
+#elif !defined(VOLTRAY_SIMD_SCALAR) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define VOLTRAY_SIMD_NEON 1
+#include <arm_neon.h>
+#else
+#ifndef VOLTRAY_SIMD_SCALAR
+#define VOLTRAY_SIMD_SCALAR 1
+#endif
+#include <cmath>
+#endif
+
+namespace Voltray::Math::SIMD
+{
+
+    /**
+     * @brief Four packed floats in the widest register available for the target.
+     *
+     * All kernels are written against the functions below, so porting to another instruction
+     * set only means adding a branch here.
+     */
+#if defined(VOLTRAY_SIMD_SSE)
+    using Float4 = __m128;
+#elif defined(VOLTRAY_SIMD_NEON)
+    using Float4 = float32x4_t;
+#else
+    struct Float4
+    {
+        float v[4];
+    };
+#endif
+
+    /**
+     * @brief Name of the instruction set the kernels were compiled for.
+     */
+    inline const char *GetInstructionSet()
+    {
+#if defined(VOLTRAY_SIMD_SSE) && (defined(__FMA__) || defined(__AVX2__))
+        return "SSE + FMA";
+#elif defined(VOLTRAY_SIMD_SSE)
+        return "SSE2";
+#elif defined(VOLTRAY_SIMD_NEON)
+        return "NEON";
+#else
+        return "Scalar";
+#endif
+    }
+
+#if defined(VOLTRAY_SIMD_SSE)
+
+    inline Float4 Load(const float *p) { return _mm_loadu_ps(p); }
+    inline void Store(float *p, Float4 a) { _mm_storeu_ps(p, a); }
+    inline Float4 LoadAligned(const float *p) { return _mm_load_ps(p); }
+    inline void StoreAligned(float *p, Float4 a) { _mm_store_ps(p, a); }
+    inline Float4 Set(float x, float y, float z, float w) { return _mm_setr_ps(x, y, z, w); }
+    inline Float4 Splat(float s) { return _mm_set1_ps(s); }
+    inline Float4 Zero() { return _mm_setzero_ps(); }
+    inline Float4 Add(Float4 a, Float4 b) { return _mm_add_ps(a, b); }
+    inline Float4 Sub(Float4 a, Float4 b) { return _mm_sub_ps(a, b); }
+    inline Float4 Mul(Float4 a, Float4 b) { return _mm_mul_ps(a, b); }
+    inline Float4 Div(Float4 a, Float4 b) { return _mm_div_ps(a, b); }
+    inline Float4 Min(Float4 a, Float4 b) { return _mm_min_ps(a, b); }
+    inline Float4 Max(Float4 a, Float4 b) { return _mm_max_ps(a, b); }
+    inline Float4 Abs(Float4 a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+    inline float GetX(Float4 a) { return _mm_cvtss_f32(a); }
+
+    /** @brief Rounds to the nearest integer; valid for |a| < 2^31. */
+    inline Float4 Round(Float4 a) { return _mm_cvtepi32_ps(_mm_cvtps_epi32(a)); }
+
+    /** @brief Lane mask, all bits set where a > b. */
+    inline Float4 CmpGreater(Float4 a, Float4 b) { return _mm_cmpgt_ps(a, b); }
+
+    /** @brief Picks a where the mask is set and b elsewhere. */
+    inline Float4 Select(Float4 mask, Float4 a, Float4 b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+
+    /** @brief a * b + c */
+    inline Float4 MulAdd(Float4 a, Float4 b, Float4 c)
+    {
+#if defined(__FMA__) || defined(__AVX2__)
+        return _mm_fmadd_ps(a, b, c);
+#else
+        return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+    }
+
+    /** @brief (a[X], a[Y], b[Z], b[W]) */
+    template <int X, int Y, int Z, int W>
+    inline Float4 Shuffle(Float4 a, Float4 b)
+    {
+        return _mm_shuffle_ps(a, b, _MM_SHUFFLE(W, Z, Y, X));
+    }
+
+#elif defined(VOLTRAY_SIMD_NEON)
+
+    inline Float4 Load(const float *p) { return vld1q_f32(p); }
+    inline void Store(float *p, Float4 a) { vst1q_f32(p, a); }
+    inline Float4 LoadAligned(const float *p) { return vld1q_f32(p); }
+    inline void StoreAligned(float *p, Float4 a) { vst1q_f32(p, a); }
+    inline Float4 Set(float x, float y, float z, float w)
+    {
+        const float values[4] = {x, y, z, w};
+        return vld1q_f32(values);
+    }
+    inline Float4 Splat(float s) { return vdupq_n_f32(s); }
+    inline Float4 Zero() { return vdupq_n_f32(0.0f); }
+    inline Float4 Add(Float4 a, Float4 b) { return vaddq_f32(a, b); }
+    inline Float4 Sub(Float4 a, Float4 b) { return vsubq_f32(a, b); }
+    inline Float4 Mul(Float4 a, Float4 b) { return vmulq_f32(a, b); }
+    inline Float4 Min(Float4 a, Float4 b) { return vminq_f32(a, b); }
+    inline Float4 Max(Float4 a, Float4 b) { return vmaxq_f32(a, b); }
+    inline Float4 Abs(Float4 a) { return vabsq_f32(a); }
+    inline float GetX(Float4 a) { return vgetq_lane_f32(a, 0); }
+
+    /** @brief Rounds to the nearest integer; valid for |a| < 2^31. */
+    inline Float4 Round(Float4 a)
+    {
+#if defined(__aarch64__) || defined(_M_ARM64)
+        return vrndnq_f32(a);
+#else
+        const Float4 half = vbslq_f32(vdupq_n_u32(0x80000000u), a, vdupq_n_f32(0.5f));
+        return vcvtq_f32_s32(vcvtq_s32_f32(vaddq_f32(a, half)));
+#endif
+    }
+
+    /** @brief Lane mask, all bits set where a > b. */
+    inline Float4 CmpGreater(Float4 a, Float4 b) { return vreinterpretq_f32_u32(vcgtq_f32(a, b)); }
+
+    /** @brief Picks a where the mask is set and b elsewhere. */
+    inline Float4 Select(Float4 mask, Float4 a, Float4 b) { return vbslq_f32(vreinterpretq_u32_f32(mask), a, b); }
+
+    inline Float4 Div(Float4 a, Float4 b)
+    {
+#if defined(__aarch64__) || defined(_M_ARM64)
+        return vdivq_f32(a, b);
+#else
+        // Two Newton-Raphson steps on the reciprocal estimate give full single precision
+        Float4 reciprocal = vrecpeq_f32(b);
+        reciprocal = vmulq_f32(vrecpsq_f32(b, reciprocal), reciprocal);
+        reciprocal = vmulq_f32(vrecpsq_f32(b, reciprocal), reciprocal);
+        return vmulq_f32(a, reciprocal);
+#endif
+    }
+
+    /** @brief a * b + c */
+    inline Float4 MulAdd(Float4 a, Float4 b, Float4 c)
+    {
+#if defined(__aarch64__) || defined(_M_ARM64)
+        return vfmaq_f32(c, a, b);
+#else
+        return vmlaq_f32(c, a, b);
+#endif
+    }
+
+    /** @brief (a[X], a[Y], b[Z], b[W]) */
+    template <int X, int Y, int Z, int W>
+    inline Float4 Shuffle(Float4 a, Float4 b)
+    {
+        Float4 result = vdupq_n_f32(vgetq_lane_f32(a, X));
+        result = vsetq_lane_f32(vgetq_lane_f32(a, Y), result, 1);
+        result = vsetq_lane_f32(vgetq_lane_f32(b, Z), result, 2);
+        return vsetq_lane_f32(vgetq_lane_f32(b, W), result, 3);
+    }
+
+#else
+
+    inline Float4 Load(const float *p) { return {{p[0], p[1], p[2], p[3]}}; }
+    inline void Store(float *p, Float4 a)
+    {
+        for (int i = 0; i < 4; ++i)
+            p[i] = a.v[i];
+    }
+    inline Float4 LoadAligned(const float *p) { return Load(p); }
+    inline void StoreAligned(float *p, Float4 a) { Store(p, a); }
+    inline Float4 Set(float x, float y, float z, float w) { return {{x, y, z, w}}; }
+    inline Float4 Splat(float s) { return {{s, s, s, s}}; }
+    inline Float4 Zero() { return Splat(0.0f); }
+    inline Float4 Add(Float4 a, Float4 b) { return {{a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3]}}; }
+    inline Float4 Sub(Float4 a, Float4 b) { return {{a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3]}}; }
+    inline Float4 Mul(Float4 a, Float4 b) { return {{a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3]}}; }
+    inline Float4 Div(Float4 a, Float4 b) { return {{a.v[0] / b.v[0], a.v[1] / b.v[1], a.v[2] / b.v[2], a.v[3] / b.v[3]}}; }
+    inline Float4 Min(Float4 a, Float4 b) { return {{a.v[0] < b.v[0] ? a.v[0] : b.v[0], a.v[1] < b.v[1] ? a.v[1] : b.v[1], a.v[2] < b.v[2] ? a.v[2] : b.v[2], a.v[3] < b.v[3] ? a.v[3] : b.v[3]}}; }
+    inline Float4 Max(Float4 a, Float4 b) { return {{a.v[0] > b.v[0] ? a.v[0] : b.v[0], a.v[1] > b.v[1] ? a.v[1] : b.v[1], a.v[2] > b.v[2] ? a.v[2] : b.v[2], a.v[3] > b.v[3] ? a.v[3] : b.v[3]}}; }
+    inline Float4 Abs(Float4 a) { return {{a.v[0] < 0.0f ? -a.v[0] : a.v[0], a.v[1] < 0.0f ? -a.v[1] : a.v[1], a.v[2] < 0.0f ? -a.v[2] : a.v[2], a.v[3] < 0.0f ? -a.v[3] : a.v[3]}}; }
+    inline float GetX(Float4 a) { return a.v[0]; }
+
+    /** @brief Rounds to the nearest integer; valid for |a| < 2^31. */
+    inline Float4 Round(Float4 a) { return {{std::nearbyint(a.v[0]), std::nearbyint(a.v[1]), std::nearbyint(a.v[2]), std::nearbyint(a.v[3])}}; }
+
+    /** @brief Lane mask, non-zero where a > b. */
+    inline Float4 CmpGreater(Float4 a, Float4 b) { return {{a.v[0] > b.v[0] ? 1.0f : 0.0f, a.v[1] > b.v[1] ? 1.0f : 0.0f, a.v[2] > b.v[2] ? 1.0f : 0.0f, a.v[3] > b.v[3] ? 1.0f : 0.0f}}; }
+
+    /** @brief Picks a where the mask is set and b elsewhere. */
+    inline Float4 Select(Float4 mask, Float4 a, Float4 b) { return {{mask.v[0] != 0.0f ? a.v[0] : b.v[0], mask.v[1] != 0.0f ? a.v[1] : b.v[1], mask.v[2] != 0.0f ? a.v[2] : b.v[2], mask.v[3] != 0.0f ? a.v[3] : b.v[3]}}; }
+
+    /** @brief a * b + c */
+    inline Float4 MulAdd(Float4 a, Float4 b, Float4 c) { return Add(Mul(a, b), c); }
+
+    /** @brief (a[X], a[Y], b[Z], b[W]) */
+    template <int X, int Y, int Z, int W>
+    inline Float4 Shuffle(Float4 a, Float4 b)
+    {
+        return {{a.v[X], a.v[Y], b.v[Z], b.v[W]}};
+    }
+
+#endif
+
+    /** @brief (a[X], a[Y], a[Z], a[W]) */
+    template <int X, int Y, int Z, int W>
+    inline Float4 Swizzle(Float4 a)
+    {
+        return Shuffle<X, Y, Z, W>(a, a);
+    }
+
+    /** @brief Broadcasts lane I to all four lanes. */
+    template <int I>
+    inline Float4 SplatLane(Float4 a)
+    {
+        return Shuffle<I, I, I, I>(a, a);
+    }
+
+    /** @brief (a[0], a[1], a[2], 0), without going through memory. */
+    inline Float4 ClearW(Float4 a)
+    {
+        return Shuffle<0, 1, 0, 2>(a, Shuffle<2, 2, 0, 0>(a, Zero()));
+    }
+
+    /** @brief Cross product of the xyz lanes; w becomes zero for w-free inputs. */
+    inline Float4 Cross3(Float4 a, Float4 b)
+    {
+        return Sub(Mul(Swizzle<1, 2, 0, 3>(a), Swizzle<2, 0, 1, 3>(b)),
+                   Mul(Swizzle<2, 0, 1, 3>(a), Swizzle<1, 2, 0, 3>(b)));
+    }
+
+    /** @brief Dot product of the xyz lanes, broadcast to all lanes. */
+    inline Float4 Dot3(Float4 a, Float4 b)
+    {
+        Float4 product = Mul(a, b);
+        return Add(Add(SplatLane<0>(product), SplatLane<1>(product)), SplatLane<2>(product));
+    }
+
+    /** @brief Transposes four rows into four columns in place. */
+    inline void Transpose(Float4 &r0, Float4 &r1, Float4 &r2, Float4 &r3)
+    {
+        Float4 t0 = Shuffle<0, 1, 0, 1>(r0, r1);
+        Float4 t1 = Shuffle<0, 1, 0, 1>(r2, r3);
+        Float4 t2 = Shuffle<2, 3, 2, 3>(r0, r1);
+        Float4 t3 = Shuffle<2, 3, 2, 3>(r2, r3);
+        r0 = Shuffle<0, 2, 0, 2>(t0, t1);
+        r1 = Shuffle<1, 3, 1, 3>(t0, t1);
+        r2 = Shuffle<0, 2, 0, 2>(t2, t3);
+        r3 = Shuffle<1, 3, 1, 3>(t2, t3);
+    }
+
+    /**
+     * @brief Sine and cosine of four angles in radians.
+     *
+     * Reduces to [-pi, pi], folds into [-pi/2, pi/2] and evaluates minimax polynomials of
+     * degree 11 (sine) and 10 (cosine). Absolute error is below 3e-7 for |angle| < 1000.
+     */
+    inline void SinCos(Float4 angle, Float4 &outSin, Float4 &outCos)
+    {
+        const Float4 pi = Splat(3.141592654f);
+        const Float4 halfPi = Splat(1.570796327f);
+
+        // Wrap into [-pi, pi]; 2*pi is split in two so quotient * high part stays exact
+        const Float4 quotient = Round(Mul(angle, Splat(0.159154943f)));
+        Float4 x = Sub(angle, Mul(quotient, Splat(6.28125f)));
+        x = Sub(x, Mul(quotient, Splat(0.00193530717f)));
+
+        // sin(pi - x) = sin(x) and cos(pi - x) = -cos(x); same for the negative side
+        const Float4 above = CmpGreater(x, halfPi);
+        const Float4 below = CmpGreater(Sub(Zero(), halfPi), x);
+        x = Select(above, Sub(pi, x), x);
+        x = Select(below, Sub(Sub(Zero(), pi), x), x);
+        const Float4 cosSign = Select(above, Splat(-1.0f), Select(below, Splat(-1.0f), Splat(1.0f)));
+
+        const Float4 x2 = Mul(x, x);
+
+        Float4 s = MulAdd(Splat(-2.3889859e-08f), x2, Splat(2.7525562e-06f));
+        s = MulAdd(s, x2, Splat(-0.00019840874f));
+        s = MulAdd(s, x2, Splat(0.0083333310f));
+        s = MulAdd(s, x2, Splat(-0.16666667f));
+        s = MulAdd(s, x2, Splat(1.0f));
+        outSin = Mul(s, x);
+
+        Float4 c = MulAdd(Splat(-2.6051615e-07f), x2, Splat(2.4760495e-05f));
+        c = MulAdd(c, x2, Splat(-0.0013888378f));
+        c = MulAdd(c, x2, Splat(0.041666638f));
+        c = MulAdd(c, x2, Splat(-0.5f));
+        c = MulAdd(c, x2, Splat(1.0f));
+        outCos = Mul(c, cosSign);
+    }
+
+}
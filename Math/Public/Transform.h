@@ -2,6 +2,10 @@
 
 #include "Vec3.h"
 #include "Mat4.h"
+#include "Quat.h"
+#include "TransformStore.h"
+#include <cstdint>
+#include <functional>
 
 namespace Voltray::Math
 {
@@ -11,8 +15,11 @@ namespace Voltray::Math
      * @brief Represents a 3D transformation with position, rotation, and scale.
      *
      * The Transform class encapsulates 3D transformations including translation,
-     * rotation (using Euler angles), and uniform/non-uniform scaling. It provides
-     * methods to compute transformation matrices and manipulate the transform.
+     * rotation (a quaternion with Euler angle accessors), and uniform/non-uniform scaling.
+     * It provides methods to compute transformation matrices and manipulate the transform.
+     *
+     * The state itself lives in a slot of the shared TransformStore; a Transform is the
+     * owning handle to that slot, so copies get their own slot.
      */
     class Transform
     {
@@ -34,15 +41,86 @@ namespace Voltray::Math
                                           */
         Transform(const Vec3 &position, const Vec3 &rotation, const Vec3 &scale);
 
+        /**
+         * @brief Copies the transform state. The changed callback is not copied.
+         * @param other Transform to copy.
+         */
+        Transform(const Transform &other);
+
+        /**
+         * @brief Releases the store slot.
+         */
+        ~Transform();
+
+        /**
+         * @brief Copies the local transform state, keeping this transform's parent and changed callback.
+         * @param other Transform to copy.
+         * @return Reference to this transform.
+         */
+        Transform &operator=(const Transform &other);
+
+        /**
+         * @brief Sets a callback invoked every time the transform is modified.
+         *
+         * Used by owners that cache data derived from the matrix (e.g. world bounds in a
+         * spatial index) to update lazily instead of polling. Only fires for changes to this
+         * transform; owners of a hierarchy propagate changes to descendants themselves.
+         *
+         * @param callback Function to call, or an empty function to remove it.
+         */
+        void SetChangedCallback(std::function<void()> callback) { m_OnChanged = std::move(callback); }
+
+        /**
+         * @brief Gets a counter that increases every time the transform or one of its parents
+         * is modified.
+         * @return The modification counter, usable as a cache key for data derived from GetMatrix.
+         */
+        std::uint64_t GetVersion() const { return TransformStore::GetInstance().GetVersion(m_Index); }
+
+        /**
+         * @brief Gets the slot of this transform in the TransformStore.
+         * @return The store index.
+         */
+        TransformStore::Index GetIndex() const { return m_Index; }
+
+        /**
+         * @brief Parents this transform to another; position, rotation and scale become
+         * relative to the parent.
+         * @param parent New parent, or nullptr to make this a root.
+         * @return False if the parent is this transform or one of its descendants.
+         */
+        bool SetParent(const Transform *parent);
+
+        /**
+         * @brief Sets the local state so that the world matrix becomes the given one.
+         *
+         * Used to keep an object in place when its parent changes. Shear from non-uniformly
+         * scaled parents cannot be represented and is dropped.
+         *
+         * @param worldMatrix Desired local-to-world matrix.
+         */
+        void SetWorldMatrix(const Mat4 &worldMatrix);
+
         // Getters
-        const Vec3 &GetPosition() const { return m_Position; }
-        const Vec3 &GetRotation() const { return m_Rotation; }
-        const Vec3 &GetScale() const { return m_Scale; }
-        const Vec3 &GetPivot() const { return m_Pivot; }
+        Vec3 GetPosition() const { return TransformStore::GetInstance().GetPosition(m_Index); }
+        Vec3 GetRotation() const { return TransformStore::GetInstance().GetRotation(m_Index); }
+        Quat GetOrientation() const { return TransformStore::GetInstance().GetOrientation(m_Index); }
+        Vec3 GetScale() const { return TransformStore::GetInstance().GetScale(m_Index); }
+        Vec3 GetPivot() const { return TransformStore::GetInstance().GetPivot(m_Index); }
 
         // Setters
         void SetPosition(const Vec3 &position);
         void SetRotation(const Vec3 &rotation);
+
+        /**
+         * @brief Sets the rotation from a quaternion.
+         *
+         * Euler setters and getters stay available as a conversion layer; GetRotation returns
+         * angles derived from this quaternion.
+         *
+         * @param orientation Rotation to apply, normalized on assignment.
+         */
+        void SetOrientation(const Quat &orientation);
         void SetScale(const Vec3 &scale);
         void SetScale(float uniformScale);
         void SetPivot(const Vec3 &pivot);
@@ -58,6 +136,12 @@ namespace Voltray::Math
         // Transformation operations
         void Translate(const Vec3 &translation);
         void Rotate(const Vec3 &rotation);
+
+        /**
+         * @brief Applies a rotation on top of the current orientation.
+         * @param rotation Rotation applied after the current one.
+         */
+        void Rotate(const Quat &rotation);
         void Scale(const Vec3 &scale);
         void Scale(float uniformScale);
 
@@ -105,11 +189,23 @@ namespace Voltray::Math
         Vec3 GetLocalForward() const;
 
         /**
-         * @brief Gets the transformation matrix.
+         * @brief Gets the local-to-world transformation matrix, including all parents.
          * @return The 4x4 transformation matrix (Translation * Rotation * Scale).
          */
         Mat4 GetMatrix() const;
 
+        /**
+         * @brief Gets the transformation matrix relative to the parent.
+         * @return The 4x4 local transformation matrix.
+         */
+        Mat4 GetLocalMatrix() const;
+
+        /**
+         * @brief Gets the origin of the transform in world space.
+         * @return The translation part of the world matrix.
+         */
+        Vec3 GetWorldPosition() const;
+
         /**
          * @brief Gets the inverse transformation matrix.
          * @return The inverse transformation matrix.
@@ -122,16 +218,15 @@ namespace Voltray::Math
         void Reset();
 
     private:
-        Vec3 m_Position{0.0f, 0.0f, 0.0f};
-        Vec3 m_Rotation{0.0f, 0.0f, 0.0f}; // Euler angles in degrees
-        Vec3 m_Scale{1.0f, 1.0f, 1.0f};
-        Vec3 m_Pivot{0.0f, 0.0f, 0.0f};      // Relative pivot offset from mesh center
+        TransformStore::Index m_Index;       // Position, rotation (degrees), scale and pivot
         Vec3 m_MeshCenter{0.0f, 0.0f, 0.0f}; // Center of the mesh
+        std::function<void()> m_OnChanged;
 
-        mutable Mat4 m_CachedMatrix;
-        mutable bool m_MatrixDirty = true;
-        void InvalidateMatrix() const { m_MatrixDirty = true; }
-        void UpdateMatrix() const;
+        void NotifyChanged()
+        {
+            if (m_OnChanged)
+                m_OnChanged();
+        }
     };
 
 }
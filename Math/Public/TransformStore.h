@@ -0,0 +1,255 @@
+#pragma once
+
+#include "Vec3.h"
+#include "Mat4.h"
+#include "Quat.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace Voltray::Math
+{
+
+    /**
+     * @class TransformStore
+     * @brief Structure-of-arrays storage for transform state and world matrices.
+     *
+     * Every Transform owns one slot in the store. Position, orientation, scale and pivot live in
+     * separate float arrays, so UpdateMatrices can rebuild all dirty matrices four at a time
+     * with SIMD and split the work across threads. Rotation is stored as a quaternion, so
+     * building matrices and local axes needs no trigonometry; Euler angles are converted
+     * once when set.
+     *
+     * Slots can be parented to each other. Local matrices are indexed by slot; world matrices
+     * are kept in depth-first order so every subtree is one contiguous range, parents come
+     * before their children, and the world pass only walks the subtrees below modified slots.
+     * Matrices read before the batch pass runs are computed on demand from the parent chain.
+     *
+     * Slots are recycled through a free list; indices stay valid until released.
+     */
+    class TransformStore
+    {
+    public:
+        using Index = std::uint32_t;
+        static constexpr Index INVALID_INDEX = 0xFFFFFFFFu;
+
+        /**
+         * @brief Runs body(i) for every i in [0, count) and returns when all calls finished,
+         * e.g. Utils::ThreadPool::ParallelFor. Lets the math module use the engine's workers
+         * without depending on them.
+         */
+        using ParallelFor = std::function<void(std::size_t count, const std::function<void(std::size_t)> &body)>;
+
+        /**
+         * @brief Gets the store shared by all transforms.
+         * @return Reference to the store instance.
+         */
+        static TransformStore &GetInstance();
+
+        /**
+         * @brief Allocates a slot initialised to the identity transform.
+         * @return Index of the new slot.
+         */
+        Index Allocate();
+
+        /**
+         * @brief Returns a slot to the free list. Its children become roots.
+         * @param index Slot to release.
+         */
+        void Release(Index index);
+
+        /**
+         * @brief Copies the local transform state of one slot into another; the parent is not copied.
+         * @param destination Slot to overwrite.
+         * @param source Slot to copy from.
+         */
+        void Copy(Index destination, Index source);
+
+        Vec3 GetPosition(Index index) const { return m_Position.Get(index); }
+        Vec3 GetRotation(Index index) const;
+        Quat GetOrientation(Index index) const { return m_Orientation.Get(index); }
+        Vec3 GetScale(Index index) const { return m_Scale.Get(index); }
+        Vec3 GetPivot(Index index) const { return m_Pivot.Get(index); }
+
+        void SetPosition(Index index, const Vec3 &position);
+
+        /**
+         * @brief Sets the rotation from Euler angles in degrees.
+         *
+         * The angles are kept as given so editors show what was typed, and converted to the
+         * stored quaternion.
+         */
+        void SetRotation(Index index, const Vec3 &rotation);
+
+        /**
+         * @brief Sets the rotation from a quaternion; Euler angles are derived when next read.
+         */
+        void SetOrientation(Index index, const Quat &orientation);
+
+        void SetScale(Index index, const Vec3 &scale);
+        void SetPivot(Index index, const Vec3 &pivot);
+
+        /**
+         * @brief Parents a slot to another one; its state becomes relative to the parent.
+         * @param index Slot to move.
+         * @param parent New parent, or INVALID_INDEX to make the slot a root.
+         * @return False if the parent is the slot itself or one of its descendants.
+         */
+        bool SetParent(Index index, Index parent);
+
+        /**
+         * @brief Gets the parent of a slot.
+         * @return The parent slot, or INVALID_INDEX for roots.
+         */
+        Index GetParent(Index index) const { return m_Parent[index]; }
+
+        /**
+         * @brief Gets the local-to-world matrix of a slot.
+         *
+         * Returns the cached matrix when neither the slot nor its ancestors changed since the
+         * last UpdateMatrices, otherwise computes it from the parent chain without caching.
+         *
+         * @param index Slot to read.
+         * @return The transformation matrix.
+         */
+        Mat4 GetMatrix(Index index) const;
+
+        /**
+         * @brief Gets the local-to-parent matrix of a slot.
+         * @param index Slot to read.
+         * @return The transformation matrix relative to the parent.
+         */
+        Mat4 GetLocalMatrix(Index index) const;
+
+        /**
+         * @brief Gets a counter that increases every time the slot or one of its ancestors is
+         * modified or reparented.
+         * @param index Slot to read.
+         * @return The modification counter of the world matrix.
+         */
+        std::uint64_t GetVersion(Index index) const;
+
+        /**
+         * @brief Rebuilds the matrices of all slots modified since the last call.
+         *
+         * Runs once per frame after animation and gameplay updates. Local matrices of modified
+         * slots are rebuilt first, then world matrices top-down over the subtrees below them.
+         * Large local batches are split into tasks run through parallelFor; small batches, or
+         * all batches without parallelFor, stay on the calling thread.
+         *
+         * @param parallelFor Runs the local matrix tasks, typically on the engine thread pool.
+         * @return Number of matrices rebuilt.
+         */
+        std::size_t UpdateMatrices(const ParallelFor &parallelFor = nullptr);
+
+        /**
+         * @brief Gets the number of slots in use.
+         * @return Number of live transforms.
+         */
+        std::size_t GetCount() const { return m_Versions.size() - m_FreeList.size(); }
+
+    private:
+        /**
+         * @brief One float array per component.
+         */
+        struct Vec3Array
+        {
+            std::vector<float> x, y, z;
+
+            Vec3 Get(Index index) const { return Vec3(x[index], y[index], z[index]); }
+            void Set(Index index, const Vec3 &value)
+            {
+                x[index] = value.x;
+                y[index] = value.y;
+                z[index] = value.z;
+            }
+            void PushBack(const Vec3 &value)
+            {
+                x.push_back(value.x);
+                y.push_back(value.y);
+                z.push_back(value.z);
+            }
+        };
+
+        /**
+         * @brief One float array per quaternion component.
+         */
+        struct QuatArray
+        {
+            std::vector<float> x, y, z, w;
+
+            Quat Get(Index index) const { return Quat(x[index], y[index], z[index], w[index]); }
+            void Set(Index index, const Quat &value)
+            {
+                x[index] = value.x;
+                y[index] = value.y;
+                z[index] = value.z;
+                w[index] = value.w;
+            }
+            void PushBack(const Quat &value)
+            {
+                x.push_back(value.x);
+                y.push_back(value.y);
+                z.push_back(value.z);
+                w.push_back(value.w);
+            }
+        };
+
+        /**
+         * @brief Flags a slot for the next batch update and bumps its version.
+         */
+        void MarkDirty(Index index);
+
+        /**
+         * @brief Builds one local matrix with scalar math.
+         */
+        void BuildMatrix(Index index, Mat4 &result) const;
+
+        /**
+         * @brief Builds the local matrices of a range of dirty slots, four per iteration.
+         */
+        void BuildMatrices(const Index *indices, std::size_t count);
+
+        /**
+         * @brief Removes a slot from its parent's child list.
+         */
+        void Unlink(Index index);
+
+        /**
+         * @brief Recomputes the depth-first order after slots were added, removed or reparented.
+         */
+        void RebuildOrder();
+
+        Vec3Array m_Position;
+        QuatArray m_Orientation;
+        Vec3Array m_Scale;
+        Vec3Array m_Pivot;
+        mutable Vec3Array m_EulerAngles; ///< Degrees, as last set or derived from the orientation
+        mutable std::vector<std::uint8_t> m_EulerStale;
+
+        std::vector<Mat4> m_LocalMatrices;
+        std::vector<std::uint8_t> m_Dirty;
+        std::vector<std::uint8_t> m_Alive;
+        std::vector<std::uint64_t> m_Versions; ///< Stamp of the last change to the slot
+        std::uint64_t m_VersionCounter = 0;
+
+        // Hierarchy links, indexed by slot; children form a singly linked list
+        std::vector<Index> m_Parent;
+        std::vector<Index> m_FirstChild;
+        std::vector<Index> m_NextSibling;
+        std::vector<Index> m_OrderPosition; ///< Position in the depth-first order, INVALID_INDEX until placed
+
+        // Depth-first order, indexed by position
+        std::vector<Index> m_Order;
+        std::vector<Index> m_OrderParent; ///< Position of the parent, INVALID_INDEX for roots
+        std::vector<Index> m_SubtreeSize;
+        std::vector<Mat4> m_WorldMatrices;
+        bool m_OrderDirty = false;
+
+        std::vector<Index> m_DirtyList;
+        std::vector<Index> m_FreeList;
+        std::vector<Index> m_DirtyPositions;
+    };
+
+}
@@ -1,74 +1,137 @@
 #pragma once
 
+#include <cmath>
+
 namespace Voltray::Math
 {
 
     // Represents a 3-dimensional vector with float components and provides common vector operations.
+    // Header-only and constexpr where possible so hot loops inline every operation.
     struct Vec3
     {
         float x, y, z; ///< The x, y, and z components of the vector.
 
         /// Default constructor. Initializes all components to zero.
-        Vec3();
+        constexpr Vec3() : x(0), y(0), z(0) {}
 
         /// Constructs a vector with the same value for all components.
         /// @param value The value to set for all components.
-        explicit Vec3(float value);
+        constexpr explicit Vec3(float value) : x(value), y(value), z(value) {}
 
         /// Constructs a vector with the given x, y, and z components.
         /// @param x The x component.
         /// @param y The y component.
         /// @param z The z component.
-        Vec3(float x, float y, float z);
+        constexpr Vec3(float x, float y, float z) : x(x), y(y), z(z) {}
 
         /// Adds this vector to another vector.
         /// @param other The vector to add.
         /// @return The result of vector addition.
-        Vec3 operator+(const Vec3 &other) const;
+        constexpr Vec3 operator+(const Vec3 &other) const
+        {
+            return Vec3(x + other.x, y + other.y, z + other.z);
+        }
 
         /// Subtracts another vector from this vector.
         /// @param other The vector to subtract.
         /// @return The result of vector subtraction.
-        Vec3 operator-(const Vec3 &other) const;
+        constexpr Vec3 operator-(const Vec3 &other) const
+        {
+            return Vec3(x - other.x, y - other.y, z - other.z);
+        }
 
         /// Multiplies this vector by a scalar.
         /// @param scalar The scalar value to multiply by.
         /// @return The result of scalar multiplication.
-        Vec3 operator*(float scalar) const;
+        constexpr Vec3 operator*(float scalar) const
+        {
+            return Vec3(x * scalar, y * scalar, z * scalar);
+        }
 
         /// Divides this vector by a scalar.
         /// @param scalar The scalar value to divide by.
         /// @return The result of scalar division.
-        Vec3 operator/(float scalar) const;
+        constexpr Vec3 operator/(float scalar) const
+        {
+            return Vec3(x / scalar, y / scalar, z / scalar);
+        }
 
         /// Negates the vector (flips the sign of all components).
         /// @return The negated vector.
-        Vec3 operator-() const;
+        constexpr Vec3 operator-() const
+        {
+            return Vec3(-x, -y, -z);
+        }
+
+        /// Calculates the squared length of the vector, avoiding the square root.
+        /// @return The squared length of the vector.
+        constexpr float LengthSquared() const
+        {
+            return x * x + y * y + z * z;
+        }
 
         /// Calculates the length (magnitude) of the vector.
         /// @return The length of the vector.
-        float Length() const;
+        float Length() const
+        {
+            return std::sqrt(LengthSquared());
+        }
 
         /// Returns a normalized (unit length) version of this vector.
         /// @return The normalized vector.
-        Vec3 Normalize() const;
+        Vec3 Normalize() const
+        {
+            float len = Length();
+            if (len == 0.0f)
+                return *this;
+            return *this / len;
+        }
 
         /// Computes the dot product of this vector and another vector.
         /// @param other The other vector.
         /// @return The dot product.
-        float Dot(const Vec3 &other) const;
+        constexpr float Dot(const Vec3 &other) const
+        {
+            return x * other.x + y * other.y + z * other.z;
+        }
 
         /// Computes the cross product of this vector and another vector.
         /// @param other The other vector.
         /// @return The cross product vector.
-        Vec3 Cross(const Vec3 &other) const;
+        constexpr Vec3 Cross(const Vec3 &other) const
+        {
+            return Vec3(
+                y * other.z - z * other.y,
+                z * other.x - x * other.z,
+                x * other.y - y * other.x);
+        }
 
         /// Compound addition assignment.
-        Vec3 &operator+=(const Vec3 &other);
+        constexpr Vec3 &operator+=(const Vec3 &other)
+        {
+            x += other.x;
+            y += other.y;
+            z += other.z;
+            return *this;
+        }
+
         /// Compound subtraction assignment.
-        Vec3 &operator-=(const Vec3 &other);
+        constexpr Vec3 &operator-=(const Vec3 &other)
+        {
+            x -= other.x;
+            y -= other.y;
+            z -= other.z;
+            return *this;
+        }
+
         /// Compound multiplication assignment.
-        Vec3 &operator*=(float scalar);
+        constexpr Vec3 &operator*=(float scalar)
+        {
+            x *= scalar;
+            y *= scalar;
+            z *= scalar;
+            return *this;
+        }
     };
 
 }
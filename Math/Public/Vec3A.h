@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Vec3.h"
+#include "SIMD.h"
+
+namespace Voltray::Math
+{
+
+    /**
+     * @struct Vec3A
+     * @brief 16-byte aligned three-component vector for SIMD-friendly storage.
+     *
+     * Padded with a fourth lane so it loads into one register with an aligned load. The pad is
+     * kept at zero by all operations, so Dot and Length can treat it as a 4-lane vector.
+     * Use Vec3 for packed storage (vertex data, GPU structs) and convert at the boundary.
+     */
+    struct alignas(16) Vec3A
+    {
+        float x, y, z; ///< The x, y, and z components of the vector.
+        float pad;     ///< Unused lane, always zero.
+
+        constexpr Vec3A() : x(0), y(0), z(0), pad(0) {}
+        constexpr Vec3A(float x, float y, float z) : x(x), y(y), z(z), pad(0) {}
+        constexpr explicit Vec3A(const Vec3 &v) : x(v.x), y(v.y), z(v.z), pad(0) {}
+
+        /// Converts back to the packed representation.
+        constexpr Vec3 ToVec3() const { return Vec3(x, y, z); }
+
+        /// Loads the vector into a SIMD register.
+        SIMD::Float4 Load() const { return SIMD::LoadAligned(&x); }
+
+        /// Creates a vector from a SIMD register; the fourth lane is cleared.
+        static Vec3A FromSIMD(SIMD::Float4 value)
+        {
+            // Cleared in the register: a separate store to pad would stall the next full-width load
+            Vec3A result;
+            SIMD::StoreAligned(&result.x, SIMD::ClearW(value));
+            return result;
+        }
+
+        Vec3A operator+(const Vec3A &other) const { return FromZeroW(SIMD::Add(Load(), other.Load())); }
+        Vec3A operator-(const Vec3A &other) const { return FromZeroW(SIMD::Sub(Load(), other.Load())); }
+        Vec3A operator*(float scalar) const { return FromSIMD(SIMD::Mul(Load(), SIMD::Splat(scalar))); }
+
+        float Dot(const Vec3A &other) const { return SIMD::GetX(SIMD::Dot3(Load(), other.Load())); }
+        Vec3A Cross(const Vec3A &other) const { return FromZeroW(SIMD::Cross3(Load(), other.Load())); }
+        float Length() const { return std::sqrt(Dot(*this)); }
+
+        /// Component-wise minimum and maximum, e.g. for growing bounding boxes.
+        static Vec3A Min(const Vec3A &a, const Vec3A &b) { return FromZeroW(SIMD::Min(a.Load(), b.Load())); }
+        static Vec3A Max(const Vec3A &a, const Vec3A &b) { return FromZeroW(SIMD::Max(a.Load(), b.Load())); }
+
+    private:
+        /// Creates a vector from a register whose fourth lane is already zero, such as the result
+        /// of adding, subtracting, comparing or crossing two Vec3A.
+        static Vec3A FromZeroW(SIMD::Float4 value)
+        {
+            Vec3A result;
+            SIMD::StoreAligned(&result.x, value);
+            return result;
+        }
+    };
+
+    static_assert(sizeof(Vec3A) == 16 && alignof(Vec3A) == 16, "Vec3A must fill exactly one SIMD register");
+
+}
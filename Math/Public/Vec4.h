@@ -2,6 +2,8 @@
 
 #include "Vec3.h"
 #include "Vec2.h"
+#include <cmath>
+#include <stdexcept>
 
 namespace Voltray::Math
 {
@@ -12,65 +14,189 @@ namespace Voltray::Math
         float x, y, z, w;
 
         // Constructors
-        Vec4();
-        Vec4(float x, float y, float z, float w);
-        Vec4(const Vec4 &other);
+        constexpr Vec4() : x(0.0f), y(0.0f), z(0.0f), w(0.0f) {}
+        constexpr Vec4(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
+        constexpr Vec4(const Vec4 &other) = default;
 
         // Assignment operator
-        Vec4 &operator=(const Vec4 &other);
+        constexpr Vec4 &operator=(const Vec4 &other) = default;
 
         // Arithmetic operators
-        Vec4 operator+(const Vec4 &other) const;
-        Vec4 operator-(const Vec4 &other) const;
-        Vec4 operator*(float scalar) const;
-        Vec4 operator/(float scalar) const;
+        constexpr Vec4 operator+(const Vec4 &other) const
+        {
+            return Vec4(x + other.x, y + other.y, z + other.z, w + other.w);
+        }
+
+        constexpr Vec4 operator-(const Vec4 &other) const
+        {
+            return Vec4(x - other.x, y - other.y, z - other.z, w - other.w);
+        }
+
+        constexpr Vec4 operator*(float scalar) const
+        {
+            return Vec4(x * scalar, y * scalar, z * scalar, w * scalar);
+        }
+
+        constexpr Vec4 operator/(float scalar) const
+        {
+            if (scalar == 0.0f)
+            {
+                throw std::runtime_error("Division by zero in Vec4");
+            }
+            return Vec4(x / scalar, y / scalar, z / scalar, w / scalar);
+        }
 
         // Compound assignment operators
-        Vec4 &operator+=(const Vec4 &other);
-        Vec4 &operator-=(const Vec4 &other);
-        Vec4 &operator*=(float scalar);
-        Vec4 &operator/=(float scalar);
+        constexpr Vec4 &operator+=(const Vec4 &other)
+        {
+            x += other.x;
+            y += other.y;
+            z += other.z;
+            w += other.w;
+            return *this;
+        }
+
+        constexpr Vec4 &operator-=(const Vec4 &other)
+        {
+            x -= other.x;
+            y -= other.y;
+            z -= other.z;
+            w -= other.w;
+            return *this;
+        }
+
+        constexpr Vec4 &operator*=(float scalar)
+        {
+            x *= scalar;
+            y *= scalar;
+            z *= scalar;
+            w *= scalar;
+            return *this;
+        }
+
+        constexpr Vec4 &operator/=(float scalar)
+        {
+            if (scalar == 0.0f)
+            {
+                throw std::runtime_error("Division by zero in Vec4");
+            }
+            x /= scalar;
+            y /= scalar;
+            z /= scalar;
+            w /= scalar;
+            return *this;
+        }
 
         // Comparison operators
-        bool operator==(const Vec4 &other) const;
-        bool operator!=(const Vec4 &other) const;
+        bool operator==(const Vec4 &other) const
+        {
+            const float epsilon = 1e-6f;
+            return std::abs(x - other.x) < epsilon &&
+                   std::abs(y - other.y) < epsilon &&
+                   std::abs(z - other.z) < epsilon &&
+                   std::abs(w - other.w) < epsilon;
+        }
+
+        bool operator!=(const Vec4 &other) const
+        {
+            return !(*this == other);
+        }
 
         // Utility functions
-        float length() const;
-        float lengthSquared() const;
-        Vec4 normalized() const;
-        void normalize();
-        float dot(const Vec4 &other) const;
+        float length() const
+        {
+            return std::sqrt(lengthSquared());
+        }
+
+        constexpr float lengthSquared() const
+        {
+            return x * x + y * y + z * z + w * w;
+        }
+
+        Vec4 normalized() const
+        {
+            float len = length();
+            if (len == 0.0f)
+            {
+                return Vec4(0.0f, 0.0f, 0.0f, 0.0f);
+            }
+            return *this / len;
+        }
+
+        void normalize()
+        {
+            float len = length();
+            if (len != 0.0f)
+            {
+                *this /= len;
+            }
+        }
+
+        constexpr float dot(const Vec4 &other) const
+        {
+            return x * other.x + y * other.y + z * other.z + w * other.w;
+        }
 
         // Array access
-        float &operator[](int index);
-        const float &operator[](int index) const;
+        constexpr float &operator[](int index)
+        {
+            switch (index)
+            {
+            case 0:
+                return x;
+            case 1:
+                return y;
+            case 2:
+                return z;
+            case 3:
+                return w;
+            default:
+                throw std::out_of_range("Vec4 index out of range");
+            }
+        }
+
+        constexpr const float &operator[](int index) const
+        {
+            switch (index)
+            {
+            case 0:
+                return x;
+            case 1:
+                return y;
+            case 2:
+                return z;
+            case 3:
+                return w;
+            default:
+                throw std::out_of_range("Vec4 index out of range");
+            }
+        }
 
         // multiple swizzle accessors
-        const float &r() const { return x; }
-        const float &g() const { return y; }
-        const float &b() const { return z; }
-        const float &a() const { return w; }
+        constexpr const float &r() const { return x; }
+        constexpr const float &g() const { return y; }
+        constexpr const float &b() const { return z; }
+        constexpr const float &a() const { return w; }
 
-        Vec4 wzyx() const
+        constexpr Vec4 wzyx() const
         {
             return Vec4(w, z, y, x);
         }
 
-        Vec3 xyz() const
+        constexpr Vec3 xyz() const
         {
             return Vec3(x, y, z);
         }
 
-        Vec2 xy() const
+        constexpr Vec2 xy() const
         {
             return Vec2(x, y);
         }
 
         // Static utility functions
-        static Vec4 Zero() { return Vec4(0.0f, 0.0f, 0.0f, 0.0f); }
-        static Vec4 One() { return Vec4(1.0f, 1.0f, 1.0f, 1.0f); }
-        static Vec4 FromColor(float r, float g, float b, float a)
+        static constexpr Vec4 Zero() { return Vec4(0.0f, 0.0f, 0.0f, 0.0f); }
+        static constexpr Vec4 One() { return Vec4(1.0f, 1.0f, 1.0f, 1.0f); }
+        static constexpr Vec4 FromColor(float r, float g, float b, float a)
         {
             return Vec4(r, g, b, a);
         }
@@ -1,10 +1,9 @@
-#version 460 core
+#version 450 core
 
 in vec3 v_Normal;
 in vec2 v_TexCoord;
 in vec3 v_WorldPos;
-
-uniform vec3 u_MaterialColor;
+flat in vec3 v_MaterialColor;
 
 out vec4 FragColor;
 
@@ -15,7 +14,7 @@ void main() {
     float diff = max(dot(normal, lightDir), 0.0);
 
     // Use material color with simple diffuse lighting
-    vec3 color = u_MaterialColor * (0.3 + 0.7 * diff); // ambient + diffuse
+    vec3 color = v_MaterialColor * (0.3 + 0.7 * diff); // ambient + diffuse
 
     FragColor = vec4(color, 1.0);
 }
\ No newline at end of file
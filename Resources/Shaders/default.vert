@@ -1,21 +1,54 @@
-#version 460 core
+#version 450 core
+#extension GL_ARB_shader_draw_parameters : require
 
 layout(location = 0) in vec3 aPos;
 layout(location = 1) in vec3 aNormal;
 layout(location = 2) in vec2 aTexCoord;
 
-uniform mat4 u_Model;
-uniform mat4 u_ViewProjection;
+// Per-frame camera data, see FrameData
+layout(std140) uniform FrameData {
+    mat4 u_ViewProjection;
+    mat4 u_InverseViewProjection;
+    vec4 u_CameraPosition;
+};
+
+// Per-object data, see ObjectData. Each draw's base instance is the index of its first object.
+struct Object {
+    mat4 model;
+    vec4 materialColor;
+    vec4 positionScale;  // xyz: position decode scale, w: 1 for octahedral normals
+    vec4 positionOffset; // xyz: position decode offset
+};
+
+layout(std430) readonly buffer ObjectData {
+    Object u_Objects[];
+};
 
 out vec3 v_Normal;
 out vec2 v_TexCoord;
 out vec3 v_WorldPos;
+flat out vec3 v_MaterialColor;
+
+// Unfolds a normal stored with VertexFormat::Octahedral16
+vec3 DecodeOctahedral(vec2 folded) {
+    vec3 normal = vec3(folded, 1.0 - abs(folded.x) - abs(folded.y));
+    float t = max(-normal.z, 0.0);
+    normal.xy += vec2(normal.x >= 0.0 ? -t : t, normal.y >= 0.0 ? -t : t);
+    return normalize(normal);
+}
 
 void main() {
-    vec4 worldPos = u_Model * vec4(aPos, 1.0);
+    Object object = u_Objects[gl_BaseInstanceARB + gl_InstanceID];
+
+    // Float meshes have a scale of one and no offset; quantized ones are mapped back to their bounds
+    vec3 position = object.positionOffset.xyz + aPos * object.positionScale.xyz;
+    vec3 normal = object.positionScale.w > 0.5 ? DecodeOctahedral(aNormal.xy) : aNormal;
+
+    vec4 worldPos = object.model * vec4(position, 1.0);
     v_WorldPos = worldPos.xyz;
-    v_Normal = mat3(u_Model) * aNormal; // Simple normal transformation (not correct for non-uniform scaling)
+    v_Normal = mat3(object.model) * normal; // Simple normal transformation (not correct for non-uniform scaling)
     v_TexCoord = aTexCoord;
+    v_MaterialColor = object.materialColor.rgb;
 
     gl_Position = u_ViewProjection * worldPos;
 }
@@ -1,9 +1,15 @@
-#version 460 core
+#version 450 core
 
 layout(location = 0) in vec3 aPos;
 
 uniform mat4 u_Model;
-uniform mat4 u_ViewProjection;
+
+// Per-frame camera data, see FrameData
+layout(std140) uniform FrameData {
+    mat4 u_ViewProjection;
+    mat4 u_InverseViewProjection;
+    vec4 u_CameraPosition;
+};
 
 void main() {
     // Simple vertex transformation for wireframe outline
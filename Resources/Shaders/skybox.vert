@@ -1,4 +1,4 @@
-#version 460 core
+#version 450 core
 // Fullscreen triangle (no vertex buffer needed)
 const vec2 verts[3] = vec2[3](
     vec2(-1.0, -1.0),
@@ -8,7 +8,12 @@ const vec2 verts[3] = vec2[3](
 
 out vec3 vWorldDir;
 
-uniform mat4 u_InverseViewProj;
+// Per-frame camera data, see FrameData
+layout(std140) uniform FrameData {
+    mat4 u_ViewProjection;
+    mat4 u_InverseViewProjection;
+    vec4 u_CameraPosition;
+};
 
 void main() {
     gl_Position = vec4(verts[gl_VertexID], 0.0, 1.0);
@@ -16,6 +21,6 @@ void main() {
     vec2 ndc = verts[gl_VertexID];
     vec4 clip = vec4(ndc, 1.0, 1.0);
     // Unproject to world space
-    vec4 world = u_InverseViewProj * clip;
+    vec4 world = u_InverseViewProjection * clip;
     vWorldDir = normalize(world.xyz / world.w);
 }
\ No newline at end of file
@@ -0,0 +1,98 @@
+#include "ObjLoader.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <string>
+
+using namespace Voltray::Engine;
+
+namespace
+{
+    int s_Failures = 0;
+
+    void Check(bool condition, const char *description)
+    {
+        if (!condition)
+        {
+            std::fprintf(stderr, "FAILED: %s\n", description);
+            ++s_Failures;
+        }
+    }
+
+    // Comment lines, so padding moves faces into later parse chunks without adding geometry
+    void WritePadding(std::ofstream &file, std::size_t bytes)
+    {
+        const std::string line = "# " + std::string(97, '-') + "\n";
+        for (std::size_t written = 0; written < bytes; written += line.size())
+            file << line;
+    }
+
+    std::map<std::string, std::size_t> CountTriangles(const std::vector<MeshData> &meshes)
+    {
+        std::map<std::string, std::size_t> triangles;
+        for (const MeshData &mesh : meshes)
+            triangles[mesh.materialName] += mesh.indices.size() / 3;
+        return triangles;
+    }
+
+    /**
+     * @brief Faces of later chunks without their own usemtl continue the material active at
+     * the end of the previous chunk, not the one it used first or last introduced.
+     */
+    void TestMaterialContinuesAcrossChunks(const std::filesystem::path &path)
+    {
+        {
+            std::ofstream file(path, std::ios::binary);
+            file << "v 0 0 0\nv 1 0 0\nv 0 1 0\n";
+            WritePadding(file, 1300000);
+            file << "usemtl red\nf 1 2 3\nusemtl blue\nf 1 2 3\nusemtl red\nf 1 2 3\n";
+            WritePadding(file, 2900000);
+            for (int i = 0; i < 5; ++i)
+                file << "f 1 2 3\n";
+            WritePadding(file, 2900000);
+            file << "usemtl blue\n";
+            WritePadding(file, 2900000);
+            file << "f 1 2 3\n";
+        }
+
+        ObjLoader loader;
+        const std::map<std::string, std::size_t> triangles = CountTriangles(loader.LoadMeshData(path.string()));
+        Check(triangles.size() == 2, "multi-chunk OBJ yields one mesh per material");
+        Check(triangles.count("red") && triangles.at("red") == 7, "faces after red/blue/red continue red");
+        Check(triangles.count("blue") && triangles.at("blue") == 2, "a usemtl without faces switches the material for the next chunk");
+    }
+
+    void TestMaterialWithinChunk(const std::filesystem::path &path)
+    {
+        std::ofstream(path, std::ios::binary) << "v 0 0 0\nv 1 0 0\nv 0 1 0\nv 1 1 0\n"
+                                                 "f 1 2 3\nusemtl red\nf 2 4 3\nf 1 2 4 3\nusemtl blue\nf -4 -3 -2\n";
+
+        ObjLoader loader;
+        const std::map<std::string, std::size_t> triangles = CountTriangles(loader.LoadMeshData(path.string()));
+        Check(triangles.count("") && triangles.at("") == 1, "faces before the first usemtl use the default material");
+        Check(triangles.count("red") && triangles.at("red") == 3, "quads are fan-triangulated");
+        Check(triangles.count("blue") && triangles.at("blue") == 1, "negative indices resolve");
+    }
+}
+
+int main()
+{
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "voltray_obj_loader_test.obj";
+    try
+    {
+        TestMaterialWithinChunk(path);
+        TestMaterialContinuesAcrossChunks(path);
+    }
+    catch (const std::exception &e)
+    {
+        std::fprintf(stderr, "FAILED: unexpected exception: %s\n", e.what());
+        ++s_Failures;
+    }
+
+    std::error_code error;
+    std::filesystem::remove(path, error);
+    if (s_Failures == 0)
+        std::printf("All ObjLoader tests passed\n");
+    return s_Failures == 0 ? 0 : 1;
+}
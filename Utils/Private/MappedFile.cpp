@@ -0,0 +1,141 @@
+#include "MappedFile.h"
+#include <utility>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Voltray::Utils
+{
+
+    MappedFile::~MappedFile()
+    {
+        Close();
+    }
+
+    MappedFile::MappedFile(MappedFile &&other) noexcept
+    {
+        *this = std::move(other);
+    }
+
+    MappedFile &MappedFile::operator=(MappedFile &&other) noexcept
+    {
+        if (this != &other)
+        {
+            Close();
+            m_Data = std::exchange(other.m_Data, nullptr);
+            m_Size = std::exchange(other.m_Size, 0);
+            m_Open = std::exchange(other.m_Open, false);
+#ifdef _WIN32
+            m_FileHandle = std::exchange(other.m_FileHandle, nullptr);
+            m_MappingHandle = std::exchange(other.m_MappingHandle, nullptr);
+#endif
+        }
+        return *this;
+    }
+
+#ifdef _WIN32
+    bool MappedFile::Open(const std::filesystem::path &path)
+    {
+        Close();
+
+        HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size))
+        {
+            CloseHandle(file);
+            return false;
+        }
+
+        // Zero-length files cannot be mapped
+        if (size.QuadPart > 0)
+        {
+            HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            const void *view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+            if (!view)
+            {
+                if (mapping)
+                    CloseHandle(mapping);
+                CloseHandle(file);
+                return false;
+            }
+            m_MappingHandle = mapping;
+            m_Data = static_cast<const unsigned char *>(view);
+            m_Size = static_cast<std::size_t>(size.QuadPart);
+        }
+
+        m_FileHandle = file;
+        m_Open = true;
+        return true;
+    }
+
+    void MappedFile::Close()
+    {
+        if (m_Data)
+            UnmapViewOfFile(m_Data);
+        if (m_MappingHandle)
+            CloseHandle(m_MappingHandle);
+        if (m_FileHandle)
+            CloseHandle(m_FileHandle);
+        m_Data = nullptr;
+        m_Size = 0;
+        m_Open = false;
+        m_FileHandle = nullptr;
+        m_MappingHandle = nullptr;
+    }
+#else
+    bool MappedFile::Open(const std::filesystem::path &path)
+    {
+        Close();
+
+        const int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return false;
+
+        struct stat info;
+        if (fstat(fd, &info) != 0)
+        {
+            close(fd);
+            return false;
+        }
+
+        // Zero-length files cannot be mapped
+        if (info.st_size > 0)
+        {
+            void *view = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (view == MAP_FAILED)
+            {
+                close(fd);
+                return false;
+            }
+            madvise(view, static_cast<std::size_t>(info.st_size), MADV_SEQUENTIAL);
+            m_Data = static_cast<const unsigned char *>(view);
+            m_Size = static_cast<std::size_t>(info.st_size);
+        }
+
+        // The mapping keeps its own reference to the file
+        close(fd);
+        m_Open = true;
+        return true;
+    }
+
+    void MappedFile::Close()
+    {
+        if (m_Data)
+            munmap(const_cast<unsigned char *>(m_Data), m_Size);
+        m_Data = nullptr;
+        m_Size = 0;
+        m_Open = false;
+    }
+#endif
+
+}
@@ -0,0 +1,125 @@
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+namespace Voltray::Utils
+{
+
+    ThreadPool::ThreadPool(unsigned int threadCount)
+    {
+        threadCount = std::max(threadCount, 1u);
+        m_Workers.reserve(threadCount);
+        for (unsigned int i = 0; i < threadCount; ++i)
+        {
+            m_Workers.emplace_back(&ThreadPool::WorkerLoop, this);
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Stopping = true;
+        }
+        m_TaskAvailable.notify_all();
+        for (std::thread &worker : m_Workers)
+        {
+            worker.join();
+        }
+    }
+
+    ThreadPool &ThreadPool::GetInstance()
+    {
+        // hardware_concurrency may report 0 when unknown
+        static ThreadPool instance(std::thread::hardware_concurrency());
+        return instance;
+    }
+
+    void ThreadPool::ParallelFor(std::size_t count, const std::function<void(std::size_t)> &body)
+    {
+        if (count == 0)
+            return;
+
+        // Shared with the helper tasks, which may only start after this call returned
+        struct State
+        {
+            const std::function<void(std::size_t)> *body;
+            std::size_t count;
+            std::atomic<std::size_t> next{0};
+            std::size_t finished = 0;
+            std::exception_ptr error;
+            std::mutex mutex;
+            std::condition_variable allFinished;
+        };
+        auto state = std::make_shared<State>();
+        state->body = &body;
+        state->count = count;
+
+        // Items are claimed one at a time, so late helpers find nothing left and never touch body
+        auto work = [](State &shared)
+        {
+            std::size_t index;
+            while ((index = shared.next.fetch_add(1)) < shared.count)
+            {
+                std::exception_ptr error;
+                try
+                {
+                    (*shared.body)(index);
+                }
+                catch (...)
+                {
+                    error = std::current_exception();
+                }
+
+                std::lock_guard<std::mutex> lock(shared.mutex);
+                if (error && !shared.error)
+                    shared.error = error;
+                if (++shared.finished == shared.count)
+                    shared.allFinished.notify_all();
+            }
+        };
+
+        const std::size_t helperCount = std::min(count - 1, m_Workers.size());
+        if (helperCount > 0)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                for (std::size_t i = 0; i < helperCount; ++i)
+                {
+                    m_Tasks.emplace_back([state, work]()
+                                         { work(*state); });
+                }
+            }
+            m_TaskAvailable.notify_all();
+        }
+
+        work(*state);
+
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->allFinished.wait(lock, [&state]()
+                                { return state->finished == state->count; });
+        if (state->error)
+            std::rethrow_exception(state->error);
+    }
+
+    void ThreadPool::WorkerLoop()
+    {
+        while (true)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(m_Mutex);
+                m_TaskAvailable.wait(lock, [this]()
+                                     { return m_Stopping || !m_Tasks.empty(); });
+                if (m_Tasks.empty())
+                    return;
+
+                task = std::move(m_Tasks.front());
+                m_Tasks.pop_front();
+            }
+            task();
+        }
+    }
+
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+
+namespace Voltray::Utils
+{
+
+    /**
+     * @class MappedFile
+     * @brief Read-only memory mapping of a whole file
+     *
+     * The contents are paged in by the OS on first access instead of being copied into a
+     * buffer, so loaders can read records and strings in place. The mapping stays valid until
+     * Close is called or the object is destroyed.
+     */
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+        MappedFile(MappedFile &&other) noexcept;
+        MappedFile &operator=(MappedFile &&other) noexcept;
+
+        /**
+         * @brief Maps a file, closing any file mapped before
+         * @param path Path to the file
+         * @return True if the file was mapped; empty files map successfully with no data
+         */
+        bool Open(const std::filesystem::path &path);
+
+        /**
+         * @brief Unmaps the file
+         */
+        void Close();
+
+        bool IsOpen() const { return m_Open; }
+        const unsigned char *GetData() const { return m_Data; }
+        std::size_t GetSize() const { return m_Size; }
+
+    private:
+        const unsigned char *m_Data = nullptr;
+        std::size_t m_Size = 0;
+        bool m_Open = false;
+#ifdef _WIN32
+        void *m_FileHandle = nullptr;
+        void *m_MappingHandle = nullptr;
+#endif
+    };
+
+}
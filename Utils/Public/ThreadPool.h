@@ -0,0 +1,97 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace Voltray::Utils
+{
+
+    /**
+     * @class ThreadPool
+     * @brief Fixed set of worker threads running submitted tasks in FIFO order
+     *
+     * Used for CPU-only work such as parsing files. Tasks must not touch OpenGL or other
+     * main-thread state; hand their results back through the returned future instead.
+     */
+    class ThreadPool
+    {
+    public:
+        /**
+         * @brief Starts the worker threads
+         * @param threadCount Number of workers, at least one is created
+         */
+        explicit ThreadPool(unsigned int threadCount);
+
+        /**
+         * @brief Runs all queued tasks, then joins the workers
+         */
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        /**
+         * @brief Get the pool shared by the engine, with one worker per hardware thread
+         * @return Reference to the shared pool
+         */
+        static ThreadPool &GetInstance();
+
+        /**
+         * @brief Queues a task
+         * @param task Callable taking no arguments
+         * @return Future receiving the task's result, or the exception it threw
+         */
+        template <typename Task>
+        std::future<std::invoke_result_t<std::decay_t<Task>>> Submit(Task &&task)
+        {
+            using Result = std::invoke_result_t<std::decay_t<Task>>;
+
+            // std::function needs a copyable target, packaged_task is move-only
+            auto packagedTask = std::make_shared<std::packaged_task<Result()>>(std::forward<Task>(task));
+            std::future<Result> result = packagedTask->get_future();
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                m_Tasks.emplace_back([packagedTask]()
+                                     { (*packagedTask)(); });
+            }
+            m_TaskAvailable.notify_one();
+            return result;
+        }
+
+        /**
+         * @brief Runs body(i) for every i in [0, count), spread over the workers and the calling thread
+         *
+         * The calling thread works through the range as well and only waits for items that
+         * other threads already started, so it is safe to call from inside a pool task.
+         *
+         * @param count Number of items
+         * @param body Callable invoked once per item index
+         * @throws The first exception thrown by body, after all started items finished
+         */
+        void ParallelFor(std::size_t count, const std::function<void(std::size_t)> &body);
+
+        /**
+         * @brief Get the number of worker threads
+         * @return Worker count
+         */
+        unsigned int GetThreadCount() const { return static_cast<unsigned int>(m_Workers.size()); }
+
+    private:
+        void WorkerLoop();
+
+        std::vector<std::thread> m_Workers;
+        std::deque<std::function<void()>> m_Tasks;
+        std::mutex m_Mutex;
+        std::condition_variable m_TaskAvailable;
+        bool m_Stopping = false;
+    };
+
+}